@@ -3,6 +3,23 @@ SoftwareSerial BT(0, 1); // Arduino RX, TX
 
 char inChar;
 
+// Binary frames, see SerialFrame.h in UE4Duino:
+// [0xA5 sync][command id][sequence][payload length][payload ...][crc16 lo][crc16 hi]
+// Bytes outside of a frame are still handled as the old single char commands.
+#define FRAME_SYNC 0xA5
+#define FRAME_MAX_PAYLOAD 32
+#define CMD_DRIVE 0x01
+#define CMD_LIGHT 0x02
+#define CMD_STOP 0x03
+#define CMD_ACK 0x80
+#define ACK_OK 0x00
+#define ACK_UNKNOWN_COMMAND 0x01
+#define ACK_BAD_PAYLOAD 0x02
+
+bool inFrame = false;
+byte frameBody[3 + FRAME_MAX_PAYLOAD + 2]; // command id, sequence, length, payload, crc
+byte frameReceived = 0;
+
 void setup() {
   // put your setup code here, to run once:
   pinMode(7,OUTPUT);//IN2
@@ -27,7 +44,9 @@ void loop() {
   // put your main code here, to run repeatedly:
   while (Serial.available()&& BT.available()){
     inChar=BT.read();
-    doStuff();
+    if (!parseFrameByte((byte)inChar)){
+      doStuff();
+    }
   }
 }
 
@@ -83,3 +102,110 @@ void doStuff(){
     Serial.println('L');
   }
 }
+
+unsigned int crc16(const byte* data, byte length){
+  // CRC-16/CCITT-FALSE, the same as FSerialFrameCodec::Crc16
+  unsigned int crc = 0xFFFF;
+  for (byte i = 0; i < length; i++){
+    crc ^= (unsigned int)data[i] << 8;
+    for (byte bit = 0; bit < 8; bit++){
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+// Returns true if the byte belongs to a frame and must not be handled as a char command.
+bool parseFrameByte(byte b){
+  if (!inFrame){
+    if (b != FRAME_SYNC){
+      return false;
+    }
+    inFrame = true;
+    frameReceived = 0;
+    return true;
+  }
+
+  frameBody[frameReceived++] = b;
+  if (frameReceived < 3){
+    return true;
+  }
+
+  byte payloadLength = frameBody[2];
+  if (payloadLength > FRAME_MAX_PAYLOAD){
+    inFrame = false;
+    return true;
+  }
+  if (frameReceived < 3 + payloadLength + 2){
+    return true;
+  }
+
+  inFrame = false;
+  unsigned int receivedCrc = frameBody[3 + payloadLength] | ((unsigned int)frameBody[4 + payloadLength] << 8);
+  if (receivedCrc != crc16(frameBody, 3 + payloadLength)){
+    // Broken frame, no ack. The sender will resend.
+    return true;
+  }
+
+  handleFrame(frameBody[0], frameBody[1], frameBody + 3, payloadLength);
+  return true;
+}
+
+void handleFrame(byte command, byte sequence, const byte* payload, byte payloadLength){
+  byte status = ACK_OK;
+  if (command == CMD_DRIVE){
+    if (payloadLength == 4){
+      int left = (int16_t)(payload[0] | ((unsigned int)payload[1] << 8));
+      int right = (int16_t)(payload[2] | ((unsigned int)payload[3] << 8));
+      drive(left, right);
+    }
+    else {
+      status = ACK_BAD_PAYLOAD;
+    }
+  }
+  else if (command == CMD_LIGHT){
+    if (payloadLength == 1){
+      digitalWrite(2, payload[0] ? HIGH : LOW);
+    }
+    else {
+      status = ACK_BAD_PAYLOAD;
+    }
+  }
+  else if (command == CMD_STOP){
+    drive(0, 0);
+    digitalWrite(2,LOW);
+  }
+  else {
+    status = ACK_UNKNOWN_COMMAND;
+  }
+  sendAck(command, sequence, status);
+}
+
+// Duty from -255 (full reverse) to 255 (full forward) for each side.
+// The left motor is on ENB (11) with IN3/IN4 (8/12), the right one on ENA (9) with IN1/IN2 (4/7).
+void drive(int left, int right){
+  left = constrain(left, -255, 255);
+  right = constrain(right, -255, 255);
+
+  digitalWrite(8, left > 0 ? HIGH : LOW);
+  digitalWrite(12, left < 0 ? HIGH : LOW);
+  analogWrite(11, abs(left));
+
+  digitalWrite(4, right < 0 ? HIGH : LOW);
+  digitalWrite(7, right > 0 ? HIGH : LOW);
+  analogWrite(9, abs(right));
+}
+
+void sendAck(byte command, byte sequence, byte status){
+  byte frame[4 + 2 + 2];
+  frame[0] = FRAME_SYNC;
+  frame[1] = CMD_ACK;
+  frame[2] = sequence;
+  frame[3] = 2;
+  frame[4] = command;
+  frame[5] = status;
+  unsigned int crc = crc16(frame + 1, 5);
+  frame[6] = crc & 0xFF;
+  frame[7] = crc >> 8;
+  Serial.write(frame, sizeof(frame));
+}
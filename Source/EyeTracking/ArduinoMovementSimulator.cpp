@@ -0,0 +1,589 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ArduinoMovementSimulator.h"
+
+#include "Serial.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+//Start, stop and 8 data bits.
+#define ARDUINO_SIM_BITS_PER_BYTE 10.0
+
+//Pins of ArduinoMovement.ino.
+#define ARDUINO_PIN_LED 2
+#define ARDUINO_PIN_IN1 4
+#define ARDUINO_PIN_IN2 7
+#define ARDUINO_PIN_IN3 8
+#define ARDUINO_PIN_ENA 9
+#define ARDUINO_PIN_ENB 11
+#define ARDUINO_PIN_IN4 12
+
+static int32 SignedDuty(bool bForward, bool bReverse, uint8 Pwm)
+{
+	if (bForward && !bReverse) return Pwm;
+	if (bReverse && !bForward) return -(int32)Pwm;
+	return 0;
+}
+
+static bool IsSamePinState(const FArduinoMotorState& A, const FArduinoMotorState& B)
+{
+	return A.bLightOn == B.bLightOn
+		&& A.bIn1 == B.bIn1 && A.bIn2 == B.bIn2 && A.bIn3 == B.bIn3 && A.bIn4 == B.bIn4
+		&& A.EnA == B.EnA && A.EnB == B.EnB;
+}
+
+FArduinoMovementSimulation::FArduinoMovementSimulation(const FArduinoSimulatorSettings& InSettings)
+	: Settings(InSettings)
+	, Random(InSettings.Seed)
+	, ByteTime(ARDUINO_SIM_BITS_PER_BYTE / FMath::Max(InSettings.BaudRate, 1))
+	, StartSeconds(FPlatformTime::Seconds())
+	, ManualTime(0.0)
+	, bConnected(true)
+	, HostTxBusyUntil(0.0)
+	, LastBoardArrival(0.0)
+	, LoopFreeAt(0.0)
+	, BoardTxBusyUntil(0.0)
+	, LastHostArrival(0.0)
+	, ReplyDelay(0.0)
+	, CurrentSentTime(0.0)
+	, bInFrame(false)
+	, FrameReceived(0)
+	, TotalCommandLatency(0.0)
+{
+	Settings.RxBufferSize = FMath::Max(Settings.RxBufferSize, 1);
+	Settings.TxBufferSize = FMath::Max(Settings.TxBufferSize, 1);
+	Settings.HostRxBufferSize = FMath::Max(Settings.HostRxBufferSize, 1);
+	Settings.MaxTimelineEntries = FMath::Max(Settings.MaxTimelineEntries, 2);
+
+	//setup(): every pin low, both motors off.
+	FMemory::Memzero(DigitalPins);
+	FMemory::Memzero(PwmPins);
+	FMemory::Memzero(FrameBody);
+	Timeline.Add(MakeMotorState());
+}
+
+double FArduinoMovementSimulation::GetNow() const
+{
+	return Settings.bRealTime ? FPlatformTime::Seconds() - StartSeconds : ManualTime;
+}
+
+double FArduinoMovementSimulation::NextLinkDelay()
+{
+	return Settings.LinkLatency + Random.FRand() * Settings.LinkJitter;
+}
+
+int32 FArduinoMovementSimulation::Write(const uint8* Data, int32 NumBytes)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!bConnected) return -1;
+
+	const double Now = GetNow();
+	Simulate(Now);
+
+	//A write goes out as one Bluetooth packet, so all of its bytes share the same link delay.
+	const double Delay = NextLinkDelay();
+	double TxEnd = FMath::Max(Now, HostTxBusyUntil);
+	for (int32 i = 0; i < NumBytes; i++)
+	{
+		TxEnd += ByteTime;
+		LastBoardArrival = FMath::Max(TxEnd + Delay, LastBoardArrival);
+
+		FTimedByte& Byte = ToBoard.AddDefaulted_GetRef();
+		Byte.Time = LastBoardArrival;
+		Byte.SentTime = Now;
+		Byte.Value = Data[i];
+	}
+	HostTxBusyUntil = TxEnd;
+
+	return NumBytes;
+}
+
+int32 FArduinoMovementSimulation::Read(uint8* Data, int32 MaxBytes)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!bConnected) return 0;
+
+	const double Now = GetNow();
+	Simulate(Now);
+
+	int32 NumRead = 0;
+	while (NumRead < MaxBytes && NumRead < ToHost.Num() && ToHost[NumRead].Time <= Now)
+	{
+		Data[NumRead] = ToHost[NumRead].Value;
+		NumRead++;
+	}
+	ToHost.RemoveAt(0, NumRead, false);
+	return NumRead;
+}
+
+int32 FArduinoMovementSimulation::GetWriteQueueSize()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	//Bytes that haven't been clocked out at the baud rate yet, like the driver's transmit buffer.
+	return FMath::Max(FMath::CeilToInt((HostTxBusyUntil - GetNow()) / ByteTime), 0);
+}
+
+bool FArduinoMovementSimulation::IsConnected()
+{
+	FScopeLock ScopeLock(&Lock);
+	return bConnected;
+}
+
+void FArduinoMovementSimulation::AdvanceTime(double Seconds)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (Settings.bRealTime || Seconds <= 0.0) return;
+
+	ManualTime += Seconds;
+	Simulate(ManualTime);
+}
+
+double FArduinoMovementSimulation::GetTime()
+{
+	FScopeLock ScopeLock(&Lock);
+	return GetNow();
+}
+
+void FArduinoMovementSimulation::SetConnected(bool bInConnected)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (bConnected == bInConnected) return;
+
+	const double Now = GetNow();
+	Simulate(Now);
+	bConnected = bInConnected;
+
+	if (!bConnected)
+	{
+		//The board keeps running and keeps what it already received, the link loses what it carried.
+		ToBoard.Reset();
+		ToHost.Reset();
+		HostTxBusyUntil = Now;
+		LastBoardArrival = Now;
+		LastHostArrival = Now;
+	}
+}
+
+FArduinoMotorState FArduinoMovementSimulation::GetMotorState()
+{
+	FScopeLock ScopeLock(&Lock);
+	Simulate(GetNow());
+	return Timeline.Num() > 0 ? Timeline.Last() : MakeMotorState();
+}
+
+TArray<FArduinoMotorState> FArduinoMovementSimulation::GetTimeline()
+{
+	FScopeLock ScopeLock(&Lock);
+	Simulate(GetNow());
+	return Timeline;
+}
+
+FArduinoSimulatorStats FArduinoMovementSimulation::GetStats()
+{
+	FScopeLock ScopeLock(&Lock);
+	Simulate(GetNow());
+
+	FArduinoSimulatorStats Result = Stats;
+	Result.AverageCommandLatency = Stats.NumCommandsHandled > 0 ? (float)(TotalCommandLatency / Stats.NumCommandsHandled) : 0.0f;
+	return Result;
+}
+
+void FArduinoMovementSimulation::ClearTimeline()
+{
+	FScopeLock ScopeLock(&Lock);
+	Simulate(GetNow());
+
+	//Keep the current state, so the timeline always says what the pins are at its start.
+	const FArduinoMotorState Current = MakeMotorState();
+	Timeline.Reset();
+	Timeline.Add(Current);
+	Timeline[0].Time = (float)GetNow();
+}
+
+void FArduinoMovementSimulation::Simulate(double Now)
+{
+	//Bytes that reached the board go into its receive buffer, unless the sketch is stuck writing and the buffer is full.
+	int32 NumArrived = 0;
+	for (; NumArrived < ToBoard.Num() && ToBoard[NumArrived].Time <= Now; NumArrived++)
+	{
+		const FTimedByte& Byte = ToBoard[NumArrived];
+		RunLoop(Byte.Time);
+
+		if (BoardRx.Num() >= Settings.RxBufferSize)
+		{
+			Stats.NumBytesDropped++;
+			continue;
+		}
+
+		BoardRx.Add(Byte);
+		Stats.NumBytesReceived++;
+	}
+	ToBoard.RemoveAt(0, NumArrived, false);
+
+	RunLoop(Now);
+}
+
+void FArduinoMovementSimulation::RunLoop(double Until)
+{
+	while (BoardRx.Num() > 0)
+	{
+		double Time = FMath::Max(LoopFreeAt, BoardRx[0].Time);
+		if (Time > Until) break;
+
+		const FTimedByte Byte = BoardRx[0];
+		BoardRx.RemoveAt(0, 1, false);
+		HandleByte(Byte, Time);
+		LoopFreeAt = Time;
+	}
+}
+
+void FArduinoMovementSimulation::HandleByte(const FTimedByte& Byte, double& Time)
+{
+	CurrentSentTime = Byte.SentTime;
+	if (!ParseFrameByte(Byte.Value, Time))
+	{
+		DoStuff(Byte.Value, Time);
+	}
+}
+
+bool FArduinoMovementSimulation::DoStuff(uint8 InChar, double& Time)
+{
+	//Same order of pin writes as doStuff() in the sketch, only the state after a whole command is observable anyway.
+	switch (InChar)
+	{
+	case 'o':
+		DigitalPins[ARDUINO_PIN_LED] = true;
+		break;
+	case 'c':
+		DigitalPins[ARDUINO_PIN_IN2] = false;
+		DigitalPins[ARDUINO_PIN_IN3] = false;
+		DigitalPins[ARDUINO_PIN_IN4] = false;
+		DigitalPins[ARDUINO_PIN_IN1] = false;
+		DigitalPins[ARDUINO_PIN_LED] = false;
+		break;
+	case 'f':
+		PwmPins[ARDUINO_PIN_ENB] = 160;
+		PwmPins[ARDUINO_PIN_ENA] = 160;
+		DigitalPins[ARDUINO_PIN_IN1] = false;
+		DigitalPins[ARDUINO_PIN_IN2] = true;
+		DigitalPins[ARDUINO_PIN_IN3] = true;
+		DigitalPins[ARDUINO_PIN_IN4] = false;
+		break;
+	case 'l':
+		PwmPins[ARDUINO_PIN_ENB] = 0;
+		PwmPins[ARDUINO_PIN_ENA] = 100;
+		DigitalPins[ARDUINO_PIN_IN1] = false;
+		DigitalPins[ARDUINO_PIN_IN2] = true;
+		break;
+	case 'r':
+		PwmPins[ARDUINO_PIN_ENB] = 100;
+		PwmPins[ARDUINO_PIN_ENA] = 0;
+		DigitalPins[ARDUINO_PIN_IN3] = true;
+		DigitalPins[ARDUINO_PIN_IN4] = false;
+		break;
+	case 'n':
+		DigitalPins[ARDUINO_PIN_IN1] = false;
+		DigitalPins[ARDUINO_PIN_IN2] = false;
+		DigitalPins[ARDUINO_PIN_IN3] = false;
+		DigitalPins[ARDUINO_PIN_IN4] = false;
+		break;
+	case 'R':
+		PwmPins[ARDUINO_PIN_ENB] = 160;
+		PwmPins[ARDUINO_PIN_ENA] = 100;
+		break;
+	case 'L':
+		PwmPins[ARDUINO_PIN_ENB] = 100;
+		PwmPins[ARDUINO_PIN_ENA] = 160;
+		break;
+	default:
+		return false;
+	}
+
+	const FString Command = FString::Chr((TCHAR)InChar);
+	OnCommandHandled(Command, CurrentSentTime, Time);
+
+	//o and c don't echo.
+	if (InChar != 'o' && InChar != 'c')
+	{
+		Println((TCHAR)InChar, Time);
+	}
+	return true;
+}
+
+bool FArduinoMovementSimulation::ParseFrameByte(uint8 Byte, double& Time)
+{
+	if (!bInFrame)
+	{
+		if (Byte != SERIAL_FRAME_SYNC) return false;
+
+		bInFrame = true;
+		FrameReceived = 0;
+		return true;
+	}
+
+	FrameBody[FrameReceived++] = Byte;
+	if (FrameReceived < 3) return true;
+
+	const uint8 PayloadLength = FrameBody[2];
+	if (PayloadLength > SERIAL_FRAME_MAX_PAYLOAD)
+	{
+		bInFrame = false;
+		Stats.NumFramesRejected++;
+		return true;
+	}
+	if (FrameReceived < 3 + PayloadLength + 2) return true;
+
+	bInFrame = false;
+	const uint16 ReceivedCrc = FrameBody[3 + PayloadLength] | ((uint16)FrameBody[4 + PayloadLength] << 8);
+	if (ReceivedCrc != FSerialFrameCodec::Crc16(FrameBody, 3 + PayloadLength))
+	{
+		//Broken frame, no ack.
+		Stats.NumFramesRejected++;
+		return true;
+	}
+
+	HandleFrame(FrameBody[0], FrameBody[1], FrameBody + 3, PayloadLength, Time);
+	return true;
+}
+
+void FArduinoMovementSimulation::HandleFrame(uint8 Command, uint8 Sequence, const uint8* Payload, uint8 PayloadLength, double& Time)
+{
+	ESerialFrameAckStatus Status = ESerialFrameAckStatus::Ok;
+	const TCHAR* CommandName = TEXT("Unknown");
+	switch ((ESerialFrameCommand)Command)
+	{
+	case ESerialFrameCommand::Drive:
+		CommandName = TEXT("Drive");
+		if (PayloadLength == 4)
+		{
+			const int16 Left = (int16)(Payload[0] | ((uint16)Payload[1] << 8));
+			const int16 Right = (int16)(Payload[2] | ((uint16)Payload[3] << 8));
+			Drive(Left, Right);
+		}
+		else
+		{
+			Status = ESerialFrameAckStatus::BadPayload;
+		}
+		break;
+	case ESerialFrameCommand::Light:
+		CommandName = TEXT("Light");
+		if (PayloadLength == 1)
+		{
+			DigitalPins[ARDUINO_PIN_LED] = Payload[0] != 0;
+		}
+		else
+		{
+			Status = ESerialFrameAckStatus::BadPayload;
+		}
+		break;
+	case ESerialFrameCommand::Stop:
+		CommandName = TEXT("Stop");
+		Drive(0, 0);
+		DigitalPins[ARDUINO_PIN_LED] = false;
+		break;
+	default:
+		Status = ESerialFrameAckStatus::UnknownCommand;
+		break;
+	}
+
+	OnCommandHandled(CommandName, CurrentSentTime, Time);
+	SendAck(Command, Sequence, (uint8)Status, Time);
+}
+
+void FArduinoMovementSimulation::Drive(int32 Left, int32 Right)
+{
+	Left = FMath::Clamp(Left, -255, 255);
+	Right = FMath::Clamp(Right, -255, 255);
+
+	DigitalPins[ARDUINO_PIN_IN3] = Left > 0;
+	DigitalPins[ARDUINO_PIN_IN4] = Left < 0;
+	PwmPins[ARDUINO_PIN_ENB] = (uint8)FMath::Abs(Left);
+
+	DigitalPins[ARDUINO_PIN_IN1] = Right < 0;
+	DigitalPins[ARDUINO_PIN_IN2] = Right > 0;
+	PwmPins[ARDUINO_PIN_ENA] = (uint8)FMath::Abs(Right);
+}
+
+void FArduinoMovementSimulation::SendAck(uint8 Command, uint8 Sequence, uint8 Status, double& Time)
+{
+	uint8 Frame[SERIAL_FRAME_HEADER_SIZE + 2 + SERIAL_FRAME_CRC_SIZE];
+	Frame[0] = SERIAL_FRAME_SYNC;
+	Frame[1] = (uint8)ESerialFrameCommand::Ack;
+	Frame[2] = Sequence;
+	Frame[3] = 2;
+	Frame[4] = Command;
+	Frame[5] = Status;
+	const uint16 Crc = FSerialFrameCodec::Crc16(Frame + 1, 5);
+	Frame[6] = Crc & 0xFF;
+	Frame[7] = Crc >> 8;
+
+	ReplyDelay = NextLinkDelay();
+	for (uint8 Value : Frame)
+	{
+		EmitByte(Value, Time);
+	}
+}
+
+void FArduinoMovementSimulation::Println(TCHAR Char, double& Time)
+{
+	ReplyDelay = NextLinkDelay();
+	EmitByte((uint8)Char, Time);
+	EmitByte('\r', Time);
+	EmitByte('\n', Time);
+}
+
+void FArduinoMovementSimulation::EmitByte(uint8 Value, double& Time)
+{
+	//Serial.write blocks the sketch until the transmit buffer has room, which is what makes a chatty sketch drop input.
+	const int32 NumTx = BoardTxEnds.Num();
+	if (NumTx >= Settings.TxBufferSize)
+	{
+		Time = FMath::Max(Time, BoardTxEnds[NumTx - Settings.TxBufferSize]);
+	}
+
+	const double TxEnd = FMath::Max(Time, BoardTxBusyUntil) + ByteTime;
+	BoardTxBusyUntil = TxEnd;
+	BoardTxEnds.Add(TxEnd);
+	if (BoardTxEnds.Num() > Settings.TxBufferSize * 2)
+	{
+		BoardTxEnds.RemoveAt(0, BoardTxEnds.Num() - Settings.TxBufferSize, false);
+	}
+
+	Stats.NumBytesSent++;
+	if (!bConnected) return;
+
+	//A host that never reads mustn't make this grow without end.
+	if (ToHost.Num() >= Settings.HostRxBufferSize)
+	{
+		Stats.NumBytesDroppedToHost++;
+		return;
+	}
+
+	LastHostArrival = FMath::Max(TxEnd + ReplyDelay, LastHostArrival);
+	FTimedByte& Byte = ToHost.AddDefaulted_GetRef();
+	Byte.Time = LastHostArrival;
+	Byte.SentTime = TxEnd;
+	Byte.Value = Value;
+}
+
+void FArduinoMovementSimulation::OnCommandHandled(const FString& Command, double SentTime, double Time)
+{
+	const double Latency = Time - SentTime;
+	Stats.NumCommandsHandled++;
+	Stats.MaxCommandLatency = FMath::Max(Stats.MaxCommandLatency, (float)Latency);
+	TotalCommandLatency += Latency;
+
+	FArduinoMotorState State = MakeMotorState();
+	if (Timeline.Num() > 0 && IsSamePinState(State, Timeline.Last())) return;
+
+	State.Time = (float)Time;
+	State.CommandSentTime = (float)SentTime;
+	State.Command = Command;
+
+	if (Timeline.Num() >= Settings.MaxTimelineEntries)
+	{
+		Timeline.RemoveAt(0, Timeline.Num() / 2, false);
+	}
+	Timeline.Add(MoveTemp(State));
+}
+
+FArduinoMotorState FArduinoMovementSimulation::MakeMotorState() const
+{
+	FArduinoMotorState State;
+	State.bLightOn = DigitalPins[ARDUINO_PIN_LED];
+	State.bIn1 = DigitalPins[ARDUINO_PIN_IN1];
+	State.bIn2 = DigitalPins[ARDUINO_PIN_IN2];
+	State.bIn3 = DigitalPins[ARDUINO_PIN_IN3];
+	State.bIn4 = DigitalPins[ARDUINO_PIN_IN4];
+	State.EnA = PwmPins[ARDUINO_PIN_ENA];
+	State.EnB = PwmPins[ARDUINO_PIN_ENB];
+
+	//The left motor is on ENB with IN3/IN4, the right one on ENA with IN1/IN2. Forward is IN3 and IN2.
+	State.LeftDuty = SignedDuty(State.bIn3, State.bIn4, PwmPins[ARDUINO_PIN_ENB]);
+	State.RightDuty = SignedDuty(State.bIn2, State.bIn1, PwmPins[ARDUINO_PIN_ENA]);
+	return State;
+}
+
+UArduinoMovementSimulator::UArduinoMovementSimulator()
+	: BaudRate(9600)
+{
+}
+
+UArduinoMovementSimulator* UArduinoMovementSimulator::CreateArduinoSimulator(const FArduinoSimulatorSettings& Settings)
+{
+	UArduinoMovementSimulator* Simulator = NewObject<UArduinoMovementSimulator>();
+	Simulator->Simulation = MakeShared<FArduinoMovementSimulation, ESPMode::ThreadSafe>(Settings);
+	Simulator->BaudRate = Settings.BaudRate;
+	return Simulator;
+}
+
+USerial* UArduinoMovementSimulator::OpenSerial()
+{
+	if (!Simulation.IsValid()) return nullptr;
+
+	USerial* Serial = NewObject<USerial>();
+	if (!Serial->OpenVirtual(Simulation.ToSharedRef(), TEXT("ArduinoMovementSimulator"), BaudRate)) return nullptr;
+
+	return Serial;
+}
+
+void UArduinoMovementSimulator::AdvanceTime(float Seconds)
+{
+	if (Simulation.IsValid()) Simulation->AdvanceTime(Seconds);
+}
+
+float UArduinoMovementSimulator::GetTime() const
+{
+	return Simulation.IsValid() ? (float)Simulation->GetTime() : 0.0f;
+}
+
+void UArduinoMovementSimulator::SetConnected(bool bConnected)
+{
+	if (Simulation.IsValid()) Simulation->SetConnected(bConnected);
+}
+
+FArduinoMotorState UArduinoMovementSimulator::GetMotorState() const
+{
+	return Simulation.IsValid() ? Simulation->GetMotorState() : FArduinoMotorState();
+}
+
+TArray<FArduinoMotorState> UArduinoMovementSimulator::GetTimeline() const
+{
+	return Simulation.IsValid() ? Simulation->GetTimeline() : TArray<FArduinoMotorState>();
+}
+
+FArduinoSimulatorStats UArduinoMovementSimulator::GetStats() const
+{
+	return Simulation.IsValid() ? Simulation->GetStats() : FArduinoSimulatorStats();
+}
+
+void UArduinoMovementSimulator::ClearTimeline()
+{
+	if (Simulation.IsValid()) Simulation->ClearTimeline();
+}
+
+bool UArduinoMovementSimulator::ExportTimelineCsv(FString FilePath) const
+{
+	if (FilePath.IsEmpty())
+	{
+		FilePath = FPaths::ProjectLogDir() / FString::Printf(TEXT("ArduinoSimulator-%s.csv"), *FDateTime::Now().ToString());
+	}
+
+	FString Csv = TEXT("Time,CommandSentTime,LatencyMs,Command,LeftDuty,RightDuty,Light,IN1,IN2,IN3,IN4,ENA,ENB\n");
+	for (const FArduinoMotorState& State : GetTimeline())
+	{
+		Csv += FString::Printf(TEXT("%.6f,%.6f,%.3f,%s,%d,%d,%d,%d,%d,%d,%d,%d,%d\n")
+			, State.Time, State.CommandSentTime, (State.Time - State.CommandSentTime) * 1000.0f, *State.Command
+			, State.LeftDuty, State.RightDuty, State.bLightOn ? 1 : 0
+			, State.bIn1 ? 1 : 0, State.bIn2 ? 1 : 0, State.bIn3 ? 1 : 0, State.bIn4 ? 1 : 0, State.EnA, State.EnB);
+	}
+
+	const bool bExported = FFileHelper::SaveStringToFile(Csv, *FilePath);
+	UE_LOG(LogTemp, Log, TEXT("%s Arduino simulator timeline to %s"), bExported ? TEXT("Exported") : TEXT("Failed to export"), *FilePath);
+	return bExported;
+}
@@ -0,0 +1,339 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Math/RandomStream.h"
+#include "HAL/CriticalSection.h"
+#include "SerialFrame.h"
+#include "SerialVirtualDevice.h"
+#include "ArduinoMovementSimulator.generated.h"
+
+class USerial;
+
+/**
+ * How the simulated board and the link to it behave.
+ */
+USTRUCT(BlueprintType)
+struct FArduinoSimulatorSettings
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	FArduinoSimulatorSettings()
+		: BaudRate(9600)
+		, LinkLatency(0.02f)
+		, LinkJitter(0.01f)
+		, Seed(0)
+		, bRealTime(true)
+		, RxBufferSize(64)
+		, TxBufferSize(64)
+		, HostRxBufferSize(4096)
+		, MaxTimelineEntries(65536)
+	{}
+
+	//Both directions are limited to this rate, at 10 bits per byte.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator", meta = (ClampMin = 1))
+	int32 BaudRate;
+
+	//One way delay the Bluetooth link adds on top of the transfer time, in seconds.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator", meta = (ClampMin = 0.0f))
+	float LinkLatency;
+
+	//Up to this many seconds are randomly added to LinkLatency for every write. The order of the bytes is kept.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator", meta = (ClampMin = 0.0f))
+	float LinkJitter;
+
+	//The same seed and the same sequence of writes and Advance Time calls always give the same result.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	int32 Seed;
+
+	//If true the simulation follows the wall clock. Turn it off to only move time forward with Advance Time, which makes runs reproducible.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	bool bRealTime;
+
+	//Bytes the board buffers before it drops incoming data. 64 on an Uno.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator", meta = (ClampMin = 1))
+	int32 RxBufferSize;
+
+	//Bytes the board buffers before Serial.write blocks the sketch. 64 on an Uno.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator", meta = (ClampMin = 1))
+	int32 TxBufferSize;
+
+	//Bytes on their way to the host or waiting to be read, like the driver's receive buffer. Echoes and acks past this are dropped. Same as the default async queue of USerial.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator", meta = (ClampMin = 1))
+	int32 HostRxBufferSize;
+
+	//The oldest half of the timeline is dropped once it grows past this.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator", meta = (ClampMin = 2))
+	int32 MaxTimelineEntries;
+};
+
+/**
+ * The motor driver pins of ArduinoMovement.ino at one point in time.
+ */
+USTRUCT(BlueprintType)
+struct FArduinoMotorState
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	FArduinoMotorState()
+		: Time(0.0f)
+		, CommandSentTime(0.0f)
+		, LeftDuty(0)
+		, RightDuty(0)
+		, bLightOn(false)
+		, bIn1(false)
+		, bIn2(false)
+		, bIn3(false)
+		, bIn4(false)
+		, EnA(0)
+		, EnB(0)
+	{}
+
+	//Simulated seconds since the simulator was created.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	float Time;
+
+	//When the host wrote the command that led to this state. Time minus this is the command latency.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	float CommandSentTime;
+
+	//The command, like f for a char command or Drive for a frame.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	FString Command;
+
+	//-255 (full reverse) to 255 (full forward), from ENB (11) and IN3/IN4 (8/12).
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	int32 LeftDuty;
+
+	//-255 (full reverse) to 255 (full forward), from ENA (9) and IN1/IN2 (4/7).
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	int32 RightDuty;
+
+	//Pin 2.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	bool bLightOn;
+
+	//Pin 4.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	bool bIn1;
+	//Pin 7.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	bool bIn2;
+	//Pin 8.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	bool bIn3;
+	//Pin 12.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	bool bIn4;
+	//PWM on pin 9.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	int32 EnA;
+	//PWM on pin 11.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	int32 EnB;
+};
+
+/**
+ * What went through the simulated board so far.
+ */
+USTRUCT(BlueprintType)
+struct FArduinoSimulatorStats
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	FArduinoSimulatorStats()
+		: NumBytesReceived(0)
+		, NumBytesDropped(0)
+		, NumBytesSent(0)
+		, NumBytesDroppedToHost(0)
+		, NumCommandsHandled(0)
+		, NumFramesRejected(0)
+		, AverageCommandLatency(0.0f)
+		, MaxCommandLatency(0.0f)
+	{}
+
+	//Bytes that made it into the board's receive buffer.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	int32 NumBytesReceived;
+	//Bytes lost because the receive buffer was full while the sketch was blocked on writing.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	int32 NumBytesDropped;
+	//Echo and ack bytes the board sent back.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	int32 NumBytesSent;
+	//Echo and ack bytes lost because the host didn't read and its receive buffer was full.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	int32 NumBytesDroppedToHost;
+	//Char commands and valid frames the sketch acted on.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	int32 NumCommandsHandled;
+	//Frames thrown away because of a bad CRC or length.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	int32 NumFramesRejected;
+	//From the host writing a command to the sketch acting on it, in seconds.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	float AverageCommandLatency;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Arduino Simulator")
+	float MaxCommandLatency;
+};
+
+/**
+ * ArduinoMovement.ino and the serial link to it, in software.
+ * Bytes written by the host take 10 bits per byte at the baud rate plus the link latency to reach the board, and the echoes and acks
+ * take the same way back. The board runs the sketch's command set: the single char commands and the binary frames.
+ * Time only moves when the simulation is used, everything up to the current time is worked off in one go, so it costs nothing while idle.
+ * Thread safe, the I/O thread of an async USerial may write while the game thread reads the timeline.
+ */
+class EYETRACKING_API FArduinoMovementSimulation : public ISerialVirtualDevice
+{
+public:
+	explicit FArduinoMovementSimulation(const FArduinoSimulatorSettings& InSettings);
+
+	// ISerialVirtualDevice
+	virtual int32 Write(const uint8* Data, int32 NumBytes) override;
+	virtual int32 Read(uint8* Data, int32 MaxBytes) override;
+	virtual int32 GetWriteQueueSize() override;
+	virtual bool IsConnected() override;
+
+	/** Move simulated time forward. Only does something when the settings aren't real time. */
+	void AdvanceTime(double Seconds);
+	double GetTime();
+	/** Drop the link, like the car driving out of Bluetooth range. Everything in flight is lost. */
+	void SetConnected(bool bInConnected);
+
+	FArduinoMotorState GetMotorState();
+	TArray<FArduinoMotorState> GetTimeline();
+	FArduinoSimulatorStats GetStats();
+	void ClearTimeline();
+
+private:
+	struct FTimedByte
+	{
+		//When the byte arrives at the other end.
+		double Time;
+		//When the host wrote it, to measure command latency.
+		double SentTime;
+		uint8 Value;
+	};
+
+	enum { NumPins = 14, FrameBodySize = 3 + SERIAL_FRAME_MAX_PAYLOAD + 2 };
+
+	double GetNow() const;
+	double NextLinkDelay();
+	/** Work off everything that happens up to Now. */
+	void Simulate(double Now);
+	/** Let the sketch handle received bytes it can get to before Until. */
+	void RunLoop(double Until);
+
+	//The sketch. Time is when the loop is at, writes that block move it forward.
+	void HandleByte(const FTimedByte& Byte, double& Time);
+	bool DoStuff(uint8 InChar, double& Time);
+	bool ParseFrameByte(uint8 Byte, double& Time);
+	void HandleFrame(uint8 Command, uint8 Sequence, const uint8* Payload, uint8 PayloadLength, double& Time);
+	void Drive(int32 Left, int32 Right);
+	void SendAck(uint8 Command, uint8 Sequence, uint8 Status, double& Time);
+	void Println(TCHAR Char, double& Time);
+	void EmitByte(uint8 Value, double& Time);
+	void OnCommandHandled(const FString& Command, double SentTime, double Time);
+	FArduinoMotorState MakeMotorState() const;
+
+	FCriticalSection Lock;
+	FArduinoSimulatorSettings Settings;
+	FRandomStream Random;
+	double ByteTime;
+	double StartSeconds;
+	double ManualTime;
+	bool bConnected;
+
+	//Host to board.
+	TArray<FTimedByte> ToBoard;
+	double HostTxBusyUntil;
+	double LastBoardArrival;
+	TArray<FTimedByte> BoardRx;
+	double LoopFreeAt;
+
+	//Board to host.
+	TArray<FTimedByte> ToHost;
+	TArray<double> BoardTxEnds;
+	double BoardTxBusyUntil;
+	double LastHostArrival;
+	double ReplyDelay;
+	//When the host wrote the byte being handled.
+	double CurrentSentTime;
+
+	bool bInFrame;
+	uint8 FrameBody[FrameBodySize];
+	int32 FrameReceived;
+	bool DigitalPins[NumPins];
+	uint8 PwmPins[NumPins];
+
+	TArray<FArduinoMotorState> Timeline;
+	FArduinoSimulatorStats Stats;
+	double TotalCommandLatency;
+};
+
+/**
+ * Stands in for the robot, so the control loop can be run and load tested without hardware.
+ * Open Serial gives a USerial that talks to the simulated board the same way it would talk to the real one.
+ */
+UCLASS(BlueprintType)
+class EYETRACKING_API UArduinoMovementSimulator : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UArduinoMovementSimulator();
+
+	UFUNCTION(BlueprintCallable, Category = "Arduino Simulator")
+	static UArduinoMovementSimulator* CreateArduinoSimulator(const FArduinoSimulatorSettings& Settings);
+
+	/**
+	 * Open a serial port to the simulated board. The board keeps its state when a port is closed and another one opened.
+	 * @return The opened port, or null if this simulator wasn't created with Create Arduino Simulator.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Arduino Simulator")
+	USerial* OpenSerial();
+
+	/** Move simulated time forward, when the simulator isn't running in real time. */
+	UFUNCTION(BlueprintCallable, Category = "Arduino Simulator")
+	void AdvanceTime(float Seconds);
+
+	UFUNCTION(BlueprintPure, Category = "Arduino Simulator")
+	float GetTime() const;
+
+	/** Drop or restore the link. Ports to the board report a device error while it is down. */
+	UFUNCTION(BlueprintCallable, Category = "Arduino Simulator")
+	void SetConnected(bool bConnected);
+
+	UFUNCTION(BlueprintPure, Category = "Arduino Simulator")
+	FArduinoMotorState GetMotorState() const;
+
+	/** Every change of the motor pins so far, oldest first. */
+	UFUNCTION(BlueprintPure, Category = "Arduino Simulator")
+	TArray<FArduinoMotorState> GetTimeline() const;
+
+	UFUNCTION(BlueprintPure, Category = "Arduino Simulator")
+	FArduinoSimulatorStats GetStats() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Arduino Simulator")
+	void ClearTimeline();
+
+	/**
+	 * Write the timeline to a CSV file.
+	 * @param FilePath Where to write. If empty, a timestamped file in the project's Saved/Logs directory is used.
+	 * @return True if the file was written.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Arduino Simulator")
+	bool ExportTimelineCsv(FString FilePath) const;
+
+	TSharedPtr<FArduinoMovementSimulation, ESPMode::ThreadSafe> GetSimulation() const { return Simulation; }
+
+protected:
+	TSharedPtr<FArduinoMovementSimulation, ESPMode::ThreadSafe> Simulation;
+	int32 BaudRate;
+};
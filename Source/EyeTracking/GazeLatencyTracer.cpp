@@ -0,0 +1,204 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GazeLatencyTracer.h"
+
+#include "Misc/FileHelper.h"
+
+static FGazeLatencyPercentiles CalculatePercentiles(TArray<float>& DurationsMs)
+{
+	FGazeLatencyPercentiles Result;
+	if (DurationsMs.Num() == 0) return Result;
+
+	DurationsMs.Sort();
+	const int32 LastIdx = DurationsMs.Num() - 1;
+	Result.P50Ms = DurationsMs[FMath::RoundToInt(LastIdx * 0.50f)];
+	Result.P90Ms = DurationsMs[FMath::RoundToInt(LastIdx * 0.90f)];
+	Result.P99Ms = DurationsMs[FMath::RoundToInt(LastIdx * 0.99f)];
+	Result.MaxMs = DurationsMs[LastIdx];
+	return Result;
+}
+
+static float HopMs(double From, double To)
+{
+	return (From > 0.0 && To > 0.0) ? (float)((To - From) * 1000.0) : -1.0f;
+}
+
+FGazeLatencyTracer::FGazeLatencyTracer()
+	: bHasPendingTrace(false)
+	, CompletedHead(0)
+	, NumCompleted(0)
+	, NumLost(0)
+	, NumUnsent(0)
+{
+}
+
+void FGazeLatencyTracer::BeginTrace(FName Zone, const FString& EchoText, double SampleTime, double ReadTime, double DecisionTime)
+{
+	if (bHasPendingTrace)
+	{
+		NumUnsent++;
+	}
+
+	PendingTrace = FGazeLatencyTrace();
+	PendingTrace.Zone = Zone;
+	PendingTrace.EchoText = EchoText;
+	PendingTrace.SampleTime = SampleTime;
+	PendingTrace.ReadTime = ReadTime;
+	PendingTrace.DecisionTime = DecisionTime;
+	bHasPendingTrace = true;
+}
+
+void FGazeLatencyTracer::OnSent(int32 Sequence, uint64 StreamEndOffset, double SendTime)
+{
+	if (!bHasPendingTrace) return;
+
+	PendingTrace.Sequence = Sequence;
+	PendingTrace.StreamEndOffset = StreamEndOffset;
+	PendingTrace.SendTime = SendTime;
+	InFlight.Add(MoveTemp(PendingTrace));
+	bHasPendingTrace = false;
+}
+
+void FGazeLatencyTracer::OnBytesWritten(uint64 TotalBytesWritten, double LastWriteTime)
+{
+	//Commands are written in order, so stop at the first one that isn't fully out yet.
+	for (FGazeLatencyTrace& Trace : InFlight)
+	{
+		if (Trace.WriteTime > 0.0) continue;
+		if (Trace.StreamEndOffset > TotalBytesWritten) break;
+
+		//A synchronous write may complete before the send is even stamped, never report a negative hop.
+		Trace.WriteTime = FMath::Max(LastWriteTime, Trace.SendTime);
+	}
+}
+
+void FGazeLatencyTracer::OnAck(int32 Sequence, double Time)
+{
+	for (int32 TraceIdx = 0; TraceIdx < InFlight.Num(); TraceIdx++)
+	{
+		if (InFlight[TraceIdx].EchoText.IsEmpty() && InFlight[TraceIdx].Sequence == Sequence)
+		{
+			Complete(TraceIdx, Time);
+			return;
+		}
+	}
+}
+
+void FGazeLatencyTracer::OnEcho(const FString& Line, double Time)
+{
+	for (int32 TraceIdx = 0; TraceIdx < InFlight.Num(); TraceIdx++)
+	{
+		if (!InFlight[TraceIdx].EchoText.IsEmpty() && InFlight[TraceIdx].EchoText == Line)
+		{
+			Complete(TraceIdx, Time);
+			return;
+		}
+	}
+}
+
+void FGazeLatencyTracer::ExpireOlderThan(double Now, double Timeout)
+{
+	while (InFlight.Num() > 0 && Now - InFlight[0].SendTime > Timeout)
+	{
+		InFlight.RemoveAt(0, 1, false);
+		NumLost++;
+	}
+}
+
+bool FGazeLatencyTracer::IsExpectingFrameAck() const
+{
+	return InFlight.Num() > 0 && InFlight[0].EchoText.IsEmpty();
+}
+
+void FGazeLatencyTracer::Complete(int32 InFlightIdx, double AckTime)
+{
+	FGazeLatencyTrace& Trace = InFlight[InFlightIdx];
+	Trace.AckTime = AckTime;
+	if (Trace.WriteTime <= 0.0)
+	{
+		//The ack can only come after the write, we just haven't polled the write counter since.
+		Trace.WriteTime = Trace.SendTime;
+	}
+
+	NumCompleted++;
+	if (Completed.Num() < MaxCompletedTraces)
+	{
+		Completed.Add(MoveTemp(Trace));
+	}
+	else
+	{
+		Completed[CompletedHead] = MoveTemp(Trace);
+		CompletedHead = (CompletedHead + 1) % MaxCompletedTraces;
+	}
+
+	//Anything sent before an acknowledged command won't be acknowledged anymore.
+	NumLost += InFlightIdx;
+	InFlight.RemoveAt(0, InFlightIdx + 1, false);
+}
+
+FGazeLatencySummary FGazeLatencyTracer::Summarize() const
+{
+	FGazeLatencySummary Summary;
+	Summary.NumCompleted = NumCompleted;
+	Summary.NumLost = NumLost;
+	Summary.NumUnsent = NumUnsent;
+
+	//Hops that weren't stamped, like the sample time when the tracker gave none, are left out rather than counted as 0.
+	auto AddHop = [](TArray<float>& DurationsMs, double From, double To)
+	{
+		const float DurationMs = HopMs(From, To);
+		if (DurationMs >= 0.0f)
+		{
+			DurationsMs.Add(DurationMs);
+		}
+	};
+
+	TArray<float> SampleToRead, ReadToDecision, DecisionToSend, SendToWrite, WriteToAck, EndToEnd;
+	for (const FGazeLatencyTrace& Trace : Completed)
+	{
+		AddHop(SampleToRead, Trace.SampleTime, Trace.ReadTime);
+		AddHop(ReadToDecision, Trace.ReadTime, Trace.DecisionTime);
+		AddHop(DecisionToSend, Trace.DecisionTime, Trace.SendTime);
+		AddHop(SendToWrite, Trace.SendTime, Trace.WriteTime);
+		AddHop(WriteToAck, Trace.WriteTime, Trace.AckTime);
+		AddHop(EndToEnd, Trace.SampleTime, Trace.AckTime);
+	}
+
+	Summary.SampleToRead = CalculatePercentiles(SampleToRead);
+	Summary.ReadToDecision = CalculatePercentiles(ReadToDecision);
+	Summary.DecisionToSend = CalculatePercentiles(DecisionToSend);
+	Summary.SendToWrite = CalculatePercentiles(SendToWrite);
+	Summary.WriteToAck = CalculatePercentiles(WriteToAck);
+	Summary.EndToEnd = CalculatePercentiles(EndToEnd);
+	return Summary;
+}
+
+bool FGazeLatencyTracer::ExportCsv(const FString& FilePath) const
+{
+	FString Csv = TEXT("Zone,Sequence,SampleTime,ReadTime,DecisionTime,SendTime,WriteTime,AckTime,SampleToReadMs,ReadToDecisionMs,DecisionToSendMs,SendToWriteMs,WriteToAckMs,EndToEndMs\n");
+
+	//Oldest first. Once the ring has wrapped, the oldest entry is at the head.
+	for (int32 i = 0; i < Completed.Num(); i++)
+	{
+		const FGazeLatencyTrace& Trace = Completed[(CompletedHead + i) % Completed.Num()];
+		Csv += FString::Printf(TEXT("%s,%d,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n")
+			, *Trace.Zone.ToString(), Trace.Sequence
+			, Trace.SampleTime, Trace.ReadTime, Trace.DecisionTime, Trace.SendTime, Trace.WriteTime, Trace.AckTime
+			, HopMs(Trace.SampleTime, Trace.ReadTime), HopMs(Trace.ReadTime, Trace.DecisionTime), HopMs(Trace.DecisionTime, Trace.SendTime)
+			, HopMs(Trace.SendTime, Trace.WriteTime), HopMs(Trace.WriteTime, Trace.AckTime), HopMs(Trace.SampleTime, Trace.AckTime));
+	}
+
+	return FFileHelper::SaveStringToFile(Csv, *FilePath);
+}
+
+void FGazeLatencyTracer::Reset()
+{
+	bHasPendingTrace = false;
+	InFlight.Reset();
+	Completed.Reset();
+	CompletedHead = 0;
+	NumCompleted = 0;
+	NumLost = 0;
+	NumUnsent = 0;
+}
@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GazeLatencyTracer.generated.h"
+
+/**
+ * Latency percentiles of one hop, in milliseconds.
+ */
+USTRUCT(BlueprintType)
+struct FGazeLatencyPercentiles
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	FGazeLatencyPercentiles()
+		: P50Ms(0.0f)
+		, P90Ms(0.0f)
+		, P99Ms(0.0f)
+		, MaxMs(0.0f)
+	{}
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	float P50Ms;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	float P90Ms;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	float P99Ms;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	float MaxMs;
+};
+
+/**
+ * Latency of the gaze to actuator path. Percentiles are over the most recently completed commands, the counts cover everything since the last reset.
+ */
+USTRUCT(BlueprintType)
+struct FGazeLatencySummary
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	FGazeLatencySummary()
+		: NumCompleted(0)
+		, NumLost(0)
+		, NumUnsent(0)
+	{}
+
+	//Commands whose ack or echo came back.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	int32 NumCompleted;
+	//Commands that were written but never acknowledged.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	int32 NumLost;
+	//Commands that never went out, because a newer one replaced them or they repeated the previous one.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	int32 NumUnsent;
+
+	//The gaze sample arriving in the eye tracker until the component read it. The tracker filters gaze in its own tick before the component reads it, so this hop includes the filter and there is no separate filter output stage.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	FGazeLatencyPercentiles SampleToRead;
+	//Reading the gaze until the zone decision, which includes the dwell time.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	FGazeLatencyPercentiles ReadToDecision;
+	//The zone decision until the command was handed to the serial port.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	FGazeLatencyPercentiles DecisionToSend;
+	//Handing the command to the serial port until the driver accepted it.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	FGazeLatencyPercentiles SendToWrite;
+	//The driver accepting the command until the ack or echo from the car was read.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	FGazeLatencyPercentiles WriteToAck;
+	//The gaze sample arriving until the ack or echo was read.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Latency")
+	FGazeLatencyPercentiles EndToEnd;
+};
+
+/**
+ * Timestamps of one command on its way from a gaze sample to the car. All times are FPlatformTime::Seconds, 0 if the hop hasn't happened.
+ */
+struct FGazeLatencyTrace
+{
+	FName Zone;
+	//The text the sketch echoes back for a char command. Empty for frames.
+	FString EchoText;
+	//Frame sequence, -1 until sent or for char commands.
+	int32 Sequence;
+	//USerial::GetTotalBytesQueued right after the command was written. The command is on the wire once that many bytes were written.
+	uint64 StreamEndOffset;
+
+	double SampleTime;
+	//When the component read the eye tracker's filtered gaze. Also stands in for the filter output, the tracker doesn't stamp that on its own.
+	double ReadTime;
+	double DecisionTime;
+	double SendTime;
+	double WriteTime;
+	double AckTime;
+
+	FGazeLatencyTrace()
+		: Sequence(-1)
+		, StreamEndOffset(0)
+		, SampleTime(0.0)
+		, ReadTime(0.0)
+		, DecisionTime(0.0)
+		, SendTime(0.0)
+		, WriteTime(0.0)
+		, AckTime(0.0)
+	{}
+};
+
+/**
+ * Follows commands through every hop and keeps the completed traces for percentiles and export.
+ * Game thread only. Traces are matched to acks by frame sequence, or to echoes by text in send order.
+ */
+class FGazeLatencyTracer
+{
+public:
+	FGazeLatencyTracer();
+
+	/** A zone decision produced a command. It is only followed further once OnSent is called for it. */
+	void BeginTrace(FName Zone, const FString& EchoText, double SampleTime, double ReadTime, double DecisionTime);
+	/** The most recent command was handed to the serial port. Older commands that never went out are dropped. */
+	void OnSent(int32 Sequence, uint64 StreamEndOffset, double SendTime);
+	/** Stamp write completion for every command the driver has accepted by now. */
+	void OnBytesWritten(uint64 TotalBytesWritten, double LastWriteTime);
+	void OnAck(int32 Sequence, double Time);
+	void OnEcho(const FString& Line, double Time);
+	/** Give up on commands that haven't been acknowledged within Timeout seconds. */
+	void ExpireOlderThan(double Now, double Timeout);
+
+	/** True if the oldest command in flight is a frame, so acks have to be read as frames rather than lines. */
+	bool IsExpectingFrameAck() const;
+	bool HasTracesInFlight() const { return InFlight.Num() > 0; }
+
+	FGazeLatencySummary Summarize() const;
+	bool ExportCsv(const FString& FilePath) const;
+	void Reset();
+
+private:
+	enum { MaxCompletedTraces = 2048 };
+
+	void Complete(int32 InFlightIdx, double AckTime);
+
+	//Only the latest decision can still go out, the output scheduler replaces anything older.
+	FGazeLatencyTrace PendingTrace;
+	bool bHasPendingTrace;
+	TArray<FGazeLatencyTrace> InFlight;
+	//Ring buffer of the most recent completed traces.
+	TArray<FGazeLatencyTrace> Completed;
+	int32 CompletedHead;
+	//Every completed command, not only the ones still in the ring.
+	int32 NumCompleted;
+	int32 NumLost;
+	int32 NumUnsent;
+};
@@ -0,0 +1,306 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GazeZoneControllerComponent.h"
+
+#include "ITobiiCore.h"
+#include "ITobiiEyetracker.h"
+#include "Serial.h"
+#include "SerialOutputScheduler.h"
+
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+static const FName GazeZoneDriveChannel(TEXT("Drive"));
+
+UGazeZoneControllerComponent::UGazeZoneControllerComponent()
+	: DwellTime(0.15f)
+	, HysteresisMargin(0.03f)
+	, WorldHysteresisMargin(10.0f)
+	, WorldGazeRange(100000.0f)
+	, bTraceLatency(true)
+	, AckTimeout(1.0f)
+	, Serial(nullptr)
+	, OutputScheduler(nullptr)
+	, ActiveZoneIndex(INDEX_NONE)
+	, CandidateZoneIndex(INDEX_NONE)
+	, CandidateTime(0.0f)
+	, LastSampleTime(0.0)
+	, LastReadTime(0.0)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+
+	IdleZone.Name = TEXT("Idle");
+	IdleZone.Command = TEXT("n");
+}
+
+void UGazeZoneControllerComponent::SetSerial(USerial* InSerial)
+{
+	if (OutputScheduler != nullptr)
+	{
+		OutputScheduler->OnChannelSent.Remove(ChannelSentHandle);
+		OutputScheduler->Stop();
+		OutputScheduler = nullptr;
+	}
+
+	Serial = InSerial;
+	if (Serial != nullptr)
+	{
+		OutputScheduler = USerialOutputScheduler::CreateOutputScheduler(Serial);
+		ChannelSentHandle = OutputScheduler->OnChannelSent.AddUObject(this, &UGazeZoneControllerComponent::OnChannelSent);
+		SendZoneCommand(Zones.IsValidIndex(ActiveZoneIndex) ? Zones[ActiveZoneIndex] : IdleZone);
+	}
+}
+
+void UGazeZoneControllerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	//Zones may have been removed from Blueprint since the last tick.
+	if (!Zones.IsValidIndex(ActiveZoneIndex))
+	{
+		ActiveZoneIndex = INDEX_NONE;
+	}
+
+	if (bTraceLatency)
+	{
+		ReadAcknowledgements();
+	}
+
+	LastReadTime = FPlatformTime::Seconds();
+	const int32 ZoneIndex = ClassifyGaze(LastSampleTime);
+	if (ZoneIndex == ActiveZoneIndex)
+	{
+		CandidateZoneIndex = ZoneIndex;
+		CandidateTime = 0.0f;
+		return;
+	}
+
+	if (ZoneIndex != CandidateZoneIndex)
+	{
+		CandidateZoneIndex = ZoneIndex;
+		CandidateTime = 0.0f;
+	}
+
+	CandidateTime += DeltaTime;
+	if (CandidateTime >= DwellTime)
+	{
+		ActivateZone(ZoneIndex);
+	}
+}
+
+void UGazeZoneControllerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	//Don't leave the car driving towards wherever the user looked last.
+	if (OutputScheduler != nullptr)
+	{
+		OutputScheduler->OnChannelSent.Remove(ChannelSentHandle);
+		OutputScheduler->Stop();
+		OutputScheduler = nullptr;
+	}
+	SendZoneCommand(IdleZone);
+
+	if (bTraceLatency && LatencyTracer.Summarize().NumCompleted > 0)
+	{
+		LogLatencySummary();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+int32 UGazeZoneControllerComponent::ClassifyGaze(double& OutSampleTime) const
+{
+	OutSampleTime = 0.0;
+
+	TSharedPtr<ITobiiEyeTracker, ESPMode::ThreadSafe> EyeTracker = ITobiiCore::GetEyeTracker();
+	if (!EyeTracker.IsValid()) return INDEX_NONE;
+
+	const FTobiiGazeData& GazeData = EyeTracker->GetCombinedGazeData();
+	if (!GazeData.bIsGazeDataValid) return INDEX_NONE;
+
+	//The tracker stamps samples with UTC wall time when they arrive. Move that onto the monotonic clock the rest of the trace uses.
+	if (GazeData.TimeStamp.GetTicks() > 0)
+	{
+		OutSampleTime = FPlatformTime::Seconds() - (FDateTime::UtcNow() - GazeData.TimeStamp).GetTotalSeconds();
+	}
+
+	const FTobiiDisplayInfo& DisplayInfo = EyeTracker->GetDisplayInformation();
+	const bool bScreenPointValid = DisplayInfo.HasViewportPx();
+	const FVector2D ScreenPointUNorm = GazeData.ScreenGazePointPx * DisplayInfo.ViewportUNormPerPx;
+
+	const bool bRayValid = !GazeData.WorldGazeDirection.IsNearlyZero();
+	const FVector RayStart = GazeData.WorldGazeOrigin;
+	const FVector RayEnd = RayStart + GazeData.WorldGazeDirection.GetSafeNormal() * WorldGazeRange;
+
+	//The active zone gets the margin and goes first, so it keeps the gaze even where it overlaps an earlier zone.
+	if (Zones.IsValidIndex(ActiveZoneIndex)
+		&& IsGazeInZone(Zones[ActiveZoneIndex], ScreenPointUNorm, bScreenPointValid, RayStart, RayEnd, bRayValid, true))
+	{
+		return ActiveZoneIndex;
+	}
+
+	for (int32 ZoneIdx = 0; ZoneIdx < Zones.Num(); ZoneIdx++)
+	{
+		if (ZoneIdx != ActiveZoneIndex
+			&& IsGazeInZone(Zones[ZoneIdx], ScreenPointUNorm, bScreenPointValid, RayStart, RayEnd, bRayValid, false))
+		{
+			return ZoneIdx;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+bool UGazeZoneControllerComponent::IsGazeInZone(const FGazeZone& Zone, const FVector2D& ScreenPointUNorm, bool bScreenPointValid, const FVector& RayStart, const FVector& RayEnd, bool bRayValid, bool bIsActive) const
+{
+	switch (Zone.Space)
+	{
+	case EGazeZoneSpace::Screen:
+		return bScreenPointValid && (bIsActive ? Zone.ScreenRect.ExpandBy(HysteresisMargin) : Zone.ScreenRect).IsInside(ScreenPointUNorm);
+
+	case EGazeZoneSpace::World:
+	{
+		if (!bRayValid) return false;
+
+		const FBox Bounds = bIsActive ? Zone.WorldBounds.ExpandBy(WorldHysteresisMargin) : Zone.WorldBounds;
+		return FMath::LineBoxIntersection(Bounds, RayStart, RayEnd, RayEnd - RayStart);
+	}
+
+	default:
+		return false;
+	}
+}
+
+void UGazeZoneControllerComponent::ActivateZone(int32 ZoneIndex)
+{
+	const FName PreviousZone = GetActiveZone();
+
+	ActiveZoneIndex = ZoneIndex;
+	CandidateTime = 0.0f;
+
+	const FGazeZone& Zone = Zones.IsValidIndex(ActiveZoneIndex) ? Zones[ActiveZoneIndex] : IdleZone;
+	if (bTraceLatency && Serial != nullptr)
+	{
+		LatencyTracer.BeginTrace(Zone.Name, Zone.bSendDriveFrame ? FString() : Zone.Command, LastSampleTime, LastReadTime, FPlatformTime::Seconds());
+	}
+	SendZoneCommand(Zone);
+
+	OnZoneChanged.Broadcast(PreviousZone, GetActiveZone());
+}
+
+void UGazeZoneControllerComponent::SendZoneCommand(const FGazeZone& Zone)
+{
+	if (Serial == nullptr || !Serial->IsOpened()) return;
+
+	if (Zone.bSendDriveFrame)
+	{
+		const TArray<uint8> Payload = USerial::MakeDrivePayload(Zone.LeftDuty, Zone.RightDuty);
+		if (OutputScheduler != nullptr)
+		{
+			OutputScheduler->SetChannelFrame(GazeZoneDriveChannel, (uint8)ESerialFrameCommand::Drive, Payload);
+		}
+		else
+		{
+			const double SendTime = FPlatformTime::Seconds();
+			int32 Sequence;
+			if (Serial->WriteFrame((uint8)ESerialFrameCommand::Drive, Payload, Sequence))
+			{
+				LatencyTracer.OnSent(Sequence, Serial->GetTotalBytesQueued(), SendTime);
+			}
+		}
+		return;
+	}
+
+	if (Zone.Command.IsEmpty()) return;
+
+	auto Convert = FTCHARToUTF8(*Zone.Command);
+	TArray<uint8> Bytes;
+	Bytes.Append((const uint8*)Convert.Get(), Convert.Length());
+	if (OutputScheduler != nullptr)
+	{
+		OutputScheduler->SetChannelBytes(GazeZoneDriveChannel, Bytes);
+	}
+	else
+	{
+		const double SendTime = FPlatformTime::Seconds();
+		if (Serial->WriteBytes(Bytes))
+		{
+			LatencyTracer.OnSent(-1, Serial->GetTotalBytesQueued(), SendTime);
+		}
+	}
+}
+
+void UGazeZoneControllerComponent::OnChannelSent(FName Channel, int32 Sequence, uint64 StreamEndOffset, double PendingSince)
+{
+	if (Channel == GazeZoneDriveChannel)
+	{
+		LatencyTracer.OnSent(Sequence, StreamEndOffset, FPlatformTime::Seconds());
+	}
+}
+
+void UGazeZoneControllerComponent::ReadAcknowledgements()
+{
+	if (Serial == nullptr || !Serial->IsOpened()) return;
+
+	double LastWriteTime;
+	const uint64 TotalBytesWritten = Serial->GetTotalBytesWritten(LastWriteTime);
+	LatencyTracer.OnBytesWritten(TotalBytesWritten, LastWriteTime);
+
+	const double Now = FPlatformTime::Seconds();
+	//Acks of untraced commands still have to be drained, or they'd pile up in the read buffer.
+	const FGazeZone& CurrentZone = Zones.IsValidIndex(ActiveZoneIndex) ? Zones[ActiveZoneIndex] : IdleZone;
+	const bool bReadFrames = LatencyTracer.HasTracesInFlight() ? LatencyTracer.IsExpectingFrameAck() : CurrentZone.bSendDriveFrame;
+	if (bReadFrames)
+	{
+		FSerialFrame Frame;
+		while (Serial->ReadFrame(Frame))
+		{
+			int32 Sequence;
+			uint8 AckedCommandId;
+			ESerialFrameAckStatus Status;
+			if (USerial::BreakAckFrame(Frame, Sequence, AckedCommandId, Status))
+			{
+				LatencyTracer.OnAck(Sequence, Now);
+			}
+		}
+	}
+	else
+	{
+		//ArduinoMovement.ino echoes every char command it acted on with println.
+		while (Serial->TryReadLine(AckLineScratch))
+		{
+			LatencyTracer.OnEcho(AckLineScratch, Now);
+		}
+	}
+
+	LatencyTracer.ExpireOlderThan(Now, AckTimeout);
+}
+
+bool UGazeZoneControllerComponent::ExportLatencyCsv(FString FilePath)
+{
+	if (FilePath.IsEmpty())
+	{
+		FilePath = FPaths::ProjectLogDir() / FString::Printf(TEXT("GazeLatency-%s.csv"), *FDateTime::Now().ToString());
+	}
+
+	const bool bExported = LatencyTracer.ExportCsv(FilePath);
+	UE_LOG(LogTemp, Log, TEXT("%s gaze latency trace to %s"), bExported ? TEXT("Exported") : TEXT("Failed to export"), *FilePath);
+	return bExported;
+}
+
+void UGazeZoneControllerComponent::LogLatencySummary() const
+{
+	const FGazeLatencySummary Summary = LatencyTracer.Summarize();
+	UE_LOG(LogTemp, Log, TEXT("Gaze latency: %d completed, %d lost, %d unsent"), Summary.NumCompleted, Summary.NumLost, Summary.NumUnsent);
+
+	auto LogHop = [](const TCHAR* Name, const FGazeLatencyPercentiles& Hop)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  %-16s p50 %7.1fms  p90 %7.1fms  p99 %7.1fms  max %7.1fms"), Name, Hop.P50Ms, Hop.P90Ms, Hop.P99Ms, Hop.MaxMs);
+	};
+	LogHop(TEXT("Sample->Read"), Summary.SampleToRead);
+	LogHop(TEXT("Read->Decision"), Summary.ReadToDecision);
+	LogHop(TEXT("Decision->Send"), Summary.DecisionToSend);
+	LogHop(TEXT("Send->Write"), Summary.SendToWrite);
+	LogHop(TEXT("Write->Ack"), Summary.WriteToAck);
+	LogHop(TEXT("End to end"), Summary.EndToEnd);
+}
@@ -0,0 +1,182 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GazeLatencyTracer.h"
+#include "GazeZoneControllerComponent.generated.h"
+
+class USerial;
+class USerialOutputScheduler;
+
+UENUM(BlueprintType)
+enum class EGazeZoneSpace : uint8
+{
+	//The zone is a rectangle on the viewport, in 0-1 coordinates with 0,0 in the top left corner.
+	Screen,
+	//The zone is a box in the world that the combined gaze ray has to pass through.
+	World
+};
+
+/**
+ * A region the user can look at, and the command the car gets while they do.
+ */
+USTRUCT(BlueprintType)
+struct FGazeZone
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	FGazeZone()
+		: Space(EGazeZoneSpace::Screen)
+		, ScreenRect(FVector2D(0.0f, 0.0f), FVector2D(1.0f, 1.0f))
+		, WorldBounds(FVector(-50.0f), FVector(50.0f))
+		, bSendDriveFrame(false)
+		, LeftDuty(0)
+		, RightDuty(0)
+	{}
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone")
+	EGazeZoneSpace Space;
+
+	//Only used for screen zones.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone")
+	FBox2D ScreenRect;
+
+	//Only used for world zones.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone")
+	FBox WorldBounds;
+
+	//If true, the zone sends a binary Drive frame with the duties below. Otherwise it sends Command as is, like the single char commands the sketch understands.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone")
+	bool bSendDriveFrame;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone")
+	FString Command;
+
+	//-255 to 255.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone", meta = (ClampMin = -255, ClampMax = 255))
+	int32 LeftDuty;
+
+	//-255 to 255.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone", meta = (ClampMin = -255, ClampMax = 255))
+	int32 RightDuty;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FGazeZoneChanged, FName, PreviousZone, FName, NewZone);
+
+/**
+ * Turns the user's gaze into commands for the car.
+ * Every tick the combined gaze is classified against Zones. The first zone that contains the gaze wins.
+ * A new zone only becomes active after the gaze has stayed in it for DwellTime, and the active zone is
+ * only left once the gaze is HysteresisMargin outside of it, so noise along a border doesn't make the car twitch.
+ * When the active zone changes, its command is sent to Serial, through an output scheduler so stale commands never queue up.
+ */
+UCLASS(ClassGroup = (EyeTracking), meta = (BlueprintSpawnableComponent))
+class EYETRACKING_API UGazeZoneControllerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UGazeZoneControllerComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * Start sending commands to a serial port. Pass null to stop.
+	 * @param InSerial The opened port the car is on.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Gaze Zone")
+	void SetSerial(USerial* InSerial);
+
+	UFUNCTION(BlueprintPure, Category = "Gaze Zone")
+	FName GetActiveZone() const { return Zones.IsValidIndex(ActiveZoneIndex) ? Zones[ActiveZoneIndex].Name : NAME_None; }
+
+	UFUNCTION(BlueprintPure, Category = "Gaze Zone")
+	USerialOutputScheduler* GetOutputScheduler() const { return OutputScheduler; }
+
+	/**
+	 * Latency percentiles of every hop from gaze sample to the car acknowledging the command, over the most recent commands.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Gaze Zone|Latency")
+	FGazeLatencySummary GetLatencySummary() const { return LatencyTracer.Summarize(); }
+
+	/**
+	 * Write every traced command with all of its timestamps to a CSV file.
+	 * @param FilePath Where to write. If empty, a timestamped file in the project's Saved/Logs directory is used.
+	 * @return True if the file was written.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Gaze Zone|Latency")
+	bool ExportLatencyCsv(FString FilePath);
+
+	UFUNCTION(BlueprintCallable, Category = "Gaze Zone|Latency")
+	void LogLatencySummary() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Gaze Zone|Latency")
+	void ResetLatencyStats() { LatencyTracer.Reset(); }
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone")
+	TArray<FGazeZone> Zones;
+
+	//How long the gaze has to stay in a new zone before it becomes active, in seconds.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone", meta = (ClampMin = 0.0f))
+	float DwellTime;
+
+	//How far outside the active screen zone the gaze has to go to leave it, in 0-1 viewport units.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone", meta = (ClampMin = 0.0f))
+	float HysteresisMargin;
+
+	//How far outside the active world zone the gaze ray has to pass to leave it, in cm.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone", meta = (ClampMin = 0.0f))
+	float WorldHysteresisMargin;
+
+	//The longest a world zone test follows the gaze ray, in cm.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone", meta = (ClampMin = 0.0f))
+	float WorldGazeRange;
+
+	//Sent when the gaze is in no zone, or has been lost for longer than DwellTime.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone")
+	FGazeZone IdleZone;
+
+	UPROPERTY(BlueprintAssignable, Category = "Gaze Zone")
+	FGazeZoneChanged OnZoneChanged;
+
+	//Read acks (binary frames) and echoes (char commands) back from the port to time the full round trip.
+	//Turn this off if something else reads from the same port.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone|Latency")
+	bool bTraceLatency;
+
+	//Commands that aren't acknowledged within this many seconds are counted as lost.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Zone|Latency", meta = (ClampMin = 0.0f))
+	float AckTimeout;
+
+protected:
+	UPROPERTY(Transient)
+	USerial* Serial;
+
+	UPROPERTY(Transient)
+	USerialOutputScheduler* OutputScheduler;
+
+	int32 ActiveZoneIndex;
+	int32 CandidateZoneIndex;
+	float CandidateTime;
+
+	FGazeLatencyTracer LatencyTracer;
+	FDelegateHandle ChannelSentHandle;
+	FString AckLineScratch;
+	double LastSampleTime;
+	double LastReadTime;
+
+	int32 ClassifyGaze(double& OutSampleTime) const;
+	bool IsGazeInZone(const FGazeZone& Zone, const FVector2D& ScreenPointUNorm, bool bScreenPointValid, const FVector& RayStart, const FVector& RayEnd, bool bRayValid, bool bIsActive) const;
+	void ActivateZone(int32 ZoneIndex);
+	void SendZoneCommand(const FGazeZone& Zone);
+	void OnChannelSent(FName Channel, int32 Sequence, uint64 StreamEndOffset, double PendingSince);
+	void ReadAcknowledgements();
+};
@@ -104,6 +104,26 @@ FRotator UTobiiBlueprintLibrary::GetTobiiInfiniteScreenAngles()
 /************************************************************************/
 /* Utils                                                                */
 /************************************************************************/
+//The per point conversions all go through the transform the tracker published this tick.
+static const FTobiiViewportTransform& GetPublishedViewportTransform()
+{
+	static FTobiiViewportTransform DummyTransform;
+	return FTobiiCoreModule::IsAvailable() ? FTobiiCoreModule::GetEyeTracker()->GetViewportTransform() : DummyTransform;
+}
+
+static bool ConvertWithPublishedTransform(ETobiiCoordinateSpace From, ETobiiCoordinateSpace To, const FVector2D& InPoint, FVector2D& OutPoint)
+{
+	const FTobiiViewportTransform& Transform = GetPublishedViewportTransform();
+	if (!Transform.CanConvert(From, To))
+	{
+		OutPoint = FVector2D::ZeroVector;
+		return false;
+	}
+
+	OutPoint = Transform.Convert(From, To, InPoint);
+	return true;
+}
+
 bool UTobiiBlueprintLibrary::VirtualDesktopPixelToViewportCoordinateUNorm(const FVector2D& VirtualDesktopPixel, FVector2D& OutViewportCoordinateUNorm)
 {
 	if (!FTobiiCoreModule::IsAvailable() || GEngine == nullptr || GEngine->GameViewport == nullptr || GEngine->GameViewport->GetGameViewport() == nullptr)
@@ -111,6 +131,13 @@ bool UTobiiBlueprintLibrary::VirtualDesktopPixelToViewportCoordinateUNorm(const
 		return false;
 	}
 
+	const FVector2D VirtualDesktopPixelSnapped(FMath::TruncToFloat(VirtualDesktopPixel.X), FMath::TruncToFloat(VirtualDesktopPixel.Y));
+	if (ConvertWithPublishedTransform(ETobiiCoordinateSpace::VirtualDesktopPixel, ETobiiCoordinateSpace::ViewportUNorm, VirtualDesktopPixelSnapped, OutViewportCoordinateUNorm))
+	{
+		return true;
+	}
+
+	//The tracker only publishes while it is enabled. This conversion doesn't need it though.
 	OutViewportCoordinateUNorm = GEngine->GameViewport->GetGameViewport()->VirtualDesktopPixelToViewport(FIntPoint(VirtualDesktopPixel.X, VirtualDesktopPixel.Y));
 	return true;
 }
@@ -124,65 +151,51 @@ bool UTobiiBlueprintLibrary::ViewportCoordinateUNormToVirtualDesktopPixel(const
 	
 	const FTobiiDisplayInfo& DisplayInfo = FTobiiCoreModule::GetEyeTracker()->GetDisplayInformation();
 	FVector2D ScaledInPoint(ViewportCoordinateUNorm.X / DisplayInfo.DpiScale, ViewportCoordinateUNorm.Y / DisplayInfo.DpiScale);
-	OutVirtualDesktopPixel = GEngine->GameViewport->GetGameViewport()->ViewportToVirtualDesktopPixel(ScaledInPoint);
+	if (ConvertWithPublishedTransform(ETobiiCoordinateSpace::ViewportUNorm, ETobiiCoordinateSpace::VirtualDesktopPixel, ScaledInPoint, OutVirtualDesktopPixel))
+	{
+		OutVirtualDesktopPixel.Set(FMath::TruncToFloat(OutVirtualDesktopPixel.X), FMath::TruncToFloat(OutVirtualDesktopPixel.Y));
+		return true;
+	}
 
+	OutVirtualDesktopPixel = GEngine->GameViewport->GetGameViewport()->ViewportToVirtualDesktopPixel(ScaledInPoint);
 	return true;
 }
 
 bool UTobiiBlueprintLibrary::ViewportPixelCoordToCmCoord(const FVector2D& InCoordinatePx, FVector2D& OutCoordinateCm)
 {
-	const FTobiiDisplayInfo& DisplayInfo = FTobiiCoreModule::GetEyeTracker()->GetDisplayInformation();
-
-	if (DisplayInfo.MainViewportWidthPx > 0.0f && DisplayInfo.MainViewportWidthCm > 0.0f && DisplayInfo.MainViewportHeightPx > 0.0f && DisplayInfo.MainViewportHeightCm > 0.0f)
-	{
-		OutCoordinateCm.Set(InCoordinatePx.X / DisplayInfo.MainViewportWidthPx * DisplayInfo.MainViewportWidthCm, InCoordinatePx.Y / DisplayInfo.MainViewportHeightPx * DisplayInfo.MainViewportHeightCm);
-		return true;
-	}
-
-	OutCoordinateCm = FVector2D::ZeroVector;
-	return false;
+	return ConvertWithPublishedTransform(ETobiiCoordinateSpace::ViewportPixel, ETobiiCoordinateSpace::ViewportCm, InCoordinatePx, OutCoordinateCm);
 }
 
 bool UTobiiBlueprintLibrary::ViewportCmCoordToPixelCoord(const FVector2D& InCoordinateCm, FVector2D& OutCoordinatePx)
 {
-	const FTobiiDisplayInfo& DisplayInfo = FTobiiCoreModule::GetEyeTracker()->GetDisplayInformation();
-
-	if (DisplayInfo.MainViewportWidthPx > 0.0f && DisplayInfo.MainViewportWidthCm > 0.0f && DisplayInfo.MainViewportHeightPx > 0.0f && DisplayInfo.MainViewportHeightCm > 0.0f)
-	{
-		OutCoordinatePx.Set(InCoordinateCm.X / DisplayInfo.MainViewportWidthCm * DisplayInfo.MainViewportWidthPx, InCoordinateCm.Y / DisplayInfo.MainViewportHeightCm * DisplayInfo.MainViewportHeightPx);
-		return true;
-	}
-
-	OutCoordinatePx = FVector2D::ZeroVector;
-	return false;
+	return ConvertWithPublishedTransform(ETobiiCoordinateSpace::ViewportCm, ETobiiCoordinateSpace::ViewportPixel, InCoordinateCm, OutCoordinatePx);
 }
 
 bool UTobiiBlueprintLibrary::ViewportPixelCoordToUNormCoord(const FVector2D& InCoordinatePx, FVector2D& OutCoordinateUNorm)
 {
-	const FTobiiDisplayInfo& DisplayInfo = FTobiiCoreModule::GetEyeTracker()->GetDisplayInformation();
-
-	if (DisplayInfo.MainViewportWidthPx > 0.0f && DisplayInfo.MainViewportHeightPx > 0.0f)
-	{
-		OutCoordinateUNorm.Set(InCoordinatePx.X / DisplayInfo.MainViewportWidthPx, InCoordinatePx.Y / DisplayInfo.MainViewportHeightPx);
-		return true;
-	}
-
-	OutCoordinateUNorm = FVector2D::ZeroVector;
-	return false;
+	return ConvertWithPublishedTransform(ETobiiCoordinateSpace::ViewportPixel, ETobiiCoordinateSpace::ViewportUNorm, InCoordinatePx, OutCoordinateUNorm);
 }
 
 bool UTobiiBlueprintLibrary::ViewportUNormCoordToPixelCoord(const FVector2D& InCoordinateUNorm, FVector2D& OutCoordinatePx)
 {
-	const FTobiiDisplayInfo& DisplayInfo = FTobiiCoreModule::GetEyeTracker()->GetDisplayInformation();
+	return ConvertWithPublishedTransform(ETobiiCoordinateSpace::ViewportUNorm, ETobiiCoordinateSpace::ViewportPixel, InCoordinateUNorm, OutCoordinatePx);
+}
 
-	if (DisplayInfo.MainViewportWidthPx > 0.0f && DisplayInfo.MainViewportHeightPx > 0.0f)
-	{
-		OutCoordinatePx.Set(InCoordinateUNorm.X * DisplayInfo.MainViewportWidthPx, InCoordinateUNorm.Y * DisplayInfo.MainViewportHeightPx);
-		return true;
-	}
+FTobiiViewportTransform UTobiiBlueprintLibrary::GetTobiiViewportTransform()
+{
+	return GetPublishedViewportTransform();
+}
 
-	OutCoordinatePx = FVector2D::ZeroVector;
-	return false;
+bool UTobiiBlueprintLibrary::ConvertTobiiCoordinate(const FTobiiViewportTransform& ViewportTransform, ETobiiCoordinateSpace From, ETobiiCoordinateSpace To, const FVector2D& InPoint, FVector2D& OutPoint)
+{
+	OutPoint = ViewportTransform.Convert(From, To, InPoint);
+	return ViewportTransform.CanConvert(From, To);
+}
+
+bool UTobiiBlueprintLibrary::ConvertTobiiCoordinates(const FTobiiViewportTransform& ViewportTransform, ETobiiCoordinateSpace From, ETobiiCoordinateSpace To, const TArray<FVector2D>& InPoints, TArray<FVector2D>& OutPoints)
+{
+	OutPoints.SetNumUninitialized(InPoints.Num(), false);
+	return ViewportTransform.ConvertPoints(From, To, InPoints.GetData(), OutPoints.GetData(), InPoints.Num());
 }
 
 // internal helper
@@ -40,14 +40,31 @@ static TAutoConsoleVariable<float> CVarExtendedViewMaxGazeAngleDeg(TEXT("tobii.d
 static TAutoConsoleVariable<float> CVarExtendedViewHeadSensitivity(TEXT("tobii.desktop.ExtendedViewHeadSensitivity"), 0.5f, TEXT("This is how sensitive the head component of extended view will be."));
 static TAutoConsoleVariable<float> CVarExtendedViewGazeSensitivity(TEXT("tobii.desktop.ExtendedViewGazeSensitivity"), 0.5f, TEXT("This is how sensitive the gaze component of extended view will be."));
 static TAutoConsoleVariable<float> CVarExtendedViewGazeOnlyScalar(TEXT("tobii.desktop.ExtendedViewGazeOnlyScalar"), 1.3f, TEXT("This is how we will scale the gaze extended view if only gaze is available."));
+static TAutoConsoleVariable<int32> CVarTobiiMultiTracker(TEXT("tobii.desktop.MultiTracker"), 0, TEXT("0 - Only the tracker on the game window's display is used. 1 - Every attached desktop tracker is used, each reading the display it is mounted on. Gaze from all of them is merged into one timeline, so a game window stretched over several displays gets gaze on all of them."));
+static TAutoConsoleVariable<float> CVarTobiiMultiTrackerPollHz(TEXT("tobii.desktop.MultiTrackerPollHz"), 250.0f, TEXT("How often the additional trackers are read, each on its own thread. Gaze points are buffered by the tracker, so this only has to be fast enough to not add noticeable latency. Changing it applies to trackers found from then on."));
 static TAutoConsoleVariable<float> CVarExtendedViewHeadOnlyScalar(TEXT("tobii.desktop.ExtendedViewHeadOnlyScalar"), 1.3f, TEXT("This is how we will scale the head extended view if only head is available."));
 
 static TAutoConsoleVariable<float> CVarHMDScreenDistanceToEyeCm(TEXT("tobii.xr.HMDScreenDistanceToEyeCm"), 3.0f, TEXT("Since the foveal cone on the screen depends on the distance of the eye from the screen, we need this. Since UE4 doesn't provide APIs to poll it dynamically, you have to set it manually here instead."));
 static TAutoConsoleVariable<int32> CVarTobiiApplyHMDOrientation(TEXT("tobii.xr.ApplyHMDOrientation"), 1, TEXT("Apply the HMD orientation to your gaze direction"));
 static TAutoConsoleVariable<int32> CVarTobiiApplyActorRotation(TEXT("tobii.xr.ApplyActorRotation"), 1, TEXT("Apply your actor rotation to your gaze direction"));
+static TAutoConsoleVariable<float> CVarTobiiXRGazeAdditionalLatencyMs(TEXT("tobii.xr.GazeAdditionalLatencyMs"), 0.0f, TEXT("Gaze samples are matched with the HMD pose from when they were captured. The capture time is estimated from the fastest sample delivery seen, so if you know the tracker's shortest delivery latency, set it here to move the match that much further back."));
+static TAutoConsoleVariable<int32> CVarTobiiXRVergenceTrace(TEXT("tobii.xr.VergenceTrace"), 0, TEXT("0 - The combined gaze ray is traced the full tobii.MaximumTraceDistance. 1 - The fixation depth is estimated from where the eye rays cross, and the combined gaze ray is only traced a little past it to check for occlusion. Also fills in WorldFixationDepth."));
+static TAutoConsoleVariable<float> CVarTobiiXRVergenceTraceDepthMargin(TEXT("tobii.xr.VergenceTraceDepthMargin"), 0.5f, TEXT("How far past the estimated fixation depth the combined gaze ray is traced, as a fraction of that depth. Vergence gets less precise with distance, so the margin grows with it."));
+static TAutoConsoleVariable<float> CVarTobiiXRMinVergenceAngleDeg(TEXT("tobii.xr.MinVergenceAngleDeg"), 0.25f, TEXT("Eye rays closer to parallel than this are considered to not cross at all, and the full trace distance is used. 0.25 degrees is roughly 15 meters away."));
 
-static TAutoConsoleVariable<int32> CVarEnableEyetrackingEmulation(TEXT("tobii.emulation.EnableEyetrackingEmulation"), 0, TEXT("0 - Don't emulate eye tracking. 1 - Emulate eye tracking."));
+static TAutoConsoleVariable<int32> CVarEnableEyetrackingEmulation(TEXT("tobii.emulation.EnableEyetrackingEmulation"), 0, TEXT("0 - Don't emulate eye tracking. 1 - Emulate eye tracking, the gaze point is moved with the arrow keys. 2 - Emulate eye tracking with synthetic gaze: fixations, saccades, smooth pursuit, blinks and noise, fed through the same code as real gaze points. Desktop only, XR uses the arrow keys for both."));
 static TAutoConsoleVariable<float> CVarEyetrackingEmulationGazeSpeed(TEXT("tobii.emulation.DesktopEyetrackingEmulationGazeSpeed"), 0.4f, TEXT("When emulating gaze on desktop, this is the speed scalar used for the gaze point."));
+static TAutoConsoleVariable<float> CVarSyntheticGazeSampleRateHz(TEXT("tobii.emulation.SyntheticGazeSampleRateHz"), 90.0f, TEXT("The rate synthetic gaze points are generated at. Changing it restarts the sequence."));
+static TAutoConsoleVariable<int32> CVarSyntheticGazeSeed(TEXT("tobii.emulation.SyntheticGazeSeed"), 0, TEXT("The same seed always gives the same sequence of synthetic gaze points, regardless of frame rate. Changing it, or any other synthetic gaze setting, restarts the sequence."));
+static TAutoConsoleVariable<float> CVarSyntheticGazeNoiseDeg(TEXT("tobii.emulation.SyntheticGazeNoiseDeg"), 0.3f, TEXT("Standard deviation of the noise added to synthetic gaze points, in degrees of visual angle. Real trackers are usually between 0.1 and 0.5."));
+static TAutoConsoleVariable<float> CVarSyntheticGazeBlinksPerMinute(TEXT("tobii.emulation.SyntheticGazeBlinksPerMinute"), 15.0f, TEXT("How often the synthetic user blinks. No gaze points are delivered during a blink, just like with a real tracker."));
+static TAutoConsoleVariable<float> CVarSyntheticGazePursuitProbability(TEXT("tobii.emulation.SyntheticGazePursuitProbability"), 0.15f, TEXT("The chance that a synthetic fixation is followed by smooth pursuit instead of a saccade."));
+static TAutoConsoleVariable<float> CVarSyntheticGazeFieldWidthDeg(TEXT("tobii.emulation.SyntheticGazeFieldWidthDeg"), 50.0f, TEXT("The visual angle the screen covers horizontally, which sets how far a synthetic saccade of a given amplitude moves across the screen. The vertical angle follows the viewport aspect ratio."));
+
+static TAutoConsoleVariable<float> CVarGazeEventsSaccadeStartDegPerSec(TEXT("tobii.events.SaccadeStartDegPerSec"), 100.0f, TEXT("A saccade event starts when the gaze moves faster than this, relative to the head. Lower it if small saccades are missed, raise it if noisy gaze gives false saccades."));
+static TAutoConsoleVariable<float> CVarGazeEventsSaccadeEndDegPerSec(TEXT("tobii.events.SaccadeEndDegPerSec"), 50.0f, TEXT("A saccade event ends when the gaze slows down below this. Keep it below tobii.events.SaccadeStartDegPerSec so speeds around the threshold don't flicker between saccade and fixation."));
+static TAutoConsoleVariable<float> CVarGazeEventsMinFixationMs(TEXT("tobii.events.MinFixationMs"), 60.0f, TEXT("How long the gaze has to stay at rest before a fixation starts. The fixation start event is still stamped with when the gaze came to rest."));
+static TAutoConsoleVariable<float> CVarGazeEventsBlinkGapMs(TEXT("tobii.events.BlinkGapMs"), 75.0f, TEXT("No gaze samples for this long while the user is present starts a blink event. Has to be longer than the time between two samples, at the frame rate the tracker is read at."));
 
 static TAutoConsoleVariable<int32> CVarEnableEyetrackingDebug(TEXT("tobii.debug"), 0, TEXT("0 - Eyetracking debug visualizations are disabled. 1 - Eyetracking debug visualizations are enabled."));
 static TAutoConsoleVariable<int32> CVarEnableGazePointDebug(TEXT("tobii.debug.EnableGazePointDebug"), 1, TEXT("0 - Gaze point debug visualizations are disabled. 1 - Gaze point debug visualizations are enabled."));
@@ -57,23 +74,66 @@ static TAutoConsoleVariable<int32> CVarEnableHeadPoseDebug(TEXT("tobii.debug.Ena
 
 using namespace TobiiGameIntegration;
 
+//Midpoint of the closest approach of the two eye rays. Fails when the rays are too close to parallel, or only come closest behind the eyes.
+static bool EstimateVergenceFixationPoint(const FTobiiGazeData& LeftGazeData, const FTobiiGazeData& RightGazeData, float MinVergenceAngleDeg, FVector& OutFixationPoint)
+{
+	const float CosVergenceAngle = FVector::DotProduct(LeftGazeData.WorldGazeDirection, RightGazeData.WorldGazeDirection);
+	if (CosVergenceAngle > FMath::Cos(FMath::DegreesToRadians(FMath::Max(MinVergenceAngleDeg, KINDA_SMALL_NUMBER))))
+	{
+		return false;
+	}
+
+	const FVector RightToLeft = LeftGazeData.WorldGazeOrigin - RightGazeData.WorldGazeOrigin;
+	const float LeftDot = FVector::DotProduct(LeftGazeData.WorldGazeDirection, RightToLeft);
+	const float RightDot = FVector::DotProduct(RightGazeData.WorldGazeDirection, RightToLeft);
+	const float Denominator = 1.0f - CosVergenceAngle * CosVergenceAngle;
+	const float LeftDistance = (CosVergenceAngle * RightDot - LeftDot) / Denominator;
+	const float RightDistance = (RightDot - CosVergenceAngle * LeftDot) / Denominator;
+	if (LeftDistance <= 0.0f || RightDistance <= 0.0f)
+	{
+		return false;
+	}
+
+	const FVector LeftClosestPoint = LeftGazeData.WorldGazeOrigin + (LeftGazeData.WorldGazeDirection * LeftDistance);
+	const FVector RightClosestPoint = RightGazeData.WorldGazeOrigin + (RightGazeData.WorldGazeDirection * RightDistance);
+	OutFixationPoint = (LeftClosestPoint + RightClosestPoint) / 2.0f;
+	return true;
+}
+
 FTobiiEyeTracker::FTobiiEyeTracker()
 	: TgiApi(nullptr)
 	, ActivePlayerController(nullptr)
+	, bLeftWorldGazeHitDataDirty(false)
+	, bRightWorldGazeHitDataDirty(false)
+	, EyeTraceDistance(0.0f)
+	, bDisplayInfoDirty(true)
+	, bDisplayInfoTrackerConnected(false)
+	, DisplayInfoViewport(nullptr)
+	, bSyntheticGazeStarted(false)
+	, NextTrackerStreamUpdateSecs(0.0)
+	, bHasWarnedAboutTrackerStreamApi(false)
+	, LastGazeEventSampleSecs(0.0)
+	, bGazeClockFollowsSyntheticGaze(false)
 	, bIsXR(false)
+	, GazeDataTimeStampMicroSecs(0)
+	, GazePointDeltaTimeMicroSecs(0)
 {
 	TgiApi = GetApi(TCHAR_TO_ANSI(FApp::GetProjectName()));
 	StartTime = FDateTime::UtcNow();
+	ViewportResizedHandle = FViewport::ViewportResizedEvent.AddRaw(this, &FTobiiEyeTracker::OnViewportResized);
 	ResetData();
 }
 
 FTobiiEyeTracker::~FTobiiEyeTracker()
 {
+	FViewport::ViewportResizedEvent.Remove(ViewportResizedHandle);
 	Shutdown();
 }
 
 void FTobiiEyeTracker::Shutdown()
 {
+	TrackerStreams.Empty();
+
 	if (TgiApi != nullptr)
 	{
 		TgiApi->Shutdown();
@@ -104,15 +164,33 @@ void FTobiiEyeTracker::ResetData()
 	CombinedWorldGazeHitData = FHitResult();
 	LeftWorldGazeHitData= FHitResult();
 	RightWorldGazeHitData = FHitResult();
+	bLeftWorldGazeHitDataDirty = bRightWorldGazeHitDataDirty = false;
+	EyeTraceWorld.Reset();
 	LeftGazeData = FTobiiGazeData();
 	RightGazeData = FTobiiGazeData();
 	CombinedGazeData = FTobiiGazeData();
 	GazeTrackerStatus = ETobiiGazeTrackerStatus::NotConnected;
 	HeadPoseData = FTobiiHeadPoseData();
 	DisplayInfo = FTobiiDisplayInfo();
+	ViewportTransform = FTobiiViewportTransform();
+	bDisplayInfoDirty = true;
 
+	GazeDataTimeStampMicroSecs = 0;
 	GazePointDeltaTimeMicroSecs = 0;
 	CurrentAverageGazeAngularSpeedDegPerMicroSecs = 0.0;
+	GazeClock.Reset();
+	HMDPoseHistory.Reset();
+	bSyntheticGazeStarted = false;
+
+	//Stopping the streams also stops their threads from reading gaze nobody will consume.
+	TrackerStreams.Empty();
+	NextTrackerStreamUpdateSecs = 0.0;
+
+	GazeEventClassifier.Reset(FPlatformTime::Seconds(), FDateTime::UtcNow(), PendingGazeEvents);
+	GazeEventSamples.Reset();
+	LastGazeEventSampleSecs = 0.0;
+	GazeEventSampleTimeStamp = FDateTime();
+	BroadcastGazeEvents();
 }
 
 bool FTobiiEyeTracker::Tick(float DeltaTime)
@@ -153,6 +231,7 @@ bool FTobiiEyeTracker::Tick(float DeltaTime)
 		ResetData();
 		return true;
 	}
+	UpdateViewportTransform();
 
 	//If we have no active PC, set default
 	if (!ActivePlayerController.IsValid())
@@ -164,6 +243,7 @@ bool FTobiiEyeTracker::Tick(float DeltaTime)
 	{
 		if (bIsXR)
 		{
+			TrackerStreams.Empty();
 			TickXR(DeltaTime);
 		}
 		else
@@ -174,6 +254,14 @@ bool FTobiiEyeTracker::Tick(float DeltaTime)
 
 	UpdateWorldSpaceData(DeltaTime);
 	UpdateStabilityData(DeltaTime);
+	UpdateGazeEvents();
+
+	//View extensions need GEngine, which doesn't exist yet when the tracker is made.
+	if (!FoveationViewExtension.IsValid())
+	{
+		FoveationViewExtension = FSceneViewExtensions::NewExtension<FTobiiFoveationViewExtension>();
+	}
+	FoveationViewExtension->SetGaze(CombinedGazeData, DisplayInfo, GazeTrackerStatus != ETobiiGazeTrackerStatus::UserNotPresent);
 
 	if (ActivePlayerController.IsValid()
 		&& ActivePlayerController->GetWorld() != nullptr
@@ -222,12 +310,31 @@ bool FTobiiEyeTracker::UpdateLowLevelResources()
 		}
 
 		DisplayInfo.GameMonitorHandle = FTobiiPlatformSpecific::GetMonitorInformation(DisplayInfo.GameWindowHandle, DisplayInfo.MonitorWidthPx, DisplayInfo.MonitorHeightPx);
+		bDisplayInfoDirty = true;
 	}
-	
-	//Since the viewport size can change every frame, we cannot treat this data as constant.
+
 	IStreamsProvider* StreamsProvider = TgiApi->GetStreamsProvider();
-	if (StreamsProvider != nullptr)
+	if (StreamsProvider == nullptr)
+	{
+		return true;
+	}
+
+	//Window moves, resizes and DPI changes come in through the platform notifications and viewport resizes through the viewport event.
+	//What is left to watch is the game viewport being replaced, like between PIE sessions, and the tracker connecting, since it only knows the monitor size once it has.
+	ITrackerController* TrackerController = TgiApi->GetTrackerController();
+	const bool bTrackerConnected = TrackerController != nullptr && TrackerController->IsConnected();
+	const FViewport* GameViewport = GEngine->GameViewport->Viewport;
+	if (bTrackerConnected != bDisplayInfoTrackerConnected || GameViewport != DisplayInfoViewport)
 	{
+		bDisplayInfoTrackerConnected = bTrackerConnected;
+		DisplayInfoViewport = GameViewport;
+		bDisplayInfoDirty = true;
+	}
+
+	if (bDisplayInfoDirty)
+	{
+		bDisplayInfoDirty = false;
+
 		GazePoint MaxGazeUNorm, MaxGazeMm;
 		MaxGazeUNorm.X = MaxGazeUNorm.Y = 1.0f;
 		StreamsProvider->ConvertGazePoint(MaxGazeUNorm, MaxGazeMm, Normalized, Mm);
@@ -241,11 +348,42 @@ bool FTobiiEyeTracker::UpdateLowLevelResources()
 		DisplayInfo.MainViewportHeightPx = ViewportSize.Y;
 		DisplayInfo.MainViewportWidthCm = (((float)DisplayInfo.MainViewportWidthPx / (float)DisplayInfo.MonitorWidthPx) * DisplayInfo.MonitorWidthCm);
 		DisplayInfo.MainViewportHeightCm = (((float)DisplayInfo.MainViewportHeightPx / (float)DisplayInfo.MonitorHeightPx) * DisplayInfo.MonitorHeightCm);
+		DisplayInfo.UpdateViewportScales();
+
+		//The tracker may take a moment after connecting before it knows its display.
+		bDisplayInfoDirty = bTrackerConnected && !DisplayInfo.HasViewportCm();
 	}
 
 	return true;
 }
 
+void FTobiiEyeTracker::OnViewportResized(FViewport* Viewport, uint32 Unused)
+{
+	bDisplayInfoDirty = true;
+}
+
+void FTobiiEyeTracker::UpdateViewportTransform()
+{
+	FTobiiAxisAlignedAffine UNormToSpace[(int32)ETobiiCoordinateSpace::Count];
+	UNormToSpace[(int32)ETobiiCoordinateSpace::ViewportPixel] = FTobiiAxisAlignedAffine(DisplayInfo.ViewportPxPerUNorm, FVector2D::ZeroVector);
+	UNormToSpace[(int32)ETobiiCoordinateSpace::ViewportCm] = FTobiiAxisAlignedAffine(DisplayInfo.ViewportPxPerUNorm * DisplayInfo.ViewportCmPerPx, FVector2D::ZeroVector);
+
+	//This is FSceneViewport::ViewportToVirtualDesktopPixel folded into one map. The window can move without us being told about it in the editor, so this is redone every tick.
+	FTobiiAxisAlignedAffine UNormToVirtualDesktop(FVector2D::ZeroVector, FVector2D::ZeroVector);
+	FSceneViewport* GameViewport = GEngine->GameViewport->GetGameViewport();
+	if (GameViewport != nullptr)
+	{
+		const FGeometry& Geometry = GameViewport->GetCachedGeometry();
+		const FSlateRenderTransform& LocalToAbsolute = Geometry.GetAccumulatedRenderTransform();
+		float A, B, C, D;
+		LocalToAbsolute.GetMatrix().GetMatrix(A, B, C, D);
+		UNormToVirtualDesktop = FTobiiAxisAlignedAffine(Geometry.GetLocalSize() * FVector2D(A, D), LocalToAbsolute.GetTranslation());
+	}
+	UNormToSpace[(int32)ETobiiCoordinateSpace::VirtualDesktopPixel] = UNormToVirtualDesktop;
+
+	ViewportTransform.Compose(UNormToSpace);
+}
+
 FVector2D& FTobiiEyeTracker::TickEmulatedGazePointUNorm(float DeltaTime)
 {
 	static FVector2D EmulatedGazeNorm(0.5f, 0.5f);
@@ -287,20 +425,38 @@ void FTobiiEyeTracker::TickDesktop(float DeltaTime)
 		TrackerController->TrackWindow(DisplayInfo.GameWindowHandle);
 	}
 	TgiApi->Update();
+	UpdateTrackerStreams();
 
 	FDateTime Now = FDateTime::UtcNow();
 	IStreamsProvider* StreamsProvider = nullptr;
+	bool bIsGameWindowTrackerConnected = false;
 	bool bIsEmulating = false;
+	bool bIsSyntheticGaze = false;
 	if (CVarEnableEyetrackingEmulation.GetValueOnGameThread())
 	{
 		bIsEmulating = true;
+		bIsSyntheticGaze = CVarEnableEyetrackingEmulation.GetValueOnGameThread() == 2;
 		GazeTrackerStatus = ETobiiGazeTrackerStatus::UserPresent;
 	}
+
+	//Synthetic timestamps start at zero, they can't share a clock offset with the tracker's.
+	if (bIsSyntheticGaze != bGazeClockFollowsSyntheticGaze)
+	{
+		GazeClock.Reset();
+		bGazeClockFollowsSyntheticGaze = bIsSyntheticGaze;
+	}
 	else
 	{
-		//Test for status
+		//Test for status. The game window may be on a display without a tracker, in which case only the other trackers have gaze for it.
 		StreamsProvider = TgiApi->GetStreamsProvider();
-		if (StreamsProvider != nullptr && TrackerController != nullptr && TrackerController->IsConnected())
+		bIsGameWindowTrackerConnected = StreamsProvider != nullptr && TrackerController != nullptr && TrackerController->IsConnected();
+		bool bIsAnyTrackerConnected = bIsGameWindowTrackerConnected;
+		for (const TUniquePtr<FTobiiTrackerStream>& TrackerStream : TrackerStreams)
+		{
+			bIsAnyTrackerConnected = bIsAnyTrackerConnected || TrackerStream->IsConnected();
+		}
+
+		if (bIsAnyTrackerConnected)
 		{
 			if (GazeTrackerStatus < ETobiiGazeTrackerStatus::UserNotPresent)
 			{
@@ -315,7 +471,15 @@ void FTobiiEyeTracker::TickDesktop(float DeltaTime)
 
 	if (GazeTrackerStatus >= ETobiiGazeTrackerStatus::UserNotPresent)
 	{
-		if (bIsEmulating)
+		if (bIsSyntheticGaze)
+		{
+			TickSyntheticGaze(DeltaTime);
+			ConsumeGazePoints(SyntheticGazePoints.GetData(), SyntheticGazePoints.Num(), Now);
+			HeadPoseData.HeadLocation = FVector::ZeroVector;
+			HeadPoseData.HeadOrientation = FRotator::ZeroRotator;
+			InfiniteScreenAngles = FRotator::ZeroRotator;
+		}
+		else if (bIsEmulating)
 		{
 			RawGazePoint.TimeStamp = Now;
 			RawGazePoint.GazePointNormalized = TickEmulatedGazePointUNorm(DeltaTime);
@@ -325,30 +489,28 @@ void FTobiiEyeTracker::TickDesktop(float DeltaTime)
 		}
 		else
 		{
-			GazeTrackerStatus = StreamsProvider->IsPresent() ? ETobiiGazeTrackerStatus::UserPresent : ETobiiGazeTrackerStatus::UserNotPresent;
+			bool bIsUserPresent = bIsGameWindowTrackerConnected && StreamsProvider->IsPresent();
+			for (const TUniquePtr<FTobiiTrackerStream>& TrackerStream : TrackerStreams)
+			{
+				bIsUserPresent = bIsUserPresent || TrackerStream->IsUserPresent();
+			}
+			GazeTrackerStatus = bIsUserPresent ? ETobiiGazeTrackerStatus::UserPresent : ETobiiGazeTrackerStatus::UserNotPresent;
 
 			//Get new gaze data
-			const GazePoint* GazePointsSinceLastUpdateSNorm;
-			int NumGazePointsSinceLastUpdate = StreamsProvider->GetGazePoints(GazePointsSinceLastUpdateSNorm);
-			if (NumGazePointsSinceLastUpdate > 0)
+			const GazePoint* GazePointsSinceLastUpdateSNorm = nullptr;
+			int NumGazePointsSinceLastUpdate = bIsGameWindowTrackerConnected ? StreamsProvider->GetGazePoints(GazePointsSinceLastUpdateSNorm) : 0;
+			if (TrackerStreams.Num() > 0)
 			{
-				RawGazePoint.GazePointNormalized.Set(0.0f, 0.0f);
-				for (int32 GazeIdx = 0; GazeIdx < NumGazePointsSinceLastUpdate; GazeIdx++)
-				{
-					RawGazePoint.GazePointNormalized += FVector2D(GazePointsSinceLastUpdateSNorm[GazeIdx].X, GazePointsSinceLastUpdateSNorm[GazeIdx].Y);
-				}
-
-				RawGazePoint.TimeStamp = Now;
-				RawGazePoint.GazePointNormalized /= (float)NumGazePointsSinceLastUpdate;
-
-				//Convert to UNorm
-				RawGazePoint.GazePointNormalized.Set((RawGazePoint.GazePointNormalized.X + 1.0f) / 2.0f
-					, (-RawGazePoint.GazePointNormalized.Y + 1.0f) / 2.0f);
+				ConsumeMergedGazePoints(GazePointsSinceLastUpdateSNorm, NumGazePointsSinceLastUpdate, Now);
+			}
+			else
+			{
+				ConsumeGazePoints(GazePointsSinceLastUpdateSNorm, NumGazePointsSinceLastUpdate, Now);
 			}
 
-			//Get new head pose data
-			const HeadPose* HeadPosesSinceLastUpdate;
-			int NumHeadPosesSinceLastUpdate = StreamsProvider->GetHeadPoses(HeadPosesSinceLastUpdate);
+			//Get new head pose data. Only the tracker following the game window has head pose for it.
+			const HeadPose* HeadPosesSinceLastUpdate = nullptr;
+			int NumHeadPosesSinceLastUpdate = bIsGameWindowTrackerConnected ? StreamsProvider->GetHeadPoses(HeadPosesSinceLastUpdate) : 0;
 			if (NumHeadPosesSinceLastUpdate > 0)
 			{
 				RawHeadPose.HeadPositionCm.Set(0.0f, 0.0f, 0.0f);
@@ -427,7 +589,7 @@ void FTobiiEyeTracker::TickDesktop(float DeltaTime)
 			GazePointDeltaTimeMicroSecs = (uint64)FMath::Max((RawGazePoint.TimeStamp - PreviousRawGazePointTime).GetTotalMicroseconds(), 0.0);
 			CombinedGazeData.TimeStamp = RawGazePoint.TimeStamp;
 			FVector2D ScreenSpaceGazePointUNorm = ConvertRawGazePointUNormToGameViewportCoordinateUNorm(GEngine->GameViewport->GetGameViewport(), RawGazePoint.GazePointNormalized);
-			CombinedGazeData.ScreenGazePointPx.Set(ScreenSpaceGazePointUNorm.X * DisplayInfo.MainViewportWidthPx, ScreenSpaceGazePointUNorm.Y * DisplayInfo.MainViewportHeightPx);
+			CombinedGazeData.ScreenGazePointPx = ScreenSpaceGazePointUNorm * DisplayInfo.ViewportPxPerUNorm;
 
 			PreviousRawGazePointTime = RawGazePoint.TimeStamp;
 		}
@@ -438,10 +600,217 @@ void FTobiiEyeTracker::TickDesktop(float DeltaTime)
 		CombinedGazeData.ScreenGazeCircleRadiiPx.Y = FEyetrackingUtils::CalculateFovealRegionHeightPx(DisplayInfo.MainViewportHeightCm, DisplayInfo.MainViewportHeightPx, HeadPoseData.HeadLocation.Z, FovealRegionSizeDeg);
 		CombinedGazeData.ScreenGazeCircleRadiiPx.X = CombinedGazeData.ScreenGazeCircleRadiiPx.Y * AspectRatio;
 		CombinedGazeData.WorldGazeConeAngleDegrees = FovealRegionSizeDeg;
-		CombinedGazeData.EyeOpenness = 1.0f;
+		CombinedGazeData.EyeOpenness = bIsSyntheticGaze && SyntheticGaze.IsBlinking() ? 0.0f : 1.0f;
 	}
 }
 
+void FTobiiEyeTracker::ConsumeGazePoints(const GazePoint* GazePointsSNorm, int32 NumGazePoints, const FDateTime& Now)
+{
+	if (NumGazePoints <= 0)
+	{
+		return;
+	}
+
+	RawGazePoint.GazePointNormalized.Set(0.0f, 0.0f);
+	for (int32 GazeIdx = 0; GazeIdx < NumGazePoints; GazeIdx++)
+	{
+		RawGazePoint.GazePointNormalized += FVector2D(GazePointsSNorm[GazeIdx].X, GazePointsSNorm[GazeIdx].Y);
+	}
+
+	RawGazePoint.TimeStamp = Now;
+	RawGazePoint.GazePointNormalized /= (float)NumGazePoints;
+
+	//Convert to UNorm
+	RawGazePoint.GazePointNormalized.Set((RawGazePoint.GazePointNormalized.X + 1.0f) / 2.0f
+		, (-RawGazePoint.GazePointNormalized.Y + 1.0f) / 2.0f);
+
+	//The average above is all the rest of the tracker needs, but gaze events are classified per sample.
+	const double NowSecs = FPlatformTime::Seconds();
+	for (int32 GazeIdx = 0; GazeIdx < NumGazePoints; GazeIdx++)
+	{
+		GazeClock.AddObservation(GazePointsSNorm[GazeIdx].TimeStampMicroSeconds, NowSecs);
+	}
+	for (int32 GazeIdx = 0; GazeIdx < NumGazePoints; GazeIdx++)
+	{
+		const FVector2D GazePointUNorm((GazePointsSNorm[GazeIdx].X + 1.0f) / 2.0f, (-GazePointsSNorm[GazeIdx].Y + 1.0f) / 2.0f);
+		QueueDesktopGazeEventSample(GazeClock.ToPlatformSeconds(GazePointsSNorm[GazeIdx].TimeStampMicroSeconds), GazePointUNorm);
+	}
+}
+
+void FTobiiEyeTracker::QueueDesktopGazeEventSample(double PlatformSecs, const FVector2D& GazePointUNorm)
+{
+	const FVector2D ViewportGazePointUNorm = ConvertRawGazePointUNormToGameViewportCoordinateUNorm(GEngine->GameViewport->GetGameViewport(), GazePointUNorm);
+
+	//A desktop sample is only a point on the screen. The eyes rotate through the angle between the points as seen from the user's head, which the camera has no part in.
+	const float ViewingDistanceCm = HeadPoseData.HeadLocation.Z > 10.0f ? HeadPoseData.HeadLocation.Z : 60.0f;
+	FTobiiGazeEventSample& Sample = GazeEventSamples.AddDefaulted_GetRef();
+	Sample.PlatformSecs = PlatformSecs;
+	Sample.HeadGazeDirection = FVector(ViewingDistanceCm
+		, (ViewportGazePointUNorm.X - 0.5f) * DisplayInfo.MainViewportWidthCm
+		, (0.5f - ViewportGazePointUNorm.Y) * DisplayInfo.MainViewportHeightCm).GetSafeNormal();
+	Sample.ScreenGazePointPx = ViewportGazePointUNorm * DisplayInfo.ViewportPxPerUNorm;
+	Sample.bHasScreenGazePoint = true;
+}
+
+void FTobiiEyeTracker::UpdateTrackerStreams()
+{
+	if (!CVarTobiiMultiTracker.GetValueOnGameThread() || CVarEnableEyetrackingEmulation.GetValueOnGameThread())
+	{
+		TrackerStreams.Empty();
+		NextTrackerStreamUpdateSecs = 0.0;
+		return;
+	}
+
+	//Listing the trackers asks the runtime, so trackers being plugged in or displays being rearranged are only picked up every few seconds.
+	const double NowSecs = FPlatformTime::Seconds();
+	if (NowSecs < NextTrackerStreamUpdateSecs)
+	{
+		return;
+	}
+	NextTrackerStreamUpdateSecs = NowSecs + 3.0;
+
+	ITrackerController* TrackerController = TgiApi->GetTrackerController();
+	if (TrackerController == nullptr)
+	{
+		return;
+	}
+
+	TrackerController->UpdateTrackerInfos();
+	const TrackerInfo* TrackerInfos = nullptr;
+	int NumTrackerInfos = 0;
+	if (!TrackerController->GetTrackerInfos(TrackerInfos, NumTrackerInfos) || TrackerInfos == nullptr)
+	{
+		return;
+	}
+
+	TrackerInfo GameWindowTrackerInfo;
+	const FString GameWindowTrackerUrl = TrackerController->GetTrackerInfo(GameWindowTrackerInfo) && GameWindowTrackerInfo.Url != nullptr ? UTF8_TO_TCHAR(GameWindowTrackerInfo.Url) : FString();
+
+	TArray<const TrackerInfo*> OtherTrackerInfos;
+	for (int32 TrackerIdx = 0; TrackerIdx < NumTrackerInfos; TrackerIdx++)
+	{
+		const TrackerInfo& Info = TrackerInfos[TrackerIdx];
+		if (Info.IsAttached && Info.Type == TrackerType::PC && Info.Url != nullptr && GameWindowTrackerUrl != UTF8_TO_TCHAR(Info.Url))
+		{
+			OtherTrackerInfos.Add(&Info);
+		}
+	}
+
+	//Streams whose tracker went away or moved to another display are restarted below, if they are still around.
+	TrackerStreams.RemoveAll([&OtherTrackerInfos](const TUniquePtr<FTobiiTrackerStream>& TrackerStream)
+	{
+		return !OtherTrackerInfos.ContainsByPredicate([&TrackerStream](const TrackerInfo* Info)
+		{
+			return TrackerStream->GetUrl() == UTF8_TO_TCHAR(Info->Url) && TrackerStream->HasDisplayRect(Info->DisplayRectInOSCoordinates);
+		});
+	});
+
+	for (const TrackerInfo* Info : OtherTrackerInfos)
+	{
+		const FString Url = UTF8_TO_TCHAR(Info->Url);
+		if (TrackerStreams.ContainsByPredicate([&Url](const TUniquePtr<FTobiiTrackerStream>& TrackerStream) { return TrackerStream->GetUrl() == Url; }))
+		{
+			continue;
+		}
+
+		//A tracker controller only tracks one device, so every additional tracker needs its own API instance.
+		const FString ApiName = FString::Printf(TEXT("%s (%s)"), FApp::GetProjectName(), *Url);
+		ITobiiGameIntegrationApi* StreamTgiApi = GetApi(TCHAR_TO_ANSI(*ApiName));
+		if (StreamTgiApi == nullptr || StreamTgiApi == TgiApi)
+		{
+			if (!bHasWarnedAboutTrackerStreamApi)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Tobii: Could not get a separate game integration API instance for the tracker at %s. Only the tracker on the game window's display will be used."), *Url);
+				bHasWarnedAboutTrackerStreamApi = true;
+			}
+			continue;
+		}
+
+		const float PollIntervalSecs = 1.0f / FMath::Max(CVarTobiiMultiTrackerPollHz.GetValueOnGameThread(), 1.0f);
+		TrackerStreams.Emplace(MakeUnique<FTobiiTrackerStream>(StreamTgiApi, Url, Info->DisplayRectInOSCoordinates, PollIntervalSecs));
+	}
+}
+
+void FTobiiEyeTracker::ConsumeMergedGazePoints(const GazePoint* GazePointsSNorm, int32 NumGazePoints, const FDateTime& Now)
+{
+	//The game window tracker's samples go on the same platform clock as the streams'. The XR path uses this clock too, but never at the same time.
+	const double NowSecs = FPlatformTime::Seconds();
+	MergedGazeTimeline.Reset();
+	for (int32 GazeIdx = 0; GazeIdx < NumGazePoints; GazeIdx++)
+	{
+		GazeClock.AddObservation(GazePointsSNorm[GazeIdx].TimeStampMicroSeconds, NowSecs);
+	}
+	for (int32 GazeIdx = 0; GazeIdx < NumGazePoints; GazeIdx++)
+	{
+		FTobiiMergedGazeSample& Sample = MergedGazeTimeline.AddDefaulted_GetRef();
+		Sample.PlatformSecs = GazeClock.ToPlatformSeconds(GazePointsSNorm[GazeIdx].TimeStampMicroSeconds);
+		Sample.GazePointUNorm.Set((GazePointsSNorm[GazeIdx].X + 1.0f) / 2.0f, (-GazePointsSNorm[GazeIdx].Y + 1.0f) / 2.0f);
+		Sample.TrackerIdx = 0;
+	}
+
+	for (int32 StreamIdx = 0; StreamIdx < TrackerStreams.Num(); StreamIdx++)
+	{
+		TrackerStreamSamples.Reset();
+		TrackerStreams[StreamIdx]->DrainSamples(TrackerStreamSamples);
+		for (const FTobiiTrackerStreamSample& StreamSample : TrackerStreamSamples)
+		{
+			FTobiiMergedGazeSample Sample;
+			if (FTobiiPlatformSpecific::ConvertVirtualDesktopPixelToGazeCoordinate(DisplayInfo.GameWindowHandle, StreamSample.VirtualDesktopPx, Sample.GazePointUNorm))
+			{
+				Sample.PlatformSecs = StreamSample.PlatformSecs;
+				Sample.TrackerIdx = StreamIdx + 1;
+				MergedGazeTimeline.Add(Sample);
+			}
+		}
+	}
+
+	if (MergedGazeTimeline.Num() == 0)
+	{
+		return;
+	}
+
+	MergedGazeTimeline.StableSort([](const FTobiiMergedGazeSample& A, const FTobiiMergedGazeSample& B) { return A.PlatformSecs < B.PlatformSecs; });
+	for (const FTobiiMergedGazeSample& Sample : MergedGazeTimeline)
+	{
+		QueueDesktopGazeEventSample(Sample.PlatformSecs, Sample.GazePointUNorm);
+	}
+
+	//A tracker only sees gaze on its own display, so the samples since the timeline last switched tracker are the ones from where the user is looking now.
+	const int32 CurrentTrackerIdx = MergedGazeTimeline.Last().TrackerIdx;
+	FVector2D GazePointSumUNorm(0.0f, 0.0f);
+	int32 NumCurrentSamples = 0;
+	for (int32 SampleIdx = MergedGazeTimeline.Num() - 1; SampleIdx >= 0 && MergedGazeTimeline[SampleIdx].TrackerIdx == CurrentTrackerIdx; SampleIdx--)
+	{
+		GazePointSumUNorm += MergedGazeTimeline[SampleIdx].GazePointUNorm;
+		NumCurrentSamples++;
+	}
+
+	RawGazePoint.TimeStamp = Now;
+	RawGazePoint.GazePointNormalized = GazePointSumUNorm / (float)NumCurrentSamples;
+}
+
+void FTobiiEyeTracker::TickSyntheticGaze(float DeltaTime)
+{
+	FTobiiSyntheticGazeSettings Settings;
+	Settings.SampleRateHz = CVarSyntheticGazeSampleRateHz.GetValueOnGameThread();
+	Settings.Seed = CVarSyntheticGazeSeed.GetValueOnGameThread();
+	Settings.NoiseDeg = FMath::Max(CVarSyntheticGazeNoiseDeg.GetValueOnGameThread(), 0.0f);
+	Settings.BlinksPerMinute = FMath::Max(CVarSyntheticGazeBlinksPerMinute.GetValueOnGameThread(), 0.0f);
+	Settings.PursuitProbability = FMath::Clamp(CVarSyntheticGazePursuitProbability.GetValueOnGameThread(), 0.0f, 1.0f);
+	Settings.FieldWidthDeg = CVarSyntheticGazeFieldWidthDeg.GetValueOnGameThread();
+	Settings.FieldHeightDeg = Settings.FieldWidthDeg * DisplayInfo.MainViewportHeightPx / (float)FMath::Max(DisplayInfo.MainViewportWidthPx, 1);
+
+	//Compared with what was asked for last time rather than what the source clamped it to, or out of range values would restart it every tick.
+	if (!bSyntheticGazeStarted || Settings != SyntheticGazeSettings)
+	{
+		SyntheticGazeSettings = Settings;
+		SyntheticGaze.Reset(Settings);
+		bSyntheticGazeStarted = true;
+	}
+
+	SyntheticGaze.Tick(DeltaTime, SyntheticGazePoints);
+}
+
 void FTobiiEyeTracker::TickXR(float DeltaTime)
 {
 	//Pump API
@@ -473,17 +842,30 @@ void FTobiiEyeTracker::TickXR(float DeltaTime)
 	{
 		bool bNewGazeData = false;
 
-		if (bIsEmulating)
+		//Gaze samples are a few milliseconds old by the time we get them, so remember where the head and pawn were pointing since then.
+		FQuat CurrentHMDOrientation = FQuat::Identity;
+		FVector CurrentHMDPosition;
+		if (GEngine->XRSystem.IsValid())
 		{
-			FQuat HMDOrientation;
-			FVector HMDPosition;
-			GEngine->XRSystem->GetCurrentPose(IXRTrackingSystem::HMDDeviceId, HMDOrientation, HMDPosition);
+			GEngine->XRSystem->GetCurrentPose(IXRTrackingSystem::HMDDeviceId, CurrentHMDOrientation, CurrentHMDPosition);
+		}
+		const FQuat CurrentPawnOrientation = ActivePlayerController->GetPawn() != nullptr ? ActivePlayerController->GetPawn()->GetActorRotation().Quaternion() : FQuat::Identity;
+		const double NowSecs = FPlatformTime::Seconds();
+		HMDPoseHistory.Add(NowSecs, CurrentHMDOrientation, CurrentPawnOrientation);
 
+		if (bIsEmulating)
+		{
+			FQuat HMDOrientation = CurrentHMDOrientation;
 			FVector2D& GazeModifierUNorm = TickEmulatedGazePointUNorm(DeltaTime);
 			FVector2D GazeModifierSNorm((GazeModifierUNorm.X - 0.5f) * 2.0f, (GazeModifierUNorm.Y - 0.5f) * 2.0f);
 			HMDOrientation *= FQuat::MakeFromEuler(FVector(0.0f, -GazeModifierSNorm.Y * 90.0f, GazeModifierSNorm.X * 90.0f));
 			LeftGazeData.WorldGazeDirection = RightGazeData.WorldGazeDirection = HMDOrientation.GetForwardVector();
 
+			if (CVarTobiiApplyActorRotation.GetValueOnGameThread())
+			{
+				LeftGazeData.WorldGazeDirection = RightGazeData.WorldGazeDirection = CurrentPawnOrientation.RotateVector(LeftGazeData.WorldGazeDirection);
+			}
+
 			LeftGazeData.bIsGazeDataValid = RightGazeData.bIsGazeDataValid = true;
 			LeftGazeData.EyeOpenness = RightGazeData.EyeOpenness = 1.0f;
 			bNewGazeData = true;
@@ -491,55 +873,89 @@ void FTobiiEyeTracker::TickXR(float DeltaTime)
 		else
 		{
 			//Find direction and openness
-			//const HMDGaze* RawTobiiGazeData;
-			HMDGaze RawTobiiGazeData;
-			//int NumDataSinceLastUpdate = StreamsProvider->GetHMDGaze(RawTobiiGazeData);
-			int NumDataSinceLastUpdate = StreamsProvider->GetLatestHMDGaze(RawTobiiGazeData) ? 1 : 0;
-			if (NumDataSinceLastUpdate > 0)
+			const HMDGaze* RawTobiiGazeData = nullptr;
+			int NumDataSinceLastUpdate = StreamsProvider->GetHMDGaze(RawTobiiGazeData);
+			HMDGaze LatestTobiiGazeData;
+			if (NumDataSinceLastUpdate <= 0
+				&& StreamsProvider->GetLatestHMDGaze(LatestTobiiGazeData)
+				&& (int64)LatestTobiiGazeData.Timestamp != GazeDataTimeStampMicroSecs)
+			{
+				//Not every runtime buffers samples for us. The latest one will do then, as long as it is new. Timestamps start over when the runtime restarts, so any change counts.
+				RawTobiiGazeData = &LatestTobiiGazeData;
+				NumDataSinceLastUpdate = 1;
+			}
+
+			if (NumDataSinceLastUpdate > 0 && RawTobiiGazeData != nullptr)
 			{
-				const HMDGaze& LatestGazeData = RawTobiiGazeData;//[NumDataSinceLastUpdate - 1];
-				LeftGazeData.bIsGazeDataValid = (LatestGazeData.Validity & HMDValidityFlags::LeftEyeIsValid) == HMDValidityFlags::LeftEyeIsValid;
-				RightGazeData.bIsGazeDataValid = (LatestGazeData.Validity & HMDValidityFlags::RightEyeIsValid) == HMDValidityFlags::RightEyeIsValid;
+				for (int32 GazeIdx = 0; GazeIdx < NumDataSinceLastUpdate; GazeIdx++)
+				{
+					GazeClock.AddObservation(RawTobiiGazeData[GazeIdx].Timestamp, NowSecs);
+				}
 
-				LeftGazeData.WorldGazeDirection.Set(0.0f, 0.0f, 0.0f);
-				RightGazeData.WorldGazeDirection.Set(0.0f, 0.0f, 0.0f);
+				//Each sample is rotated with the pose from when it was captured before they are averaged. Rotating the average with the current pose smears gaze during head turns.
+				const bool bApplyHMDOrientation = CVarTobiiApplyHMDOrientation.GetValueOnGameThread() != 0;
+				const bool bApplyActorRotation = CVarTobiiApplyActorRotation.GetValueOnGameThread() != 0;
+				const double AdditionalLatencySecs = FMath::Max(CVarTobiiXRGazeAdditionalLatencyMs.GetValueOnGameThread(), 0.0f) / 1000.0;
+				FVector LeftDirectionSum = FVector::ZeroVector;
+				FVector RightDirectionSum = FVector::ZeroVector;
 				for (int32 GazeIdx = 0; GazeIdx < NumDataSinceLastUpdate; GazeIdx++)
 				{
-					const HMDGaze& GazeData = RawTobiiGazeData;// [GazeIdx];
-					LeftGazeData.WorldGazeDirection += FVector(GazeData.LeftEyeInfo.GazeDirection.Z, -GazeData.LeftEyeInfo.GazeDirection.X, GazeData.LeftEyeInfo.GazeDirection.Y);
-					RightGazeData.WorldGazeDirection += FVector(GazeData.RightEyeInfo.GazeDirection.Z, -GazeData.RightEyeInfo.GazeDirection.X, GazeData.RightEyeInfo.GazeDirection.Y);
+					const HMDGaze& GazeData = RawTobiiGazeData[GazeIdx];
+					const bool bIsLeftEyeValid = (GazeData.Validity & HMDValidityFlags::LeftEyeIsValid) == HMDValidityFlags::LeftEyeIsValid;
+					const bool bIsRightEyeValid = (GazeData.Validity & HMDValidityFlags::RightEyeIsValid) == HMDValidityFlags::RightEyeIsValid;
+
+					//The HMD reports gaze relative to itself, which is already what gaze events need.
+					FVector HeadGazeDirection = FVector::ZeroVector;
+					if (bIsLeftEyeValid)
+					{
+						HeadGazeDirection += FVector(GazeData.LeftEyeInfo.GazeDirection.Z, -GazeData.LeftEyeInfo.GazeDirection.X, GazeData.LeftEyeInfo.GazeDirection.Y);
+					}
+					if (bIsRightEyeValid)
+					{
+						HeadGazeDirection += FVector(GazeData.RightEyeInfo.GazeDirection.Z, -GazeData.RightEyeInfo.GazeDirection.X, GazeData.RightEyeInfo.GazeDirection.Y);
+					}
+					if (HeadGazeDirection.Normalize())
+					{
+						FTobiiGazeEventSample& EventSample = GazeEventSamples.AddDefaulted_GetRef();
+						EventSample.PlatformSecs = GazeClock.ToPlatformSeconds(GazeData.Timestamp);
+						EventSample.HeadGazeDirection = HeadGazeDirection;
+						EventSample.ScreenGazePointPx = FVector2D::ZeroVector;
+						EventSample.bHasScreenGazePoint = false;
+					}
+
+					FQuat HMDOrientation = CurrentHMDOrientation;
+					FQuat PawnOrientation = CurrentPawnOrientation;
+					HMDPoseHistory.Sample(GazeClock.ToPlatformSeconds(GazeData.Timestamp) - AdditionalLatencySecs, HMDOrientation, PawnOrientation);
+
+					FQuat ToWorld = bApplyActorRotation ? PawnOrientation : FQuat::Identity;
+					if (bApplyHMDOrientation)
+					{
+						ToWorld *= HMDOrientation;
+					}
+
+					if (bIsLeftEyeValid)
+					{
+						LeftDirectionSum += ToWorld.RotateVector(FVector(GazeData.LeftEyeInfo.GazeDirection.Z, -GazeData.LeftEyeInfo.GazeDirection.X, GazeData.LeftEyeInfo.GazeDirection.Y));
+					}
+					if (bIsRightEyeValid)
+					{
+						RightDirectionSum += ToWorld.RotateVector(FVector(GazeData.RightEyeInfo.GazeDirection.Z, -GazeData.RightEyeInfo.GazeDirection.X, GazeData.RightEyeInfo.GazeDirection.Y));
+					}
 				}
-				LeftGazeData.bIsGazeDataValid = LeftGazeData.bIsGazeDataValid && LeftGazeData.WorldGazeDirection.Normalize();
-				RightGazeData.bIsGazeDataValid = RightGazeData.bIsGazeDataValid && RightGazeData.WorldGazeDirection.Normalize();
 
+				LeftGazeData.WorldGazeDirection = LeftDirectionSum;
+				RightGazeData.WorldGazeDirection = RightDirectionSum;
+				LeftGazeData.bIsGazeDataValid = LeftGazeData.WorldGazeDirection.Normalize();
+				RightGazeData.bIsGazeDataValid = RightGazeData.WorldGazeDirection.Normalize();
+
+				const HMDGaze& LatestGazeData = RawTobiiGazeData[NumDataSinceLastUpdate - 1];
 				LeftGazeData.EyeOpenness = LatestGazeData.LeftEyeInfo.EyeOpenness;
 				RightGazeData.EyeOpenness = LatestGazeData.RightEyeInfo.EyeOpenness;
-				GazePointDeltaTimeMicroSecs = (int64)LatestGazeData.Timestamp - GazeDataTimeStampMicroSecs;
+				//No delta for the first sample or across a runtime restart, there is nothing to measure it against.
+				GazePointDeltaTimeMicroSecs = GazeDataTimeStampMicroSecs > 0 ? (uint64)FMath::Max((int64)LatestGazeData.Timestamp - GazeDataTimeStampMicroSecs, (int64)0) : 0;
 				GazeDataTimeStampMicroSecs = (int64)LatestGazeData.Timestamp;
 				bNewGazeData = true;
 			}
-
-			//Optionally correct orientation depending on project settings
-			{
-				if (CVarTobiiApplyHMDOrientation.GetValueOnGameThread())
-				{
-					FQuat HMDOrientation;
-					FVector HMDPosition;
-					GEngine->XRSystem->GetCurrentPose(IXRTrackingSystem::HMDDeviceId, HMDOrientation, HMDPosition);
-					LeftGazeData.WorldGazeDirection = HMDOrientation.RotateVector(LeftGazeData.WorldGazeDirection);
-					RightGazeData.WorldGazeDirection = HMDOrientation.RotateVector(RightGazeData.WorldGazeDirection);
-				}
-			}
-		}
-
-		if (CVarTobiiApplyActorRotation.GetValueOnGameThread()
-			&& ActivePlayerController.IsValid()
-			&& ActivePlayerController->GetPawn() != nullptr)
-		{
-			FQuat ActorRotation = ActivePlayerController->GetPawn()->GetActorRotation().Quaternion();
-
-			LeftGazeData.WorldGazeDirection = ActorRotation.RotateVector(LeftGazeData.WorldGazeDirection);
-			RightGazeData.WorldGazeDirection = ActorRotation.RotateVector(RightGazeData.WorldGazeDirection);
 		}
 
 		//Calculate combined data
@@ -632,46 +1048,79 @@ void FTobiiEyeTracker::UpdateWorldSpaceData(float DeltaTime)
 			RightGazeData.bIsGazeDataValid = false;
 		}
 
-		FCollisionQueryParams CollisionQueryParams;
-		CollisionQueryParams.AddIgnoredActor(ActivePlayerController.Get());
-		CollisionQueryParams.AddIgnoredActor(ActivePlayerController->GetPawn());
-		const float MaximumTraceDistance = FMath::Max(CVarTobiiMaximumTraceDistance.GetValueOnGameThread(), 0.0f);
-		const FVector CombinedGazeFarLocation = CombinedGazeData.WorldGazeOrigin + (CombinedGazeData.WorldGazeDirection * MaximumTraceDistance);
-		if (!CombinedGazeData.bIsGazeDataValid ||
-			!ActivePlayerController->GetWorld()->LineTraceSingleByChannel(CombinedWorldGazeHitData, CombinedGazeData.WorldGazeOrigin
-			, CombinedGazeFarLocation, (ECollisionChannel)CVarTobiiFocusTraceChannel.GetValueOnGameThread(), CollisionQueryParams))
+		EyeTraceWorld = ActivePlayerController->GetWorld();
+		EyeTraceQueryParams = FCollisionQueryParams();
+		EyeTraceQueryParams.AddIgnoredActor(ActivePlayerController.Get());
+		EyeTraceQueryParams.AddIgnoredActor(ActivePlayerController->GetPawn());
+		EyeTraceDistance = FMath::Max(CVarTobiiMaximumTraceDistance.GetValueOnGameThread(), 0.0f);
+		bLeftWorldGazeHitDataDirty = bRightWorldGazeHitDataDirty = true;
+
+		//In XR the eye rays cross where the user is looking. Knowing that depth, one short trace is enough to tell if something is in the way.
+		float CombinedTraceDistance = EyeTraceDistance;
+		CombinedGazeData.WorldFixationDepth = LeftGazeData.WorldFixationDepth = RightGazeData.WorldFixationDepth = 0.0f;
+		FVector FixationPoint;
+		if (bIsXR
+			&& CVarTobiiXRVergenceTrace.GetValueOnGameThread()
+			&& CombinedGazeData.bIsGazeDataValid && LeftGazeData.bIsGazeDataValid && RightGazeData.bIsGazeDataValid
+			&& EstimateVergenceFixationPoint(LeftGazeData, RightGazeData, CVarTobiiXRMinVergenceAngleDeg.GetValueOnGameThread(), FixationPoint))
 		{
-			CombinedWorldGazeHitData.Actor = nullptr;
-			CombinedWorldGazeHitData.Component = nullptr;
-			CombinedWorldGazeHitData.Distance = MaximumTraceDistance;
-			CombinedWorldGazeHitData.Location = CombinedGazeFarLocation;
-			CombinedWorldGazeHitData.bBlockingHit = false;
+			const float FixationDepth = FVector::DotProduct(FixationPoint - CombinedGazeData.WorldGazeOrigin, CombinedGazeData.WorldGazeDirection);
+			if (FixationDepth > 0.0f && FixationDepth < EyeTraceDistance)
+			{
+				CombinedGazeData.WorldFixationDepth = FixationDepth;
+				LeftGazeData.WorldFixationDepth = FVector::Dist(LeftGazeData.WorldGazeOrigin, FixationPoint);
+				RightGazeData.WorldFixationDepth = FVector::Dist(RightGazeData.WorldGazeOrigin, FixationPoint);
+				CombinedTraceDistance = FMath::Min(FixationDepth * (1.0f + FMath::Max(CVarTobiiXRVergenceTraceDepthMargin.GetValueOnGameThread(), 0.0f)), EyeTraceDistance);
+			}
 		}
 
-		const FVector LeftGazeFarLocation = LeftGazeData.WorldGazeOrigin + (LeftGazeData.WorldGazeDirection * MaximumTraceDistance);
-		if (!LeftGazeData.bIsGazeDataValid ||
-			!ActivePlayerController->GetWorld()->LineTraceSingleByChannel(LeftWorldGazeHitData, LeftGazeData.WorldGazeOrigin
-			, LeftGazeFarLocation, (ECollisionChannel)CVarTobiiFocusTraceChannel.GetValueOnGameThread(), CollisionQueryParams))
+		TraceWorldGaze(CombinedGazeData, CombinedTraceDistance, CombinedWorldGazeHitData);
+		if (!CombinedWorldGazeHitData.bBlockingHit && CombinedGazeData.WorldFixationDepth > 0.0f)
 		{
-			LeftWorldGazeHitData.Actor = nullptr;
-			LeftWorldGazeHitData.Component = nullptr;
-			LeftWorldGazeHitData.Distance = MaximumTraceDistance;
-			LeftWorldGazeHitData.Location = CombinedGazeFarLocation;
-			LeftWorldGazeHitData.bBlockingHit = false;
+			//Nothing in the way, so the user is looking at whatever is at the fixation point.
+			CombinedWorldGazeHitData.Distance = CombinedGazeData.WorldFixationDepth;
+			CombinedWorldGazeHitData.Location = CombinedGazeData.WorldGazeOrigin + (CombinedGazeData.WorldGazeDirection * CombinedGazeData.WorldFixationDepth);
 		}
+	}
+}
+
+void FTobiiEyeTracker::TraceWorldGaze(const FTobiiGazeData& GazeData, float TraceDistance, FHitResult& OutHitResult) const
+{
+	const FVector GazeFarLocation = GazeData.WorldGazeOrigin + (GazeData.WorldGazeDirection * TraceDistance);
+	if (!GazeData.bIsGazeDataValid
+		|| !EyeTraceWorld.IsValid()
+		|| !EyeTraceWorld->LineTraceSingleByChannel(OutHitResult, GazeData.WorldGazeOrigin
+		, GazeFarLocation, (ECollisionChannel)CVarTobiiFocusTraceChannel.GetValueOnGameThread(), EyeTraceQueryParams))
+	{
+		OutHitResult.Actor = nullptr;
+		OutHitResult.Component = nullptr;
+		OutHitResult.Distance = TraceDistance;
+		OutHitResult.Location = GazeFarLocation;
+		OutHitResult.bBlockingHit = false;
+	}
+}
+
+const FHitResult& FTobiiEyeTracker::GetLazyEyeWorldGazeHitData(const FTobiiGazeData& EyeGazeData, FHitResult& EyeHitData, bool& bEyeHitDataDirty) const
+{
+	if (bEyeHitDataDirty)
+	{
+		bEyeHitDataDirty = false;
 
-		const FVector RightGazeFarLocation = RightGazeData.WorldGazeOrigin + (RightGazeData.WorldGazeDirection * MaximumTraceDistance);
-		if (!RightGazeData.bIsGazeDataValid ||
-			!ActivePlayerController->GetWorld()->LineTraceSingleByChannel(RightWorldGazeHitData, RightGazeData.WorldGazeOrigin
-			, RightGazeFarLocation, (ECollisionChannel)CVarTobiiFocusTraceChannel.GetValueOnGameThread(), CollisionQueryParams))
+		//On desktop the eyes share the combined ray, and that one has already been traced.
+		if (EyeGazeData.WorldGazeOrigin.Equals(CombinedGazeData.WorldGazeOrigin)
+			&& EyeGazeData.WorldGazeDirection.Equals(CombinedGazeData.WorldGazeDirection)
+			&& EyeGazeData.bIsGazeDataValid == CombinedGazeData.bIsGazeDataValid
+			&& CombinedGazeData.WorldFixationDepth <= 0.0f)
+		{
+			EyeHitData = CombinedWorldGazeHitData;
+		}
+		else
 		{
-			RightWorldGazeHitData.Actor = nullptr;
-			RightWorldGazeHitData.Component = nullptr;
-			RightWorldGazeHitData.Distance = MaximumTraceDistance;
-			RightWorldGazeHitData.Location = CombinedGazeFarLocation;
-			RightWorldGazeHitData.bBlockingHit = false;
+			TraceWorldGaze(EyeGazeData, EyeTraceDistance, EyeHitData);
 		}
 	}
+
+	return EyeHitData;
 }
 
 void FTobiiEyeTracker::UpdateStabilityData(float DeltaTime)
@@ -719,6 +1168,68 @@ void FTobiiEyeTracker::SetEyeTrackedPlayer(APlayerController* PlayerController)
 /************************************************************************/
 /* IGazeTracker                                                         */
 /************************************************************************/
+void FTobiiEyeTracker::UpdateGazeEvents()
+{
+	FTobiiGazeEventSettings Settings;
+	Settings.SaccadeStartDegPerSec = FMath::Max(CVarGazeEventsSaccadeStartDegPerSec.GetValueOnGameThread(), 0.0f);
+	Settings.SaccadeEndDegPerSec = FMath::Min(FMath::Max(CVarGazeEventsSaccadeEndDegPerSec.GetValueOnGameThread(), 0.0f), Settings.SaccadeStartDegPerSec);
+	Settings.MinFixationSecs = FMath::Max(CVarGazeEventsMinFixationMs.GetValueOnGameThread(), 0.0f) / 1000.0f;
+	Settings.BlinkGapSecs = FMath::Max(CVarGazeEventsBlinkGapMs.GetValueOnGameThread(), 0.0f) / 1000.0f;
+
+	const double NowSecs = FPlatformTime::Seconds();
+	const FDateTime Now = FDateTime::UtcNow();
+	const bool bEyesClosed = !CombinedGazeData.bIsGazeDataValid || CombinedGazeData.EyeOpenness < 0.1f;
+	if (!bEyesClosed)
+	{
+		for (const FTobiiGazeEventSample& Sample : GazeEventSamples)
+		{
+			//The clock offset estimate can step back a little, a sample that seems to go back in time just has no velocity.
+			const double SampleDeltaSecs = LastGazeEventSampleSecs > 0.0 ? Sample.PlatformSecs - LastGazeEventSampleSecs : 0.0;
+			LastGazeEventSampleSecs = FMath::Max(LastGazeEventSampleSecs, Sample.PlatformSecs);
+
+			const FDateTime SampleTimeStamp = Now - FTimespan::FromSeconds(FMath::Max(NowSecs - Sample.PlatformSecs, 0.0));
+			const FVector2D& ScreenGazePointPx = Sample.bHasScreenGazePoint ? Sample.ScreenGazePointPx : CombinedGazeData.ScreenGazePointPx;
+			GazeEventClassifier.AddSample(Sample.PlatformSecs, SampleTimeStamp, SampleDeltaSecs, Sample.HeadGazeDirection, ScreenGazePointPx, Settings, PendingGazeEvents);
+		}
+
+		const int32 EmulationMode = CVarEnableEyetrackingEmulation.GetValueOnGameThread();
+		const bool bIsMouseEmulation = EmulationMode != 0 && (bIsXR || EmulationMode != 2);
+		if (bIsMouseEmulation && CombinedGazeData.TimeStamp != GazeEventSampleTimeStamp)
+		{
+			GazeEventSampleTimeStamp = CombinedGazeData.TimeStamp;
+
+			//Relative to the camera, which includes the HMD in XR, so looking around with the mouse or the head doesn't look like a saccade.
+			FVector HeadGazeDirection = CombinedGazeData.WorldGazeDirection;
+			if (ActivePlayerController.IsValid() && ActivePlayerController->PlayerCameraManager != nullptr)
+			{
+				HeadGazeDirection = ActivePlayerController->PlayerCameraManager->GetCameraRotation().UnrotateVector(HeadGazeDirection);
+			}
+
+			const double SampleDeltaSecs = LastGazeEventSampleSecs > 0.0 ? NowSecs - LastGazeEventSampleSecs : 0.0;
+			LastGazeEventSampleSecs = NowSecs;
+			GazeEventClassifier.AddSample(NowSecs, Now, SampleDeltaSecs, HeadGazeDirection, CombinedGazeData.ScreenGazePointPx, Settings, PendingGazeEvents);
+		}
+	}
+	GazeEventSamples.Reset();
+
+	GazeEventClassifier.UpdateBlink(NowSecs, Now, bEyesClosed, GazeTrackerStatus == ETobiiGazeTrackerStatus::UserPresent, Settings, PendingGazeEvents);
+	BroadcastGazeEvents();
+}
+
+void FTobiiEyeTracker::BroadcastGazeEvents()
+{
+	//A listener could make the tracker reset and add more events, so the array is swapped out first.
+	if (PendingGazeEvents.Num() > 0)
+	{
+		TArray<FTobiiGazeEvent, TInlineAllocator<4>> GazeEvents(PendingGazeEvents);
+		PendingGazeEvents.Reset();
+		for (const FTobiiGazeEvent& GazeEvent : GazeEvents)
+		{
+			GazeEventDelegate.Broadcast(GazeEvent);
+		}
+	}
+}
+
 const FTobiiGazeData& FTobiiEyeTracker::GetCombinedGazeData() const
 {
 	return CombinedGazeData;
@@ -763,12 +1274,12 @@ const FHitResult& FTobiiEyeTracker::GetCombinedWorldGazeHitData() const
 
 const FHitResult& FTobiiEyeTracker::GetLeftWorldGazeHitData() const
 {
-	return LeftWorldGazeHitData;
+	return GetLazyEyeWorldGazeHitData(LeftGazeData, LeftWorldGazeHitData, bLeftWorldGazeHitDataDirty);
 }
 
 const FHitResult& FTobiiEyeTracker::GetRightWorldGazeHitData() const
 {
-	return RightWorldGazeHitData;
+	return GetLazyEyeWorldGazeHitData(RightGazeData, RightWorldGazeHitData, bRightWorldGazeHitDataDirty);
 }
 
 const FTobiiDisplayInfo& FTobiiEyeTracker::GetDisplayInformation() const
@@ -776,6 +1287,16 @@ const FTobiiDisplayInfo& FTobiiEyeTracker::GetDisplayInformation() const
 	return DisplayInfo;
 }
 
+const FTobiiViewportTransform& FTobiiEyeTracker::GetViewportTransform() const
+{
+	return ViewportTransform;
+}
+
+TSharedPtr<FTobiiFoveationViewExtension, ESPMode::ThreadSafe> FTobiiEyeTracker::GetFoveationViewExtension() const
+{
+	return FoveationViewExtension;
+}
+
 const FTobiiDesktopTrackBox& FTobiiEyeTracker::GetDesktopTrackBox() const
 {
 	return DesktopTrackBox;
@@ -792,7 +1313,11 @@ const FRotator& FTobiiEyeTracker::GetInfiniteScreenAngles() const
 bool FTobiiEyeTracker::GetEyeTrackerGazeData(FEyeTrackerGazeData& OutGazeData) const
 {
 	OutGazeData.ConfidenceValue = CombinedGazeData.bIsGazeDataValid ? 1.0f : 0.0f;
-	OutGazeData.FixationPoint = FVector::ZeroVector; //This data is not useful for a game designer as it is not reliable enough, so we don't supply it.
+	OutGazeData.FixationPoint = FVector::ZeroVector; //This data is not useful for a game designer as it is not reliable enough, so we only supply it when the vergence trace asks for it.
+	if (CombinedGazeData.WorldFixationDepth > 0.0f)
+	{
+		OutGazeData.FixationPoint = CombinedGazeData.WorldGazeOrigin + (CombinedGazeData.WorldGazeDirection * CombinedGazeData.WorldFixationDepth);
+	}
 	OutGazeData.GazeOrigin = CombinedGazeData.WorldGazeOrigin;
 	OutGazeData.GazeDirection = CombinedGazeData.WorldGazeDirection;
 
@@ -829,13 +1354,10 @@ FVector2D FTobiiEyeTracker::ConvertRawGazePointUNormToGameViewportCoordinateUNor
 #if WITH_EDITOR
 	//We need this to make sure we get a correct gaze point if the editor has tool windows attached to the window itself.
 	FIntPoint VirtualDesktopPixelCoord;
-	if (FTobiiPlatformSpecific::ConvertGazeCoordinateToVirtualDesktopPixel(DisplayInfo.GameWindowHandle, InNormalizedPoint, VirtualDesktopPixelCoord))
+	if (ViewportTransform.bHasVirtualDesktop
+		&& FTobiiPlatformSpecific::ConvertGazeCoordinateToVirtualDesktopPixel(DisplayInfo.GameWindowHandle, InNormalizedPoint, VirtualDesktopPixelCoord))
 	{
-		FVector2D ViewportPixelCoordUNorm;
-		if (UTobiiBlueprintLibrary::VirtualDesktopPixelToViewportCoordinateUNorm(VirtualDesktopPixelCoord, ViewportPixelCoordUNorm))
-		{
-			return ViewportPixelCoordUNorm;
-		}
+		return ViewportTransform.Convert(ETobiiCoordinateSpace::VirtualDesktopPixel, ETobiiCoordinateSpace::ViewportUNorm, FVector2D(VirtualDesktopPixelCoord.X, VirtualDesktopPixelCoord.Y));
 	}
 #endif
 
@@ -11,10 +11,15 @@
 #include "ITobiiEyeTracker.h"
 #include "TobiiPlatformSpecific.h"
 #include "TobiiInternalTypes.h"
+#include "TobiiFoveatedRendering.h"
+#include "TobiiSyntheticGaze.h"
+#include "TobiiGazeEvents.h"
+#include "TobiiTrackerStream.h"
 #include "tobii_gameintegration.h"
 
 #include "CoreMinimal.h"
 #include "Containers/Ticker.h"
+#include "CollisionQueryParams.h"
 #include "GameFramework/PlayerController.h"
 #include "Slate/SceneViewport.h"
 
@@ -51,6 +56,9 @@ public:
 	virtual const FHitResult& GetLeftWorldGazeHitData() const override;
 	virtual const FHitResult& GetRightWorldGazeHitData() const override;
 	virtual const FTobiiDisplayInfo& GetDisplayInformation() const override;
+	virtual const FTobiiViewportTransform& GetViewportTransform() const override;
+	virtual TSharedPtr<FTobiiFoveationViewExtension, ESPMode::ThreadSafe> GetFoveationViewExtension() const override;
+	virtual FTobiiGazeEventDelegate& OnGazeEvent() override { return GazeEventDelegate; }
 	virtual const FTobiiHeadPoseData& GetHeadPoseData() const override;
 	virtual const FTobiiDesktopTrackBox& GetDesktopTrackBox() const override;
 	virtual const FRotator& GetInfiniteScreenAngles() const override;
@@ -68,21 +76,61 @@ private:
 	TWeakObjectPtr<APlayerController> ActivePlayerController;
 
 	FHitResult CombinedWorldGazeHitData;
-	FHitResult LeftWorldGazeHitData;
-	FHitResult RightWorldGazeHitData;
+
+	//The per eye traces are only done when someone asks for them. These are the inputs they need, captured in UpdateWorldSpaceData.
+	mutable FHitResult LeftWorldGazeHitData;
+	mutable FHitResult RightWorldGazeHitData;
+	mutable bool bLeftWorldGazeHitDataDirty;
+	mutable bool bRightWorldGazeHitDataDirty;
+	TWeakObjectPtr<UWorld> EyeTraceWorld;
+	FCollisionQueryParams EyeTraceQueryParams;
+	float EyeTraceDistance;
 	FTobiiGazeData LeftGazeData;
 	FTobiiGazeData RightGazeData;
 	FTobiiGazeData CombinedGazeData;
 	ETobiiGazeTrackerStatus GazeTrackerStatus;
 	FTobiiHeadPoseData HeadPoseData;
 	FTobiiDisplayInfo DisplayInfo;
+	FTobiiViewportTransform ViewportTransform;
 	FRotator InfiniteScreenAngles;
 	FTobiiDesktopTrackBox DesktopTrackBox;
 
 	FTobiiRawGazePoint RawGazePoint;
 	FTobiiRawHeadPose RawHeadPose;
+	FTobiiTrackerClock GazeClock;
+	FTobiiPoseHistory HMDPoseHistory;
 	FVector PrevCombinedGazeDirection;
 
+	//The display info only changes on window, viewport, DPI or tracker changes, so it is refreshed when one of those is noticed instead of every tick.
+	bool bDisplayInfoDirty;
+	bool bDisplayInfoTrackerConnected;
+	const FViewport* DisplayInfoViewport;
+	FDelegateHandle ViewportResizedHandle;
+
+	TSharedPtr<FTobiiFoveationViewExtension, ESPMode::ThreadSafe> FoveationViewExtension;
+
+	FTobiiSyntheticGazeSource SyntheticGaze;
+	FTobiiSyntheticGazeSettings SyntheticGazeSettings;
+	TArray<TobiiGameIntegration::GazePoint> SyntheticGazePoints;
+	bool bSyntheticGazeStarted;
+
+	//Trackers on other displays than the game window's, when tobii.desktop.MultiTracker is on.
+	TArray<TUniquePtr<FTobiiTrackerStream>> TrackerStreams;
+	TArray<FTobiiTrackerStreamSample> TrackerStreamSamples;
+	TArray<FTobiiMergedGazeSample> MergedGazeTimeline;
+	double NextTrackerStreamUpdateSecs;
+	bool bHasWarnedAboutTrackerStreamApi;
+
+	FTobiiGazeEventDelegate GazeEventDelegate;
+	FTobiiGazeEventClassifier GazeEventClassifier;
+	TArray<FTobiiGazeEvent> PendingGazeEvents;
+	//Every sample the tracker delivered since the last classification, so saccades are measured at the tracker's rate and not the frame rate.
+	TArray<FTobiiGazeEventSample> GazeEventSamples;
+	double LastGazeEventSampleSecs;
+	//Mouse emulation has no samples of its own, its gaze is classified once per frame.
+	FDateTime GazeEventSampleTimeStamp;
+	bool bGazeClockFollowsSyntheticGaze;
+
 	bool bIsXR;
 	int64 GazeDataTimeStampMicroSecs;
 	uint64 GazePointDeltaTimeMicroSecs;
@@ -91,10 +139,21 @@ private:
 
 	void ResetData();
 	bool UpdateLowLevelResources();
+	void OnViewportResized(FViewport* Viewport, uint32 Unused);
+	void UpdateViewportTransform();
 	void TickDesktop(float DeltaTime);
 	void TickXR(float DeltaTime);
+	void ConsumeGazePoints(const TobiiGameIntegration::GazePoint* GazePointsSNorm, int32 NumGazePoints, const FDateTime& Now);
+	void QueueDesktopGazeEventSample(double PlatformSecs, const FVector2D& GazePointUNorm);
+	void UpdateTrackerStreams();
+	void ConsumeMergedGazePoints(const TobiiGameIntegration::GazePoint* GazePointsSNorm, int32 NumGazePoints, const FDateTime& Now);
+	void TickSyntheticGaze(float DeltaTime);
 	void UpdateWorldSpaceData(float DeltaTime);
 	void UpdateStabilityData(float DeltaTime);
+	void UpdateGazeEvents();
+	void BroadcastGazeEvents();
+	void TraceWorldGaze(const FTobiiGazeData& GazeData, float TraceDistance, FHitResult& OutHitResult) const;
+	const FHitResult& GetLazyEyeWorldGazeHitData(const FTobiiGazeData& EyeGazeData, FHitResult& EyeHitData, bool& bEyeHitDataDirty) const;
 
 	FVector2D ConvertRawGazePointUNormToGameViewportCoordinateUNorm(FSceneViewport* GameViewport, const FVector2D& InNormalizedPoint);
 
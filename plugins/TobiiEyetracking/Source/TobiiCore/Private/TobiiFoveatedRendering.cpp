@@ -0,0 +1,183 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#include "TobiiFoveatedRendering.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "RenderingThread.h"
+#include "SceneView.h"
+#include "HAL/PlatformTime.h"
+
+static TAutoConsoleVariable<int32> CVarTobiiFoveationEnable(TEXT("tobii.foveation.Enable"), 0, TEXT("0 - Gaze is not handed to the renderer. 1 - The predicted gaze and foveal region are published to the render thread every frame, and the game view's screen percentage follows the tobii.foveation screen percentage CVars."));
+static TAutoConsoleVariable<float> CVarTobiiFoveationPredictionMs(TEXT("tobii.foveation.PredictionMs"), 25.0f, TEXT("How far ahead of the game thread the frame is expected to reach the screen. The gaze point is extrapolated this far while the eyes are moving, and the foveal region is widened by the distance covered, since a saccade rarely ends where a straight line says it will."));
+static TAutoConsoleVariable<float> CVarTobiiFoveationMaxExtrapolationMs(TEXT("tobii.foveation.MaxExtrapolationMs"), 50.0f, TEXT("The gaze is never extrapolated further than this from its sample. Saccades last 20 to 100 ms, so further than this the prediction is mostly wrong."));
+static TAutoConsoleVariable<float> CVarTobiiFoveationMaxGazeAgeMs(TEXT("tobii.foveation.MaxGazeAgeMs"), 150.0f, TEXT("Gaze older than this is considered lost. The foveal region is then marked invalid and the screen percentage is left alone."));
+static TAutoConsoleVariable<float> CVarTobiiFoveationAwayScreenPercentage(TEXT("tobii.foveation.AwayScreenPercentage"), 50.0f, TEXT("The screen percentage, relative to the view's own, used while the tracker reports that no one is looking at the screen. 100 turns this off."));
+static TAutoConsoleVariable<float> CVarTobiiFoveationSaccadeScreenPercentage(TEXT("tobii.foveation.SaccadeScreenPercentage"), 100.0f, TEXT("The screen percentage, relative to the view's own, used during saccades and blinks. Vision is mostly suppressed during both, but a single frame at lower resolution can still be noticed with temporal AA, so this is off (100) by default."));
+
+FTobiiFoveationViewExtension::FTobiiFoveationViewExtension(const FAutoRegister& AutoRegister)
+	: FSceneViewExtensionBase(AutoRegister)
+	, GameThreadFrameIdx(0)
+	, RenderThreadFrameIdx(0)
+	, LastBuiltFrameNumber(0)
+	, GazePointUNorm(0.5f, 0.5f)
+	, PrevGazePointUNorm(0.5f, 0.5f)
+	, GazeSampleSecs(0.0)
+	, PrevGazeSampleSecs(0.0)
+	, GazeRadiiUNorm(0.0f, 0.0f)
+	, bIsGazeValid(false)
+	, bIsFixating(false)
+	, bIsUserPresent(true)
+	, LastSetGazeSecs(0.0)
+{
+}
+
+void FTobiiFoveationViewExtension::SetGaze(const FTobiiGazeData& CombinedGazeData, const FTobiiDisplayInfo& DisplayInfo, bool bInIsUserPresent)
+{
+	check(IsInGameThread());
+
+	const double Now = FPlatformTime::Seconds();
+	LastSetGazeSecs = Now;
+	bIsUserPresent = bInIsUserPresent;
+
+	if (!CombinedGazeData.bIsGazeDataValid || !DisplayInfo.HasViewportPx())
+	{
+		bIsGazeValid = false;
+		return;
+	}
+
+	//Same sample as last tick
+	if (bIsGazeValid && CombinedGazeData.TimeStamp == GazeTimeStamp)
+	{
+		return;
+	}
+
+	const double SampleAgeSecs = FMath::Max((FDateTime::UtcNow() - CombinedGazeData.TimeStamp).GetTotalSeconds(), 0.0);
+	const FVector2D NewGazePointUNorm = CombinedGazeData.ScreenGazePointPx * DisplayInfo.ViewportUNormPerPx;
+
+	//No velocity across a blink or tracking loss.
+	if (bIsGazeValid)
+	{
+		PrevGazePointUNorm = GazePointUNorm;
+		PrevGazeSampleSecs = GazeSampleSecs;
+	}
+	else
+	{
+		PrevGazePointUNorm = NewGazePointUNorm;
+		PrevGazeSampleSecs = Now - SampleAgeSecs;
+	}
+
+	GazeTimeStamp = CombinedGazeData.TimeStamp;
+	GazePointUNorm = NewGazePointUNorm;
+	GazeSampleSecs = Now - SampleAgeSecs;
+	GazeRadiiUNorm = CombinedGazeData.ScreenGazeCircleRadiiPx * DisplayInfo.ViewportUNormPerPx;
+	bIsFixating = CombinedGazeData.bIsStable;
+	bIsGazeValid = true;
+}
+
+const FTobiiFoveationFrame& FTobiiFoveationViewExtension::GetFoveationFrame_RenderThread() const
+{
+	check(IsInRenderingThread());
+	return Frames[RenderThreadFrameIdx];
+}
+
+const FTobiiFoveationFrame& FTobiiFoveationViewExtension::GetFoveationFrame_GameThread() const
+{
+	check(IsInGameThread());
+	return Frames[GameThreadFrameIdx];
+}
+
+void FTobiiFoveationViewExtension::BuildFrame(FTobiiFoveationFrame& OutFrame) const
+{
+	const double Now = FPlatformTime::Seconds();
+	const double MaxGazeAgeSecs = CVarTobiiFoveationMaxGazeAgeMs.GetValueOnGameThread() / 1000.0;
+	const bool bIsTrackerFresh = (Now - LastSetGazeSecs) <= MaxGazeAgeSecs;
+
+	OutFrame = FTobiiFoveationFrame();
+	OutFrame.FrameNumber = GFrameNumber;
+	OutFrame.bIsGazeValid = bIsTrackerFresh && bIsGazeValid && (Now - GazeSampleSecs) <= MaxGazeAgeSecs;
+	OutFrame.bIsFixating = OutFrame.bIsGazeValid && bIsFixating;
+
+	if (OutFrame.bIsGazeValid)
+	{
+		OutFrame.PredictedGazePointUNorm = GazePointUNorm;
+		OutFrame.FovealRadiiUNorm = GazeRadiiUNorm;
+
+		//Fixation noise extrapolates into jitter, so only moving eyes are predicted.
+		const double SampleDeltaSecs = GazeSampleSecs - PrevGazeSampleSecs;
+		if (!bIsFixating && SampleDeltaSecs > SMALL_NUMBER)
+		{
+			const double DisplaySecs = Now + CVarTobiiFoveationPredictionMs.GetValueOnGameThread() / 1000.0;
+			const double MaxExtrapolationSecs = CVarTobiiFoveationMaxExtrapolationMs.GetValueOnGameThread() / 1000.0;
+			const float ExtrapolationSecs = (float)FMath::Clamp(DisplaySecs - GazeSampleSecs, 0.0, FMath::Max(MaxExtrapolationSecs, 0.0));
+			const FVector2D VelocityUNormPerSec = (GazePointUNorm - PrevGazePointUNorm) / (float)SampleDeltaSecs;
+			const FVector2D Extrapolation = VelocityUNormPerSec * ExtrapolationSecs;
+
+			OutFrame.PredictedGazePointUNorm = GazePointUNorm + Extrapolation;
+			OutFrame.PredictedGazePointUNorm.X = FMath::Clamp(OutFrame.PredictedGazePointUNorm.X, 0.0f, 1.0f);
+			OutFrame.PredictedGazePointUNorm.Y = FMath::Clamp(OutFrame.PredictedGazePointUNorm.Y, 0.0f, 1.0f);
+			OutFrame.FovealRadiiUNorm += Extrapolation.GetAbs();
+		}
+	}
+
+	//Presence is only trusted while the tracker keeps reporting it, a stale "away" must not keep the resolution down.
+	float ScreenPercentage = 100.0f;
+	if (bIsTrackerFresh && !bIsUserPresent)
+	{
+		ScreenPercentage = CVarTobiiFoveationAwayScreenPercentage.GetValueOnGameThread();
+	}
+	else if (bIsTrackerFresh && !OutFrame.bIsFixating)
+	{
+		ScreenPercentage = CVarTobiiFoveationSaccadeScreenPercentage.GetValueOnGameThread();
+	}
+	OutFrame.ScreenPercentageScale = FMath::Clamp(ScreenPercentage, 10.0f, 100.0f) / 100.0f;
+}
+
+void FTobiiFoveationViewExtension::SetupViewFamily(FSceneViewFamily& InViewFamily)
+{
+	//Split screen and stereo render several views, but they all share one frame of gaze.
+	if (LastBuiltFrameNumber == GFrameNumber)
+	{
+		return;
+	}
+
+	//The render thread reads the slot published last frame, at most, so the one after the current one is free.
+	LastBuiltFrameNumber = GFrameNumber;
+	GameThreadFrameIdx = (GameThreadFrameIdx + 1) % NumFrames;
+	BuildFrame(Frames[GameThreadFrameIdx]);
+}
+
+void FTobiiFoveationViewExtension::SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView)
+{
+	//The game viewport's screen percentage driver reads this after the views are set up.
+	const FTobiiFoveationFrame& Frame = Frames[GameThreadFrameIdx];
+	if (Frame.ScreenPercentageScale < 1.0f)
+	{
+		InView.FinalPostProcessSettings.ScreenPercentage *= Frame.ScreenPercentageScale;
+	}
+}
+
+void FTobiiFoveationViewExtension::BeginRenderViewFamily(FSceneViewFamily& InViewFamily)
+{
+	TSharedRef<FTobiiFoveationViewExtension, ESPMode::ThreadSafe> Extension = StaticCastSharedRef<FTobiiFoveationViewExtension>(AsShared());
+	const int32 FrameIdx = GameThreadFrameIdx;
+	ENQUEUE_RENDER_COMMAND(TobiiPublishFoveationFrame)(
+		[Extension, FrameIdx](FRHICommandListImmediate& RHICmdList)
+		{
+			Extension->RenderThreadFrameIdx = FrameIdx;
+		});
+}
+
+bool FTobiiFoveationViewExtension::IsActiveThisFrame(FViewport* InViewport) const
+{
+	//Scene captures and editor viewports don't follow the user's eyes.
+	return CVarTobiiFoveationEnable.GetValueOnGameThread() != 0
+		&& InViewport != nullptr
+		&& GEngine != nullptr
+		&& GEngine->GameViewport != nullptr
+		&& GEngine->GameViewport->Viewport == InViewport;
+}
@@ -0,0 +1,94 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#include "TobiiGazeEventComponent.h"
+#include "ITobiiCore.h"
+
+UTobiiGazeEventComponent::UTobiiGazeEventComponent()
+{
+	//Only ticks until the eye tracker is there to bind to.
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+}
+
+void UTobiiGazeEventComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!BindToEyeTracker())
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UTobiiGazeEventComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnbindFromEyeTracker();
+	Super::EndPlay(EndPlayReason);
+}
+
+void UTobiiGazeEventComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (BindToEyeTracker())
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+bool UTobiiGazeEventComponent::BindToEyeTracker()
+{
+	TSharedPtr<ITobiiEyeTracker, ESPMode::ThreadSafe> EyeTracker = ITobiiCore::GetEyeTracker();
+	if (!EyeTracker.IsValid())
+	{
+		return false;
+	}
+
+	UnbindFromEyeTracker();
+	GazeEventHandle = EyeTracker->OnGazeEvent().AddUObject(this, &UTobiiGazeEventComponent::HandleGazeEvent);
+	BoundEyeTracker = EyeTracker;
+	return true;
+}
+
+void UTobiiGazeEventComponent::UnbindFromEyeTracker()
+{
+	TSharedPtr<ITobiiEyeTracker, ESPMode::ThreadSafe> EyeTracker = BoundEyeTracker.Pin();
+	if (EyeTracker.IsValid())
+	{
+		EyeTracker->OnGazeEvent().Remove(GazeEventHandle);
+	}
+
+	BoundEyeTracker.Reset();
+	GazeEventHandle.Reset();
+}
+
+void UTobiiGazeEventComponent::HandleGazeEvent(const FTobiiGazeEvent& GazeEvent)
+{
+	OnGazeEvent.Broadcast(GazeEvent);
+
+	switch (GazeEvent.EventType)
+	{
+	case ETobiiGazeEventType::FixationStart:
+		OnFixationStarted.Broadcast(GazeEvent);
+		break;
+	case ETobiiGazeEventType::FixationEnd:
+		OnFixationEnded.Broadcast(GazeEvent);
+		break;
+	case ETobiiGazeEventType::SaccadeStart:
+		OnSaccadeStarted.Broadcast(GazeEvent);
+		break;
+	case ETobiiGazeEventType::SaccadeEnd:
+		OnSaccadeEnded.Broadcast(GazeEvent);
+		break;
+	case ETobiiGazeEventType::BlinkStart:
+		OnBlinkStarted.Broadcast(GazeEvent);
+		break;
+	case ETobiiGazeEventType::BlinkEnd:
+		OnBlinkEnded.Broadcast(GazeEvent);
+		break;
+	}
+}
@@ -0,0 +1,172 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#include "TobiiGazeEvents.h"
+
+FTobiiGazeEventClassifier::FTobiiGazeEventClassifier()
+	: State(EState::None)
+	, StateStartSecs(0.0)
+	, StateStartTimeStamp()
+	, bHasPrevSample(false)
+	, PrevGazeDirection(FVector::ForwardVector)
+	, LastSampleSecs(0.0)
+	, LastScreenGazePointPx(0.0f, 0.0f)
+	, FixationSumPx(0.0f, 0.0f)
+	, NumFixationSamples(0)
+	, SaccadeStartDirection(FVector::ForwardVector)
+	, SaccadePeakDegPerSec(0.0f)
+{
+}
+
+void FTobiiGazeEventClassifier::Reset(double NowSecs, const FDateTime& Now, TArray<FTobiiGazeEvent>& OutEvents)
+{
+	EndOpenEvent(NowSecs, Now, OutEvents);
+	State = EState::None;
+	bHasPrevSample = false;
+}
+
+void FTobiiGazeEventClassifier::AddSample(double NowSecs, const FDateTime& Now, double SampleDeltaSecs, const FVector& HeadGazeDirection, const FVector2D& ScreenGazePointPx, const FTobiiGazeEventSettings& Settings, TArray<FTobiiGazeEvent>& OutEvents)
+{
+	if (State == EState::Blink)
+	{
+		EndOpenEvent(NowSecs, Now, OutEvents);
+		State = EState::None;
+		bHasPrevSample = false;
+	}
+
+	const FVector PrevDirection = PrevGazeDirection;
+	const FVector2D PrevScreenGazePointPx = LastScreenGazePointPx;
+	const bool bHasVelocity = bHasPrevSample && SampleDeltaSecs > 0.0;
+	const float SpeedDegPerSec = bHasVelocity ? AngleBetweenDeg(PrevDirection, HeadGazeDirection) / (float)SampleDeltaSecs : 0.0f;
+
+	bHasPrevSample = true;
+	PrevGazeDirection = HeadGazeDirection;
+	LastSampleSecs = NowSecs;
+	LastScreenGazePointPx = ScreenGazePointPx;
+
+	if (State == EState::Saccade)
+	{
+		SaccadePeakDegPerSec = FMath::Max(SaccadePeakDegPerSec, SpeedDegPerSec);
+		if (SpeedDegPerSec < Settings.SaccadeEndDegPerSec)
+		{
+			EndOpenEvent(NowSecs, Now, OutEvents);
+			BeginState(EState::FixationCandidate, NowSecs, Now);
+			FixationSumPx = ScreenGazePointPx;
+			NumFixationSamples = 1;
+		}
+		return;
+	}
+
+	if (bHasVelocity && SpeedDegPerSec >= Settings.SaccadeStartDegPerSec)
+	{
+		//The saccade started at the previous sample, which is the last one that was still at rest.
+		EndOpenEvent(NowSecs, Now, OutEvents);
+		BeginState(EState::Saccade, NowSecs - SampleDeltaSecs, Now - FTimespan::FromSeconds(SampleDeltaSecs));
+		SaccadeStartDirection = PrevDirection;
+		SaccadePeakDegPerSec = SpeedDegPerSec;
+		AddEvent(ETobiiGazeEventType::SaccadeStart, StateStartTimeStamp, PrevScreenGazePointPx, OutEvents);
+		return;
+	}
+
+	if (State == EState::None)
+	{
+		BeginState(EState::FixationCandidate, NowSecs, Now);
+		FixationSumPx = FVector2D::ZeroVector;
+		NumFixationSamples = 0;
+	}
+
+	FixationSumPx += ScreenGazePointPx;
+	NumFixationSamples++;
+
+	if (State == EState::FixationCandidate && NowSecs - StateStartSecs >= Settings.MinFixationSecs)
+	{
+		State = EState::Fixation;
+		AddEvent(ETobiiGazeEventType::FixationStart, StateStartTimeStamp, GetFixationCenterPx(), OutEvents);
+	}
+}
+
+void FTobiiGazeEventClassifier::UpdateBlink(double NowSecs, const FDateTime& Now, bool bEyesClosed, bool bIsUserPresent, const FTobiiGazeEventSettings& Settings, TArray<FTobiiGazeEvent>& OutEvents)
+{
+	//Nothing to interrupt before the first sample, and a user that isn't there can't blink.
+	if (State == EState::Blink || !bHasPrevSample || !bIsUserPresent)
+	{
+		return;
+	}
+
+	const double SecsSinceLastSample = NowSecs - LastSampleSecs;
+	if (!bEyesClosed && SecsSinceLastSample <= Settings.BlinkGapSecs)
+	{
+		return;
+	}
+
+	//The eyes closed somewhere after the last sample. That is the best guess there is for when.
+	const double BlinkStartSecs = bEyesClosed ? NowSecs : LastSampleSecs;
+	const FDateTime BlinkStartTimeStamp = bEyesClosed ? Now : Now - FTimespan::FromSeconds(SecsSinceLastSample);
+	EndOpenEvent(BlinkStartSecs, BlinkStartTimeStamp, OutEvents);
+	BeginState(EState::Blink, BlinkStartSecs, BlinkStartTimeStamp);
+	AddEvent(ETobiiGazeEventType::BlinkStart, BlinkStartTimeStamp, LastScreenGazePointPx, OutEvents);
+}
+
+void FTobiiGazeEventClassifier::BeginState(EState NewState, double StartSecs, const FDateTime& StartTimeStamp)
+{
+	State = NewState;
+	StateStartSecs = StartSecs;
+	StateStartTimeStamp = StartTimeStamp;
+}
+
+void FTobiiGazeEventClassifier::EndOpenEvent(double NowSecs, const FDateTime& Now, TArray<FTobiiGazeEvent>& OutEvents)
+{
+	const float DurationSecs = (float)FMath::Max(NowSecs - StateStartSecs, 0.0);
+	switch (State)
+	{
+	case EState::Fixation:
+	{
+		FTobiiGazeEvent& Event = AddEvent(ETobiiGazeEventType::FixationEnd, Now, GetFixationCenterPx(), OutEvents);
+		Event.DurationSecs = DurationSecs;
+		break;
+	}
+
+	case EState::Saccade:
+	{
+		FTobiiGazeEvent& Event = AddEvent(ETobiiGazeEventType::SaccadeEnd, Now, LastScreenGazePointPx, OutEvents);
+		Event.DurationSecs = DurationSecs;
+		Event.AmplitudeDegrees = AngleBetweenDeg(SaccadeStartDirection, PrevGazeDirection);
+		Event.PeakVelocityDegPerSec = SaccadePeakDegPerSec;
+		break;
+	}
+
+	case EState::Blink:
+	{
+		FTobiiGazeEvent& Event = AddEvent(ETobiiGazeEventType::BlinkEnd, Now, LastScreenGazePointPx, OutEvents);
+		Event.DurationSecs = DurationSecs;
+		break;
+	}
+
+	default:
+		break;
+	}
+
+	State = EState::None;
+}
+
+FTobiiGazeEvent& FTobiiGazeEventClassifier::AddEvent(ETobiiGazeEventType EventType, const FDateTime& TimeStamp, const FVector2D& ScreenGazePointPx, TArray<FTobiiGazeEvent>& OutEvents) const
+{
+	FTobiiGazeEvent& Event = OutEvents.AddDefaulted_GetRef();
+	Event.EventType = EventType;
+	Event.TimeStamp = TimeStamp;
+	Event.ScreenGazePointPx = ScreenGazePointPx;
+	return Event;
+}
+
+FVector2D FTobiiGazeEventClassifier::GetFixationCenterPx() const
+{
+	return NumFixationSamples > 0 ? FixationSumPx / (float)NumFixationSamples : LastScreenGazePointPx;
+}
+
+float FTobiiGazeEventClassifier::AngleBetweenDeg(const FVector& A, const FVector& B)
+{
+	return FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(A, B), -1.0f, 1.0f)));
+}
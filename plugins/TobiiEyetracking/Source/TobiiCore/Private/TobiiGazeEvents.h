@@ -0,0 +1,103 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#pragma once
+
+#include "TobiiTypes.h"
+
+#include "CoreMinimal.h"
+
+struct FTobiiGazeEventSettings
+{
+public:
+	//A saccade starts above the first speed and ends below the second. The gap keeps noise around one threshold from flickering.
+	float SaccadeStartDegPerSec;
+	float SaccadeEndDegPerSec;
+	//The gaze has to stay below the saccade threshold this long before a fixation starts.
+	float MinFixationSecs;
+	//No sample for this long while the user is present counts as a blink.
+	float BlinkGapSecs;
+
+	FTobiiGazeEventSettings()
+		: SaccadeStartDegPerSec(100.0f)
+		, SaccadeEndDegPerSec(50.0f)
+		, MinFixationSecs(0.06f)
+		, BlinkGapSecs(0.075f)
+	{}
+};
+
+/** One tracker sample waiting to be classified. */
+struct FTobiiGazeEventSample
+{
+	//When the tracker captured it, on the platform clock.
+	double PlatformSecs;
+	//Unit gaze direction relative to the head.
+	FVector HeadGazeDirection;
+	//Only passed along in the events. XR samples don't have one of their own and use the frame's.
+	FVector2D ScreenGazePointPx;
+	bool bHasScreenGazePoint;
+};
+
+/**
+  * Turns gaze samples into fixation, saccade and blink events as they come in, with constant work per sample.
+  * This is velocity threshold identification (I-VT) with hysteresis, so smooth pursuit below the saccade threshold counts as fixation.
+  * Times are FPlatformTime seconds, directions are relative to the head so turning the camera isn't mistaken for eye movement.
+  */
+class FTobiiGazeEventClassifier
+{
+public:
+	FTobiiGazeEventClassifier();
+
+	/** Forget everything. An open fixation, saccade or blink is ended first so listeners always see the end of what they saw start. */
+	void Reset(double NowSecs, const FDateTime& Now, TArray<FTobiiGazeEvent>& OutEvents);
+
+	/**
+	  * Classify a new valid sample.
+	  *
+	  * @param NowSecs				When the tracker captured the sample, on the platform clock.
+	  * @param Now					The same, for the event timestamps.
+	  * @param SampleDeltaSecs		Time since the previous sample, by the tracker's clock if there is one.
+	  * @param HeadGazeDirection	Unit gaze direction relative to the head.
+	  * @param ScreenGazePointPx	The sample's gaze point, only passed along in the events.
+	  * @param Settings				The thresholds to use.
+	  * @param OutEvents			Events are added to this.
+	  */
+	void AddSample(double NowSecs, const FDateTime& Now, double SampleDeltaSecs, const FVector& HeadGazeDirection, const FVector2D& ScreenGazePointPx, const FTobiiGazeEventSettings& Settings, TArray<FTobiiGazeEvent>& OutEvents);
+
+	/** Call every tick, after AddSample if there was a sample. Starts a blink when samples stopped coming in or the eyes are closed. */
+	void UpdateBlink(double NowSecs, const FDateTime& Now, bool bEyesClosed, bool bIsUserPresent, const FTobiiGazeEventSettings& Settings, TArray<FTobiiGazeEvent>& OutEvents);
+
+private:
+	enum class EState : uint8
+	{
+		None,
+		FixationCandidate,
+		Fixation,
+		Saccade,
+		Blink
+	};
+
+	EState State;
+	double StateStartSecs;
+	FDateTime StateStartTimeStamp;
+
+	bool bHasPrevSample;
+	FVector PrevGazeDirection;
+	double LastSampleSecs;
+	FVector2D LastScreenGazePointPx;
+
+	FVector2D FixationSumPx;
+	int32 NumFixationSamples;
+
+	FVector SaccadeStartDirection;
+	float SaccadePeakDegPerSec;
+
+	void BeginState(EState NewState, double StartSecs, const FDateTime& StartTimeStamp);
+	void EndOpenEvent(double NowSecs, const FDateTime& Now, TArray<FTobiiGazeEvent>& OutEvents);
+	FTobiiGazeEvent& AddEvent(ETobiiGazeEventType EventType, const FDateTime& TimeStamp, const FVector2D& ScreenGazePointPx, TArray<FTobiiGazeEvent>& OutEvents) const;
+	FVector2D GetFixationCenterPx() const;
+	static float AngleBetweenDeg(const FVector& A, const FVector& B);
+};
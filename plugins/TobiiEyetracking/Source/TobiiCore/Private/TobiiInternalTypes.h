@@ -73,4 +73,130 @@ public:
 	}
 };
 
+/**
+  * Maps eye tracker timestamps onto FPlatformTime::Seconds.
+  * The tracker clock isn't the engine's, so the offset is estimated as the smallest delay seen between a sample's timestamp and the tick that received it.
+  * That also folds the shortest transport latency into the offset. The estimate leaks upwards slowly so clock drift doesn't pin it to an old minimum.
+  */
+class FTobiiTrackerClock
+{
+public:
+	FTobiiTrackerClock()
+		: OffsetSecs(0.0)
+		, LastObservationSecs(0.0)
+		, bHasOffset(false)
+	{}
+
+	void Reset()
+	{
+		bHasOffset = false;
+	}
+
+	void AddObservation(int64 TrackerTimeStampMicroSecs, double ReceivedSecs)
+	{
+		const double ObservedOffsetSecs = ReceivedSecs - TrackerTimeStampMicroSecs / 1000000.0;
+		if (!bHasOffset)
+		{
+			OffsetSecs = ObservedOffsetSecs;
+			bHasOffset = true;
+		}
+		else
+		{
+			//Crystal oscillators drift well below this. It only needs to be large enough to recover from one unusually fast delivery.
+			const double MaxDriftSecsPerSec = 0.001;
+			const double LeakSecs = FMath::Max(ReceivedSecs - LastObservationSecs, 0.0) * MaxDriftSecsPerSec;
+			OffsetSecs = FMath::Min(ObservedOffsetSecs, OffsetSecs + LeakSecs);
+		}
+		LastObservationSecs = ReceivedSecs;
+	}
+
+	bool HasOffset() const { return bHasOffset; }
+
+	double ToPlatformSeconds(int64 TrackerTimeStampMicroSecs) const
+	{
+		return TrackerTimeStampMicroSecs / 1000000.0 + OffsetSecs;
+	}
+
+private:
+	double OffsetSecs;
+	double LastObservationSecs;
+	bool bHasOffset;
+};
+
+/**
+  * The last few HMD and pawn orientations, sampled once per tick, so gaze samples can be rotated into the world with the pose from when they were captured.
+  */
+class FTobiiPoseHistory
+{
+public:
+	FTobiiPoseHistory()
+		: NumPoses(0)
+		, NewestPoseIdx(Capacity - 1)
+	{}
+
+	void Reset()
+	{
+		NumPoses = 0;
+	}
+
+	void Add(double PlatformSecs, const FQuat& HMDOrientation, const FQuat& PawnOrientation)
+	{
+		NewestPoseIdx = (NewestPoseIdx + 1) % Capacity;
+		NumPoses = FMath::Min(NumPoses + 1, (int32)Capacity);
+
+		FTimedPose& Pose = Poses[NewestPoseIdx];
+		Pose.PlatformSecs = PlatformSecs;
+		Pose.HMDOrientation = HMDOrientation;
+		Pose.PawnOrientation = PawnOrientation;
+	}
+
+	/**
+	  * Interpolates the orientations at PlatformSecs. Times outside the history get its oldest or newest pose.
+	  *
+	  * @returns				False if the history is empty.
+	  */
+	bool Sample(double PlatformSecs, FQuat& OutHMDOrientation, FQuat& OutPawnOrientation) const
+	{
+		if (NumPoses == 0)
+		{
+			return false;
+		}
+
+		//Walk back from the newest pose. Gaze samples are rarely more than a couple of frames old.
+		const FTimedPose* Newer = &Poses[NewestPoseIdx];
+		for (int32 Age = 1; Age < NumPoses; Age++)
+		{
+			const FTimedPose& Older = Poses[(NewestPoseIdx - Age + Capacity) % Capacity];
+			if (PlatformSecs >= Older.PlatformSecs)
+			{
+				const double Span = Newer->PlatformSecs - Older.PlatformSecs;
+				const float Alpha = Span > 0.0 ? (float)FMath::Clamp((PlatformSecs - Older.PlatformSecs) / Span, 0.0, 1.0) : 1.0f;
+				OutHMDOrientation = FQuat::Slerp(Older.HMDOrientation, Newer->HMDOrientation, Alpha);
+				OutPawnOrientation = FQuat::Slerp(Older.PawnOrientation, Newer->PawnOrientation, Alpha);
+				return true;
+			}
+			Newer = &Older;
+		}
+
+		OutHMDOrientation = Newer->HMDOrientation;
+		OutPawnOrientation = Newer->PawnOrientation;
+		return true;
+	}
+
+private:
+	struct FTimedPose
+	{
+		double PlatformSecs;
+		FQuat HMDOrientation;
+		FQuat PawnOrientation;
+	};
+
+	//About a third of a second at 90 Hz, far more than the tracker's latency.
+	enum { Capacity = 32 };
+
+	FTimedPose Poses[Capacity];
+	int32 NumPoses;
+	int32 NewestPoseIdx;
+};
+
 DEFINE_LOG_CATEGORY_STATIC(LogTobiiEyetracking, All, All);
@@ -12,6 +12,10 @@
 #include "Windows/AllowWindowsPlatformTypes.h"
 #include "dbt.h"
 
+#ifndef WM_DPICHANGED
+#define WM_DPICHANGED 0x02E0
+#endif
+
 struct MonitorHandleContext
 {
 	FString DeviceName;
@@ -79,6 +83,25 @@ bool FTobiiPlatformSpecific::ConvertGazeCoordinateToVirtualDesktopPixel(void* Ga
 	return false;
 }
 
+bool FTobiiPlatformSpecific::ConvertVirtualDesktopPixelToGazeCoordinate(void* GameWindowHandle, const FIntPoint& VirtualDesktopPixel, FVector2D& OutClientCoordsUNorm)
+{
+	RECT ClientRect;
+	if (GetClientRect((HWND)GameWindowHandle, &ClientRect) && ClientRect.right > ClientRect.left && ClientRect.bottom > ClientRect.top)
+	{
+		POINT ClientPoint;
+		ClientPoint.x = VirtualDesktopPixel.X;
+		ClientPoint.y = VirtualDesktopPixel.Y;
+		if (ScreenToClient((HWND)GameWindowHandle, &ClientPoint))
+		{
+			OutClientCoordsUNorm.X = ClientPoint.x / (float)(ClientRect.right - ClientRect.left);
+			OutClientCoordsUNorm.Y = ClientPoint.y / (float)(ClientRect.bottom - ClientRect.top);
+			return true;
+		}
+	}
+
+	return false;
+}
+
 FTobiiPlatformNotifications::FTobiiPlatformNotifications()
 	: bShouldForceEyetrackerReconnect(true)
 	, bShouldUpdateGameMonitorHandle(true)
@@ -122,7 +145,11 @@ bool FTobiiPlatformNotifications::ProcessMessage(HWND hwnd, uint32 msg, WPARAM w
 	}
 
 	case WM_DISPLAYCHANGE:
+	case WM_DPICHANGED:
+	case WM_MOVE:
+	case WM_SIZE:
 	{
+		//A moved window may have ended up on another monitor, and a resize or DPI change invalidates the cached display transform.
 		bShouldUpdateGameMonitorHandle = true;
 		break;
 	}
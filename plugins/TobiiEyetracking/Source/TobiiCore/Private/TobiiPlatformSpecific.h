@@ -15,6 +15,7 @@ public:
 	static void* MonitorHandleFromDeviceName(FString DeviceName);
 	
 	static bool ConvertGazeCoordinateToVirtualDesktopPixel(void* GameWindowHandle, const FVector2D& ClientCoordsUNorm, FIntPoint& OutVirtualDesktopPixel);
+	static bool ConvertVirtualDesktopPixelToGazeCoordinate(void* GameWindowHandle, const FIntPoint& VirtualDesktopPixel, FVector2D& OutClientCoordsUNorm);
 }; 
 
 #if PLATFORM_WINDOWS
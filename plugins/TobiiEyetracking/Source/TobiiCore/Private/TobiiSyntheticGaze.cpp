@@ -0,0 +1,192 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#include "TobiiSyntheticGaze.h"
+
+#if TOBII_EYETRACKING_ACTIVE
+
+using namespace TobiiGameIntegration;
+
+//After a hitch, older samples are dropped instead of delivered in one huge batch.
+static const double MaxPendingSecs = 0.25;
+
+FTobiiSyntheticGazeSource::FTobiiSyntheticGazeSource()
+{
+	Reset(FTobiiSyntheticGazeSettings());
+}
+
+void FTobiiSyntheticGazeSource::Reset(const FTobiiSyntheticGazeSettings& InSettings)
+{
+	Settings = InSettings;
+	Settings.SampleRateHz = FMath::Clamp(Settings.SampleRateHz, 1.0f, 2000.0f);
+	Settings.FieldWidthDeg = FMath::Max(Settings.FieldWidthDeg, 1.0f);
+	Settings.FieldHeightDeg = FMath::Max(Settings.FieldHeightDeg, 1.0f);
+
+	Random.Initialize(Settings.Seed);
+	SampleIdx = 0;
+	PendingSecs = 0.0;
+	PositionDeg = FVector2D::ZeroVector;
+	BeginFixation();
+}
+
+int32 FTobiiSyntheticGazeSource::Tick(float DeltaTime, TArray<GazePoint>& OutGazePoints)
+{
+	OutGazePoints.Reset();
+
+	const double SamplePeriodSecs = 1.0 / Settings.SampleRateHz;
+	PendingSecs = FMath::Min(PendingSecs + FMath::Max(DeltaTime, 0.0f), MaxPendingSecs);
+	while (PendingSecs >= SamplePeriodSecs)
+	{
+		PendingSecs -= SamplePeriodSecs;
+		Step(SamplePeriodSecs);
+		SampleIdx++;
+
+		//The noise is drawn even during blinks so a blink doesn't shift the rest of the sequence.
+		const FVector2D NoiseDeg(Gaussian() * Settings.NoiseDeg, Gaussian() * Settings.NoiseDeg);
+		if (Phase == EPhase::Blink)
+		{
+			continue;
+		}
+
+		const FVector2D SampleDeg = PositionDeg + NoiseDeg;
+		GazePoint& Point = OutGazePoints.AddDefaulted_GetRef();
+		Point.TimeStampMicroSeconds = (int64_t)(SampleIdx * 1000000.0 / Settings.SampleRateHz);
+		Point.X = SampleDeg.X / (Settings.FieldWidthDeg * 0.5f);
+		Point.Y = SampleDeg.Y / (Settings.FieldHeightDeg * 0.5f);
+	}
+
+	return OutGazePoints.Num();
+}
+
+void FTobiiSyntheticGazeSource::Step(double StepSecs)
+{
+	PhaseSecs += StepSecs;
+
+	switch (Phase)
+	{
+	case EPhase::Fixation:
+		PositionDeg = ClampToField(PositionDeg + VelocityDegPerSec * (float)StepSecs);
+		break;
+
+	case EPhase::Saccade:
+	{
+		//A raised cosine velocity profile. It peaks at twice the average velocity, which is about what the main sequence gives.
+		const float Alpha = (float)FMath::Clamp(PhaseSecs / PhaseDurationSecs, 0.0, 1.0);
+		const float Progress = Alpha - FMath::Sin(2.0f * PI * Alpha) / (2.0f * PI);
+		PositionDeg = FMath::Lerp(PhaseStartDeg, SaccadeTargetDeg, Progress);
+		break;
+	}
+
+	case EPhase::Pursuit:
+	{
+		//Bounce off the screen edges so the target stays in view.
+		FVector2D NewPositionDeg = PositionDeg + VelocityDegPerSec * (float)StepSecs;
+		const FVector2D HalfFieldDeg(Settings.FieldWidthDeg * 0.5f, Settings.FieldHeightDeg * 0.5f);
+		if (FMath::Abs(NewPositionDeg.X) > HalfFieldDeg.X)
+		{
+			VelocityDegPerSec.X = -VelocityDegPerSec.X;
+		}
+		if (FMath::Abs(NewPositionDeg.Y) > HalfFieldDeg.Y)
+		{
+			VelocityDegPerSec.Y = -VelocityDegPerSec.Y;
+		}
+		PositionDeg = ClampToField(NewPositionDeg);
+		break;
+	}
+
+	case EPhase::Blink:
+		break;
+	}
+
+	if (PhaseSecs >= PhaseDurationSecs)
+	{
+		BeginNextPhase();
+	}
+}
+
+void FTobiiSyntheticGazeSource::BeginNextPhase()
+{
+	if (Phase != EPhase::Fixation)
+	{
+		BeginFixation();
+		return;
+	}
+
+	//Blinks come at the end of fixations. The mean fixation with the saccade after it is about 0.3 seconds.
+	const float BlinkProbability = FMath::Clamp(Settings.BlinksPerMinute / 60.0f * 0.3f, 0.0f, 1.0f);
+	const float Roll = Random.GetFraction();
+	if (Roll < BlinkProbability)
+	{
+		BeginBlink();
+	}
+	else if (Roll < BlinkProbability + Settings.PursuitProbability)
+	{
+		BeginPursuit();
+	}
+	else
+	{
+		BeginSaccade();
+	}
+}
+
+void FTobiiSyntheticGazeSource::BeginFixation()
+{
+	//Fixation durations are roughly log-normal with a median around 250 ms.
+	Phase = EPhase::Fixation;
+	PhaseSecs = 0.0;
+	PhaseDurationSecs = FMath::Clamp(FMath::Exp(FMath::Loge(0.25f) + 0.4f * Gaussian()), 0.08f, 1.5f);
+	VelocityDegPerSec.Set(Gaussian() * 0.3f, Gaussian() * 0.3f);
+}
+
+void FTobiiSyntheticGazeSource::BeginSaccade()
+{
+	//Most saccades are small, with a long tail of larger ones.
+	const float AmplitudeDeg = FMath::Clamp(FMath::Exp(FMath::Loge(6.0f) + 0.6f * Gaussian()), 0.5f, 30.0f);
+	const float DirectionRad = Random.FRandRange(0.0f, 2.0f * PI);
+
+	Phase = EPhase::Saccade;
+	PhaseSecs = 0.0;
+	PhaseStartDeg = PositionDeg;
+	SaccadeTargetDeg = ClampToField(PositionDeg + FVector2D(FMath::Cos(DirectionRad), FMath::Sin(DirectionRad)) * AmplitudeDeg);
+
+	//Main sequence duration, from the amplitude that is left after keeping the target on screen.
+	const float ActualAmplitudeDeg = FVector2D::Distance(PhaseStartDeg, SaccadeTargetDeg);
+	PhaseDurationSecs = 0.021 + 0.0022 * ActualAmplitudeDeg;
+}
+
+void FTobiiSyntheticGazeSource::BeginPursuit()
+{
+	const float SpeedDegPerSec = Random.FRandRange(5.0f, 25.0f);
+	const float DirectionRad = Random.FRandRange(0.0f, 2.0f * PI);
+
+	Phase = EPhase::Pursuit;
+	PhaseSecs = 0.0;
+	PhaseDurationSecs = Random.FRandRange(0.4f, 1.2f);
+	VelocityDegPerSec = FVector2D(FMath::Cos(DirectionRad), FMath::Sin(DirectionRad)) * SpeedDegPerSec;
+}
+
+void FTobiiSyntheticGazeSource::BeginBlink()
+{
+	Phase = EPhase::Blink;
+	PhaseSecs = 0.0;
+	PhaseDurationSecs = Random.FRandRange(0.1f, 0.3f);
+}
+
+float FTobiiSyntheticGazeSource::Gaussian()
+{
+	//Box-Muller
+	const float U1 = FMath::Max(Random.GetFraction(), SMALL_NUMBER);
+	const float U2 = Random.GetFraction();
+	return FMath::Sqrt(-2.0f * FMath::Loge(U1)) * FMath::Cos(2.0f * PI * U2);
+}
+
+FVector2D FTobiiSyntheticGazeSource::ClampToField(const FVector2D& PointDeg) const
+{
+	const FVector2D HalfFieldDeg(Settings.FieldWidthDeg * 0.5f, Settings.FieldHeightDeg * 0.5f);
+	return FVector2D(FMath::Clamp(PointDeg.X, -HalfFieldDeg.X, HalfFieldDeg.X), FMath::Clamp(PointDeg.Y, -HalfFieldDeg.Y, HalfFieldDeg.Y));
+}
+
+#endif //TOBII_EYETRACKING_ACTIVE
@@ -0,0 +1,108 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#pragma once
+
+#if TOBII_EYETRACKING_ACTIVE
+
+#include "tobii_gameintegration.h"
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+struct FTobiiSyntheticGazeSettings
+{
+public:
+	float SampleRateHz;
+	int32 Seed;
+	//How much of the visual field the screen covers. A 60 cm wide monitor at 65 cm is about 50 x 30 degrees.
+	float FieldWidthDeg;
+	float FieldHeightDeg;
+	//Standard deviation of the measurement noise added to every sample.
+	float NoiseDeg;
+	float BlinksPerMinute;
+	//Chance that a fixation is followed by smooth pursuit instead of a saccade.
+	float PursuitProbability;
+
+	FTobiiSyntheticGazeSettings()
+		: SampleRateHz(90.0f)
+		, Seed(0)
+		, FieldWidthDeg(50.0f)
+		, FieldHeightDeg(30.0f)
+		, NoiseDeg(0.3f)
+		, BlinksPerMinute(15.0f)
+		, PursuitProbability(0.15f)
+	{}
+
+	bool operator==(const FTobiiSyntheticGazeSettings& Other) const
+	{
+		return SampleRateHz == Other.SampleRateHz
+			&& Seed == Other.Seed
+			&& FieldWidthDeg == Other.FieldWidthDeg
+			&& FieldHeightDeg == Other.FieldHeightDeg
+			&& NoiseDeg == Other.NoiseDeg
+			&& BlinksPerMinute == Other.BlinksPerMinute
+			&& PursuitProbability == Other.PursuitProbability;
+	}
+	bool operator!=(const FTobiiSyntheticGazeSettings& Other) const { return !(*this == Other); }
+};
+
+/**
+  * Makes up gaze points the way a desktop tracker would deliver them, SNorm with Y up, so they can go through the same code as the real stream.
+  * The eyes alternate between fixations with slow drift, saccades that follow the main sequence, smooth pursuit and blinks, which deliver no samples at all.
+  * Samples are generated on their own clock at a fixed rate, so the same seed always gives the same sample sequence no matter the frame rate.
+  */
+class FTobiiSyntheticGazeSource
+{
+public:
+	FTobiiSyntheticGazeSource();
+
+	/** Restart the sequence from the center of the screen. */
+	void Reset(const FTobiiSyntheticGazeSettings& InSettings);
+	const FTobiiSyntheticGazeSettings& GetSettings() const { return Settings; }
+	bool IsBlinking() const { return Phase == EPhase::Blink; }
+
+	/**
+	  * Advance by DeltaTime.
+	  *
+	  * @param DeltaTime			Seconds since the last call.
+	  * @param OutGazePoints		Replaced with the samples that fell in that time. Timestamps count microseconds since Reset.
+	  * @returns					The number of samples.
+	  */
+	int32 Tick(float DeltaTime, TArray<TobiiGameIntegration::GazePoint>& OutGazePoints);
+
+private:
+	enum class EPhase : uint8
+	{
+		Fixation,
+		Saccade,
+		Pursuit,
+		Blink
+	};
+
+	FTobiiSyntheticGazeSettings Settings;
+	FRandomStream Random;
+	EPhase Phase;
+	int64 SampleIdx;
+	double PendingSecs;
+	double PhaseSecs;
+	double PhaseDurationSecs;
+	FVector2D PositionDeg;
+	FVector2D PhaseStartDeg;
+	FVector2D SaccadeTargetDeg;
+	FVector2D VelocityDegPerSec;
+
+	void Step(double StepSecs);
+	void BeginNextPhase();
+	void BeginFixation();
+	void BeginSaccade();
+	void BeginPursuit();
+	void BeginBlink();
+	float Gaussian();
+	FVector2D ClampToField(const FVector2D& PointDeg) const;
+};
+
+#endif //TOBII_EYETRACKING_ACTIVE
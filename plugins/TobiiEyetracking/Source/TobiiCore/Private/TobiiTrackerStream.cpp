@@ -0,0 +1,129 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#include "TobiiTrackerStream.h"
+
+#if TOBII_EYETRACKING_ACTIVE
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+using namespace TobiiGameIntegration;
+
+FTobiiTrackerStream::FTobiiTrackerStream(ITobiiGameIntegrationApi* InTgiApi, const FString& InUrl, const Rectangle& InDisplayRect, float InPollIntervalSecs)
+	: TgiApi(InTgiApi)
+	, Url(InUrl)
+	, DisplayRect(InDisplayRect)
+	, PollIntervalSecs(FMath::Max(InPollIntervalSecs, 0.001f))
+	, FirstSampleIdx(0)
+	, NumSamples(0)
+	, Thread(nullptr)
+	, bStopRequested(false)
+	, bIsConnected(false)
+	, bIsUserPresent(false)
+{
+	Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("TobiiTrackerStream %s"), *Url), 0, TPri_AboveNormal);
+}
+
+FTobiiTrackerStream::~FTobiiTrackerStream()
+{
+	if (Thread != nullptr)
+	{
+		//Kill calls Stop and waits for Run to return, so the API is no longer in use after this.
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (TgiApi != nullptr)
+	{
+		TgiApi->Shutdown();
+		TgiApi = nullptr;
+	}
+}
+
+bool FTobiiTrackerStream::HasDisplayRect(const Rectangle& Rect) const
+{
+	return DisplayRect.Left == Rect.Left && DisplayRect.Top == Rect.Top && DisplayRect.Right == Rect.Right && DisplayRect.Bottom == Rect.Bottom;
+}
+
+void FTobiiTrackerStream::DrainSamples(TArray<FTobiiTrackerStreamSample>& OutSamples)
+{
+	FScopeLock Lock(&SamplesCriticalSection);
+	for (int32 SampleIdx = 0; SampleIdx < NumSamples; SampleIdx++)
+	{
+		OutSamples.Add(Samples[(FirstSampleIdx + SampleIdx) % MaxBufferedSamples]);
+	}
+	FirstSampleIdx = 0;
+	NumSamples = 0;
+}
+
+uint32 FTobiiTrackerStream::Run()
+{
+	const float DisplayWidthPx = (float)(DisplayRect.Right - DisplayRect.Left);
+	const float DisplayHeightPx = (float)(DisplayRect.Bottom - DisplayRect.Top);
+
+	while (!bStopRequested)
+	{
+		ITrackerController* TrackerController = TgiApi->GetTrackerController();
+		if (TrackerController != nullptr)
+		{
+			TrackerController->TrackRectangle(DisplayRect);
+		}
+		TgiApi->Update();
+
+		IStreamsProvider* StreamsProvider = TgiApi->GetStreamsProvider();
+		bIsConnected = StreamsProvider != nullptr && TrackerController != nullptr && TrackerController->IsConnected();
+		if (bIsConnected)
+		{
+			bIsUserPresent = StreamsProvider->IsPresent();
+
+			const GazePoint* GazePointsSNorm = nullptr;
+			const int NumGazePoints = StreamsProvider->GetGazePoints(GazePointsSNorm);
+			if (NumGazePoints > 0 && GazePointsSNorm != nullptr)
+			{
+				const double NowSecs = FPlatformTime::Seconds();
+				for (int32 GazeIdx = 0; GazeIdx < NumGazePoints; GazeIdx++)
+				{
+					Clock.AddObservation(GazePointsSNorm[GazeIdx].TimeStampMicroSeconds, NowSecs);
+				}
+
+				FScopeLock Lock(&SamplesCriticalSection);
+				for (int32 GazeIdx = 0; GazeIdx < NumGazePoints; GazeIdx++)
+				{
+					if (NumSamples == MaxBufferedSamples)
+					{
+						FirstSampleIdx = (FirstSampleIdx + 1) % MaxBufferedSamples;
+						NumSamples--;
+					}
+
+					FTobiiTrackerStreamSample& Sample = Samples[(FirstSampleIdx + NumSamples) % MaxBufferedSamples];
+					NumSamples++;
+					Sample.PlatformSecs = Clock.ToPlatformSeconds(GazePointsSNorm[GazeIdx].TimeStampMicroSeconds);
+					Sample.VirtualDesktopPx.X = DisplayRect.Left + FMath::RoundToInt((GazePointsSNorm[GazeIdx].X + 1.0f) * 0.5f * DisplayWidthPx);
+					Sample.VirtualDesktopPx.Y = DisplayRect.Top + FMath::RoundToInt((1.0f - GazePointsSNorm[GazeIdx].Y) * 0.5f * DisplayHeightPx);
+				}
+			}
+		}
+		else
+		{
+			bIsUserPresent = false;
+		}
+
+		FPlatformProcess::Sleep(PollIntervalSecs);
+	}
+
+	return 0;
+}
+
+void FTobiiTrackerStream::Stop()
+{
+	bStopRequested = true;
+}
+
+#endif //TOBII_EYETRACKING_ACTIVE
@@ -0,0 +1,83 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#pragma once
+
+#if TOBII_EYETRACKING_ACTIVE
+
+#include "TobiiInternalTypes.h"
+#include "tobii_gameintegration.h"
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+
+class FRunnableThread;
+
+/** One gaze point from a secondary tracker, in virtual desktop pixels and on the platform clock. */
+struct FTobiiTrackerStreamSample
+{
+	double PlatformSecs;
+	FIntPoint VirtualDesktopPx;
+};
+
+/** One gaze point in the timeline all trackers are merged into. */
+struct FTobiiMergedGazeSample
+{
+	double PlatformSecs;
+	//Normalized to the game window's client area, like the gaze points of the tracker following the game window.
+	FVector2D GazePointUNorm;
+	//0 is the tracker following the game window, the streams follow from 1.
+	int32 TrackerIdx;
+};
+
+/**
+  * A tracker other than the one following the game window, read on its own thread.
+  * The game integration API tracks one device per API instance, so every stream owns one and points it at its tracker's display rectangle.
+  * Pumping the API, reading gaze and mapping it to desktop pixels all happen here, so a slow tracker only delays its own samples.
+  */
+class FTobiiTrackerStream : public FRunnable
+{
+public:
+	FTobiiTrackerStream(TobiiGameIntegration::ITobiiGameIntegrationApi* InTgiApi, const FString& InUrl, const TobiiGameIntegration::Rectangle& InDisplayRect, float InPollIntervalSecs);
+	virtual ~FTobiiTrackerStream();
+
+	const FString& GetUrl() const { return Url; }
+	bool HasDisplayRect(const TobiiGameIntegration::Rectangle& Rect) const;
+	bool IsConnected() const { return bIsConnected; }
+	bool IsUserPresent() const { return bIsUserPresent; }
+
+	/** Game thread. Adds the samples that arrived since the last call, oldest first. If nobody drains them for a while, only the newest MaxBufferedSamples are kept. */
+	void DrainSamples(TArray<FTobiiTrackerStreamSample>& OutSamples);
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	TobiiGameIntegration::ITobiiGameIntegrationApi* TgiApi;
+	FString Url;
+	TobiiGameIntegration::Rectangle DisplayRect;
+	float PollIntervalSecs;
+
+	//Every tracker has its own clock, so each one gets its own offset to the platform clock.
+	FTobiiTrackerClock Clock;
+
+	//A few seconds of gaze at the rates desktop trackers run at. Older samples are overwritten, they would be too stale to use anyway.
+	enum { MaxBufferedSamples = 512 };
+	FTobiiTrackerStreamSample Samples[MaxBufferedSamples];
+	int32 FirstSampleIdx;
+	int32 NumSamples;
+	FCriticalSection SamplesCriticalSection;
+
+	FRunnableThread* Thread;
+	FThreadSafeBool bStopRequested;
+	FThreadSafeBool bIsConnected;
+	FThreadSafeBool bIsUserPresent;
+};
+
+#endif //TOBII_EYETRACKING_ACTIVE
@@ -11,6 +11,10 @@
 #include "CoreMinimal.h"
 #include "IEyeTracker.h"
 
+class FTobiiFoveationViewExtension;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FTobiiGazeEventDelegate, const FTobiiGazeEvent&);
+
 class ITobiiEyeTracker : public IEyeTracker
 {
 	/************************************************************************/
@@ -87,6 +91,30 @@ public:
 	  */
 	virtual const FTobiiDisplayInfo& GetDisplayInformation() const = 0;
 
+	/**
+	  * The maps between the coordinate spaces of the main viewport as of this tick. Use this when converting many points, it costs nothing per point beyond a multiply and an add.
+	  *
+	  * @returns				Composed viewport coordinate transforms.
+	  */
+	virtual const FTobiiViewportTransform& GetViewportTransform() const = 0;
+
+	/**
+	  * The view extension that hands the predicted gaze to the renderer. Render code reads the current frame's foveal region from it with GetFoveationFrame_RenderThread.
+	  * It is only created once the engine is up and only publishes anything while tobii.foveation.Enable is set.
+	  *
+	  * @returns				The foveation view extension, or null if it doesn't exist yet.
+	  */
+	virtual TSharedPtr<FTobiiFoveationViewExtension, ESPMode::ThreadSafe> GetFoveationViewExtension() const = 0;
+
+	/**
+	  * Fixation, saccade and blink events, classified from every sample the tracker delivers, with the sample's own timestamp. Mouse emulation is classified once per frame.
+	  * Broadcast on the game thread during the tracker's tick, so an event is seen up to a frame after its timestamp.
+	  * Bind to this instead of polling the gaze data and working out the movement yourself. From blueprints, use a UTobiiGazeEventComponent.
+	  *
+	  * @returns				The gaze event delegate.
+	  */
+	virtual FTobiiGazeEventDelegate& OnGazeEvent() = 0;
+
 	/************************************************************************/
 	/* Head Tracker                                                         */
 	/************************************************************************/
@@ -135,6 +135,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Tobii Math Utils")
 	static bool ViewportUNormCoordToPixelCoord(const FVector2D& InCoordinateUNorm, FVector2D& OutCoordinatePx);
 
+	/**
+	  * The maps between the coordinate spaces of the main viewport, as published by the tracker this tick.
+	  * Get it once and pass it to ConvertTobiiCoordinate or ConvertTobiiCoordinates when converting many points.
+	  */
+	UFUNCTION(BlueprintPure, Category = "Tobii Math Utils")
+	static FTobiiViewportTransform GetTobiiViewportTransform();
+
+	UFUNCTION(BlueprintPure, Category = "Tobii Math Utils")
+	static bool ConvertTobiiCoordinate(const FTobiiViewportTransform& ViewportTransform, ETobiiCoordinateSpace From, ETobiiCoordinateSpace To, const FVector2D& InPoint, FVector2D& OutPoint);
+
+	/**
+	  * Converts a whole array of points at once. Returns false and fills OutPoints with zeros if one of the spaces isn't known yet.
+	  */
+	UFUNCTION(BlueprintCallable, Category = "Tobii Math Utils")
+	static bool ConvertTobiiCoordinates(const FTobiiViewportTransform& ViewportTransform, ETobiiCoordinateSpace From, ETobiiCoordinateSpace To, const TArray<FVector2D>& InPoints, TArray<FVector2D>& OutPoints);
+
 	/**
 	  * This function lets you move from world space to the local space of the user. In XR this would be head space, and for desktop it would be relative to the scene camera.
 	  */
@@ -0,0 +1,103 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#pragma once
+
+#include "TobiiTypes.h"
+
+#include "CoreMinimal.h"
+#include "SceneViewExtension.h"
+
+/**
+  * Where the user will be looking when a frame reaches the screen, in a form the render thread can use.
+  * Coordinates are UNorm over the main viewport, so they apply to each view's rect regardless of resolution.
+  */
+struct FTobiiFoveationFrame
+{
+public:
+	//The gaze point extrapolated to when this frame is expected to be displayed.
+	FVector2D PredictedGazePointUNorm;
+	//Radii of the foveal ellipse around the predicted gaze point, widened by how uncertain the prediction is.
+	FVector2D FovealRadiiUNorm;
+	//The screen percentage scale the view extension applied to this frame. 1 means untouched.
+	float ScreenPercentageScale;
+	//GFrameNumber of the game thread frame this was made for.
+	uint32 FrameNumber;
+	bool bIsGazeValid;
+	bool bIsFixating;
+
+	FTobiiFoveationFrame()
+		: PredictedGazePointUNorm(0.5f, 0.5f)
+		, FovealRadiiUNorm(0.0f, 0.0f)
+		, ScreenPercentageScale(1.0f)
+		, FrameNumber(0)
+		, bIsGazeValid(false)
+		, bIsFixating(false)
+	{}
+};
+
+/**
+  * Hands the tracker's gaze to the renderer.
+  * Every frame the game thread writes a predicted gaze into one slot of a triple buffer and passes its index to the render thread with ENQUEUE_RENDER_COMMAND.
+  * The game thread is never more than one frame ahead of the render thread, so the slot being written is never the one being read.
+  *
+  * UE 4.23 has no variable rate shading or per region screen percentage, so the regions are published for render code that can use them,
+  * and what the extension drives itself is the view's screen percentage: it is lowered while the user isn't looking at the screen and,
+  * optionally, during saccades and blinks, when the visual system suppresses detail anyway. See the tobii.foveation CVars.
+  */
+class TOBIICORE_API FTobiiFoveationViewExtension : public FSceneViewExtensionBase
+{
+public:
+	FTobiiFoveationViewExtension(const FAutoRegister& AutoRegister);
+
+	/**
+	  * Feed the latest gaze. Game thread only, the eye tracker calls this every tick.
+	  *
+	  * @param CombinedGazeData		This tick's combined gaze.
+	  * @param DisplayInfo			Used to bring the pixel data to UNorm.
+	  * @param bIsUserPresent		False while the user isn't looking at the screen.
+	  */
+	void SetGaze(const FTobiiGazeData& CombinedGazeData, const FTobiiDisplayInfo& DisplayInfo, bool bIsUserPresent);
+
+	/** The foveation data of the frame the render thread is working on. Render thread only. */
+	const FTobiiFoveationFrame& GetFoveationFrame_RenderThread() const;
+
+	/** The foveation data the game thread made last. Game thread only. */
+	const FTobiiFoveationFrame& GetFoveationFrame_GameThread() const;
+
+	/************************************************************************/
+	/* ISceneViewExtension                                                  */
+	/************************************************************************/
+public:
+	virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override;
+	virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override;
+	virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override;
+	virtual void PreRenderViewFamily_RenderThread(FRHICommandListImmediate& RHICmdList, FSceneViewFamily& InViewFamily) override {}
+	virtual void PreRenderView_RenderThread(FRHICommandListImmediate& RHICmdList, FSceneView& InView) override {}
+	virtual bool IsActiveThisFrame(class FViewport* InViewport) const override;
+
+private:
+	enum { NumFrames = 3 };
+
+	FTobiiFoveationFrame Frames[NumFrames];
+	int32 GameThreadFrameIdx;
+	int32 RenderThreadFrameIdx;
+	uint32 LastBuiltFrameNumber;
+
+	//The last two gaze samples, timed in FPlatformTime seconds, for the extrapolation.
+	FDateTime GazeTimeStamp;
+	FVector2D GazePointUNorm;
+	FVector2D PrevGazePointUNorm;
+	double GazeSampleSecs;
+	double PrevGazeSampleSecs;
+	FVector2D GazeRadiiUNorm;
+	bool bIsGazeValid;
+	bool bIsFixating;
+	bool bIsUserPresent;
+	double LastSetGazeSecs;
+
+	void BuildFrame(FTobiiFoveationFrame& OutFrame) const;
+};
@@ -0,0 +1,65 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#pragma once
+
+#include "TobiiTypes.h"
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+
+#include "TobiiGazeEventComponent.generated.h"
+
+class ITobiiEyeTracker;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTobiiGazeEventSignature, const FTobiiGazeEvent&, GazeEvent);
+
+/**
+  * Forwards the eye tracker's fixation, saccade and blink events to blueprints. See ITobiiEyeTracker::OnGazeEvent.
+  * Every event goes to OnGazeEvent, and also to the delegate for its type.
+  */
+UCLASS(BlueprintType, Blueprintable, ClassGroup = "Tobii", meta = (BlueprintSpawnableComponent))
+class TOBIICORE_API UTobiiGazeEventComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable, Category = "Gaze Events")
+	FTobiiGazeEventSignature OnGazeEvent;
+
+	UPROPERTY(BlueprintAssignable, Category = "Gaze Events")
+	FTobiiGazeEventSignature OnFixationStarted;
+
+	UPROPERTY(BlueprintAssignable, Category = "Gaze Events")
+	FTobiiGazeEventSignature OnFixationEnded;
+
+	UPROPERTY(BlueprintAssignable, Category = "Gaze Events")
+	FTobiiGazeEventSignature OnSaccadeStarted;
+
+	UPROPERTY(BlueprintAssignable, Category = "Gaze Events")
+	FTobiiGazeEventSignature OnSaccadeEnded;
+
+	UPROPERTY(BlueprintAssignable, Category = "Gaze Events")
+	FTobiiGazeEventSignature OnBlinkStarted;
+
+	UPROPERTY(BlueprintAssignable, Category = "Gaze Events")
+	FTobiiGazeEventSignature OnBlinkEnded;
+
+public:
+	UTobiiGazeEventComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	TWeakPtr<ITobiiEyeTracker, ESPMode::ThreadSafe> BoundEyeTracker;
+	FDelegateHandle GazeEventHandle;
+
+	bool BindToEyeTracker();
+	void UnbindFromEyeTracker();
+	void HandleGazeEvent(const FTobiiGazeEvent& GazeEvent);
+};
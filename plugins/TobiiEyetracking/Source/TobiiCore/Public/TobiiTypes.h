@@ -29,6 +29,9 @@ public:
 	//Due to how the eye works and imperfections in eye tracking technology, it makes more sense to express the world gaze field as a cone rather than a ray. This angle is the angle between the Gaze Direction and the side of the cone expressed in degrees.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Space Data")
 	float WorldGazeConeAngleDegrees;
+	//How far along the gaze ray the eyes converge, in centimeters. This is only estimated in XR with tobii.xr.VergenceTrace enabled, and is 0 when it isn't known.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "World Space Gaze Data")
+	float WorldFixationDepth;
 
 	//The gaze point in screen space in pixels this frame.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Screen Space Gaze Data")
@@ -51,7 +54,8 @@ public:
 	bool bIsGazeDataValid;
 
 	FTobiiGazeData()
-		: bIsGazeDataValid(false)
+		: WorldFixationDepth(0.0f)
+		, bIsGazeDataValid(false)
 	{
 	}
 };
@@ -121,6 +125,12 @@ public:
 	void* GameWindowHandle;
 	void* GameMonitorHandle;
 
+	//Precomputed scales between the main viewport's coordinate spaces, so conversions are a multiply. They are refreshed together with the sizes above and are zero while those aren't known.
+	FVector2D ViewportPxPerUNorm;
+	FVector2D ViewportUNormPerPx;
+	FVector2D ViewportCmPerPx;
+	FVector2D ViewportPxPerCm;
+
 public:
 	FTobiiDisplayInfo()
 		: MonitorWidthPx(0)
@@ -137,7 +147,204 @@ public:
 
 		, GameWindowHandle(nullptr)
 		, GameMonitorHandle(nullptr)
+
+		, ViewportPxPerUNorm(0.0f, 0.0f)
+		, ViewportUNormPerPx(0.0f, 0.0f)
+		, ViewportCmPerPx(0.0f, 0.0f)
+		, ViewportPxPerCm(0.0f, 0.0f)
+	{}
+
+	bool HasViewportPx() const { return MainViewportWidthPx > 0 && MainViewportHeightPx > 0; }
+	bool HasViewportCm() const { return HasViewportPx() && MainViewportWidthCm > 0.0f && MainViewportHeightCm > 0.0f; }
+
+	void UpdateViewportScales()
+	{
+		ViewportPxPerUNorm = ViewportUNormPerPx = ViewportCmPerPx = ViewportPxPerCm = FVector2D::ZeroVector;
+		if (HasViewportPx())
+		{
+			ViewportPxPerUNorm.Set((float)MainViewportWidthPx, (float)MainViewportHeightPx);
+			ViewportUNormPerPx.Set(1.0f / MainViewportWidthPx, 1.0f / MainViewportHeightPx);
+		}
+		if (HasViewportCm())
+		{
+			ViewportCmPerPx.Set(MainViewportWidthCm / MainViewportWidthPx, MainViewportHeightCm / MainViewportHeightPx);
+			ViewportPxPerCm.Set(MainViewportWidthPx / MainViewportWidthCm, MainViewportHeightPx / MainViewportHeightCm);
+		}
+	}
+};
+
+/**
+  * The coordinate spaces the main game viewport can be described in.
+  */
+UENUM(BlueprintType)
+enum class ETobiiCoordinateSpace : uint8
+{
+	/** 0 to 1 across the main viewport with the origin in the top left corner. This is what the gaze point is reported in by the tracker. */
+	ViewportUNorm,
+
+	/** Pixels of the main viewport with the origin in the top left corner. */
+	ViewportPixel,
+
+	/** Centimeters on the physical screen with the origin in the top left corner of the main viewport. */
+	ViewportCm,
+
+	/** Pixels of the virtual desktop. This is what slate's absolute coordinates and the OS cursor position are expressed in. */
+	VirtualDesktopPixel,
+
+	Count UMETA(Hidden)
+};
+
+/**
+  * A per axis affine map, Out = In * Scale + Offset.
+  * The main viewport is never rotated or sheared relative to the screen, so this is all that is needed to go between its coordinate spaces.
+  */
+struct FTobiiAxisAlignedAffine
+{
+public:
+	FVector2D Scale;
+	FVector2D Offset;
+
+public:
+	FTobiiAxisAlignedAffine()
+		: Scale(1.0f, 1.0f)
+		, Offset(0.0f, 0.0f)
 	{}
+
+	FTobiiAxisAlignedAffine(const FVector2D& InScale, const FVector2D& InOffset)
+		: Scale(InScale)
+		, Offset(InOffset)
+	{}
+
+	FORCEINLINE FVector2D TransformPoint(const FVector2D& Point) const
+	{
+		return Point * Scale + Offset;
+	}
+
+	bool IsInvertible() const
+	{
+		return !FMath::IsNearlyZero(Scale.X) && !FMath::IsNearlyZero(Scale.Y);
+	}
+
+	FTobiiAxisAlignedAffine Inverse() const
+	{
+		const FVector2D InverseScale(1.0f / Scale.X, 1.0f / Scale.Y);
+		return FTobiiAxisAlignedAffine(InverseScale, -Offset * InverseScale);
+	}
+
+	//The map that applies this one first and then Other.
+	FTobiiAxisAlignedAffine Then(const FTobiiAxisAlignedAffine& Other) const
+	{
+		return FTobiiAxisAlignedAffine(Scale * Other.Scale, Offset * Other.Scale + Other.Offset);
+	}
+};
+
+/**
+  * The maps between every pair of coordinate spaces of the main viewport, composed once per tick by the eye tracker.
+  * Take a copy or a reference once and convert as many points as you like with it, instead of going through the per point conversion functions.
+  */
+USTRUCT(BlueprintType)
+struct FTobiiViewportTransform
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	//If the size of the main viewport in pixels is known. Needed for ViewportPixel.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Viewport Transform")
+	bool bHasViewportPixels;
+	//If the physical size of the main viewport is known. Needed for ViewportCm.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Viewport Transform")
+	bool bHasViewportCm;
+	//If the placement of the main viewport on the virtual desktop is known. Needed for VirtualDesktopPixel.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Viewport Transform")
+	bool bHasVirtualDesktop;
+
+	//Indexed [From][To] by ETobiiCoordinateSpace. Maps involving a space that isn't known have a zero scale.
+	FTobiiAxisAlignedAffine Transforms[(int32)ETobiiCoordinateSpace::Count][(int32)ETobiiCoordinateSpace::Count];
+
+public:
+	FTobiiViewportTransform()
+		: bHasViewportPixels(false)
+		, bHasViewportCm(false)
+		, bHasVirtualDesktop(false)
+	{
+		//Nothing is known until the first Compose, only UNorm to itself.
+		for (int32 FromIdx = 0; FromIdx < (int32)ETobiiCoordinateSpace::Count; FromIdx++)
+		{
+			for (int32 ToIdx = 0; ToIdx < (int32)ETobiiCoordinateSpace::Count; ToIdx++)
+			{
+				Transforms[FromIdx][ToIdx] = FTobiiAxisAlignedAffine(FVector2D::ZeroVector, FVector2D::ZeroVector);
+			}
+		}
+		Transforms[(int32)ETobiiCoordinateSpace::ViewportUNorm][(int32)ETobiiCoordinateSpace::ViewportUNorm] = FTobiiAxisAlignedAffine();
+	}
+
+	bool HasSpace(ETobiiCoordinateSpace Space) const
+	{
+		switch (Space)
+		{
+		case ETobiiCoordinateSpace::ViewportUNorm:			return true;
+		case ETobiiCoordinateSpace::ViewportPixel:			return bHasViewportPixels;
+		case ETobiiCoordinateSpace::ViewportCm:				return bHasViewportCm;
+		case ETobiiCoordinateSpace::VirtualDesktopPixel:	return bHasVirtualDesktop;
+		default:											return false;
+		}
+	}
+
+	bool CanConvert(ETobiiCoordinateSpace From, ETobiiCoordinateSpace To) const
+	{
+		return HasSpace(From) && HasSpace(To);
+	}
+
+	const FTobiiAxisAlignedAffine& GetTransform(ETobiiCoordinateSpace From, ETobiiCoordinateSpace To) const
+	{
+		return Transforms[(int32)From][(int32)To];
+	}
+
+	FORCEINLINE FVector2D Convert(ETobiiCoordinateSpace From, ETobiiCoordinateSpace To, const FVector2D& Point) const
+	{
+		return GetTransform(From, To).TransformPoint(Point);
+	}
+
+	/**
+	  * Converts Num points from In to Out. In and Out may be the same array.
+	  *
+	  * @returns				False if one of the spaces isn't known. Out is filled with zeros in that case.
+	  */
+	bool ConvertPoints(ETobiiCoordinateSpace From, ETobiiCoordinateSpace To, const FVector2D* In, FVector2D* Out, int32 Num) const
+	{
+		const FTobiiAxisAlignedAffine& Transform = GetTransform(From, To);
+		const FVector2D Scale = Transform.Scale;
+		const FVector2D Offset = Transform.Offset;
+		for (int32 PointIdx = 0; PointIdx < Num; PointIdx++)
+		{
+			Out[PointIdx] = In[PointIdx] * Scale + Offset;
+		}
+
+		return CanConvert(From, To);
+	}
+
+	/**
+	  * Composes all maps from how each space relates to ViewportUNorm. Spaces whose map isn't invertible are marked as unknown.
+	  *
+	  * @param UNormToSpace		Map from ViewportUNorm to each space, indexed by ETobiiCoordinateSpace.
+	  */
+	void Compose(const FTobiiAxisAlignedAffine (&UNormToSpace)[(int32)ETobiiCoordinateSpace::Count])
+	{
+		bHasViewportPixels = UNormToSpace[(int32)ETobiiCoordinateSpace::ViewportPixel].IsInvertible();
+		bHasViewportCm = UNormToSpace[(int32)ETobiiCoordinateSpace::ViewportCm].IsInvertible();
+		bHasVirtualDesktop = UNormToSpace[(int32)ETobiiCoordinateSpace::VirtualDesktopPixel].IsInvertible();
+
+		const FTobiiAxisAlignedAffine Unknown(FVector2D::ZeroVector, FVector2D::ZeroVector);
+		for (int32 From = 0; From < (int32)ETobiiCoordinateSpace::Count; From++)
+		{
+			for (int32 To = 0; To < (int32)ETobiiCoordinateSpace::Count; To++)
+			{
+				Transforms[From][To] = CanConvert((ETobiiCoordinateSpace)From, (ETobiiCoordinateSpace)To)
+					? UNormToSpace[From].Inverse().Then(UNormToSpace[To])
+					: Unknown;
+			}
+		}
+	}
 };
 
 /**
@@ -220,3 +427,70 @@ enum class ETobiiGazeTrackerCapability : uint8
 	/** This gaze tracker can deliver individual gaze data for the right eye. */
 	RightGazeData = 4		UMETA(DisplayName = "Supports Right Eye Gaze Data")
 };
+
+/**
+  * The kinds of events in the gaze event stream. Every start is followed by its end before the next start of any kind.
+  */
+UENUM(BlueprintType)
+enum class ETobiiGazeEventType : uint8
+{
+	/** The gaze has stayed put long enough to count as a fixation. The timestamp is when it came to rest, not when it was confirmed. */
+	FixationStart,
+
+	/** The fixation ended, because of a saccade, a blink or tracking loss. */
+	FixationEnd,
+
+	/** The gaze started moving faster than the saccade threshold. */
+	SaccadeStart,
+
+	/** The saccade landed. Carries its amplitude and peak velocity. */
+	SaccadeEnd,
+
+	/** Gaze data stopped coming in, or the eyes closed, while the user was present. */
+	BlinkStart,
+
+	/** Gaze data is back. The duration tells a blink (100 to 400 ms) apart from a longer tracking loss. */
+	BlinkEnd
+};
+
+/**
+  * One event in the gaze event stream. See ITobiiEyeTracker::OnGazeEvent.
+  */
+USTRUCT(BlueprintType)
+struct FTobiiGazeEvent
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Event")
+	ETobiiGazeEventType EventType;
+
+	//When the event happened. For end events, the start was DurationSecs before this.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Event")
+	FDateTime TimeStamp;
+
+	//How long the fixation, saccade or blink lasted. Zero for start events.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Event")
+	float DurationSecs;
+
+	//The fixation's mean gaze point for fixation events, the landing point for SaccadeEnd, and the last known gaze point otherwise.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Event")
+	FVector2D ScreenGazePointPx;
+
+	//Angle between the start and end of the saccade. SaccadeEnd only.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Event")
+	float AmplitudeDegrees;
+
+	//SaccadeEnd only.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gaze Event")
+	float PeakVelocityDegPerSec;
+
+	FTobiiGazeEvent()
+		: EventType(ETobiiGazeEventType::FixationStart)
+		, TimeStamp()
+		, DurationSecs(0.0f)
+		, ScreenGazePointPx(0.0f, 0.0f)
+		, AmplitudeDegrees(0.0f)
+		, PeakVelocityDegPerSec(0.0f)
+	{}
+};
@@ -29,6 +29,8 @@ namespace UnrealBuildTool.Rules
                 , "InputCore"
                 , "InputDevice"					
                 , "HeadMountedDisplay"
+                , "RenderCore"
+                , "RHI"
 			});
 
             PublicDependencyModuleNames.AddRange(new string[]
@@ -6,6 +6,9 @@
 
 #include "STobiiGazeFocusableWidget.h"
 #include "TobiiGTOMBlueprintLibrary.h"
+#include "TobiiGTOMModule.h"
+#include "TobiiGTOMEngine.h"
+#include "TobiiCleanUIController.h"
 
 #include "Engine/Canvas.h"
 #include "Engine/Engine.h"
@@ -14,19 +17,27 @@
 #include "Slate/SceneViewport.h"
 
 
-static TAutoConsoleVariable<int32> CVarEnableCleanUI(TEXT("tobii.EnableCleanUI"), 1, TEXT("0 - CleanUI is disabled. 1 - CleanUI is enabled."));
-static TAutoConsoleVariable<float> CVarCleanUIFadeInTimeSecs(TEXT("tobii.CleanUIFadeInTimeSecs"), 0.0f, TEXT("We want the fade in time to be fairly fast so that the information is instantly available to the user."));
-static TAutoConsoleVariable<float> CVarCleanUIFadeOutTimeSecs(TEXT("tobii.CleanUIFadeOutTimeSecs"), 1.8f, TEXT("The fade out time should be fairly slow however to make sure that it doesn't draw peripheral vision attention."));
-static TAutoConsoleVariable<float> CVarCleanUIMinAlpha(TEXT("tobii.CleanUIMinAlpha"), 0.3f, TEXT("The clean UI won't fade something out beyond this minimum alpha."));
-static TAutoConsoleVariable<float> CVarCleanUIMaxAlpha(TEXT("tobii.CleanUIMaxAlpha"), 1.0f, TEXT("Change this if you don't want the clean UI to increase alpha beyond this point"));
+static FTobiiCleanUIController* GetCleanUIController()
+{
+	if (FTobiiGTOMModule::IsAvailable() && FTobiiGTOMModule::Get().GTOMInputDevice.IsValid())
+	{
+		return &FTobiiGTOMModule::Get().GTOMInputDevice->CleanUIController;
+	}
+
+	return nullptr;
+}
 
 STobiiGazeFocusableWidget::STobiiGazeFocusableWidget()
 	: CleanUIAlpha(1.0f)
+	, bShouldCleanUIFadeIn(true)
+	, bIsCleanUIFadeActive(false)
 	, CleanUIContainersToPollHitsFrom()
+	, CleanUIContainersPollingHitsFromThis()
 {
 	bCanSupportFocus = false;
 
-	SetCanTick(true);
+	//CleanUI fades are advanced centrally by FTobiiCleanUIController, so we have nothing to do per frame.
+	SetCanTick(false);
 }
 
 void STobiiGazeFocusableWidget::Construct(const FArguments& InArgs)
@@ -44,8 +55,29 @@ void STobiiGazeFocusableWidget::Construct(const FArguments& InArgs)
 
 bool STobiiGazeFocusableWidget::HitByGaze()
 { 
-	return UMGWidget.IsValid() && (UMGWidget->CleanUIMode == ETobiiCleanUIMode::FocusExclusive ? 
-		UMGWidget->HasFocus() : UMGWidget->IsInFocusCollection());
+	if (!UMGWidget.IsValid())
+	{
+		return false;
+	}
+
+	FTobiiCleanUIController* CleanUIController = GetCleanUIController();
+	if (CleanUIController != nullptr)
+	{
+		return UMGWidget->CleanUIMode == ETobiiCleanUIMode::FocusExclusive ?
+			CleanUIController->HasTopGazeFocus(UMGWidget.Get()) : CleanUIController->IsInFocusCollection(UMGWidget.Get());
+	}
+
+	return UMGWidget->CleanUIMode == ETobiiCleanUIMode::FocusExclusive ? 
+		UMGWidget->HasFocus() : UMGWidget->IsInFocusCollection();
+}
+
+void STobiiGazeFocusableWidget::RefreshCleanUI()
+{
+	FTobiiCleanUIController* CleanUIController = GetCleanUIController();
+	if (CleanUIController != nullptr)
+	{
+		CleanUIController->RefreshWidget(*this);
+	}
 }
 
 void STobiiGazeFocusableWidget::AddExtraCleanUIContainerToPollHitsFrom(STobiiGazeFocusableWidget* CleanUIContainerToPoll, bool PollGazeHits /*= true*/, bool PollMouseHits /*= true*/)
@@ -57,6 +89,9 @@ void STobiiGazeFocusableWidget::AddExtraCleanUIContainerToPollHitsFrom(STobiiGaz
 		PollingInfo.PollGaze = PollGazeHits;
 		PollingInfo.PollPointer = PollMouseHits;
 		CleanUIContainersToPollHitsFrom.Add(PollingInfo);
+		CleanUIContainerToPoll->CleanUIContainersPollingHitsFromThis.AddUnique(TWeakPtr<SWidget>(AsShared()));
+
+		RefreshCleanUI();
 	}
 }
 
@@ -68,63 +103,12 @@ void STobiiGazeFocusableWidget::RemoveExtraCleanUIContainerToPollHitsFrom(STobii
 		{
 			return !CurCleanUIPollingInfo.CleanUIToPollFrom.IsValid() || CurCleanUIPollingInfo.CleanUIToPollFrom.HasSameObject(CleanUIContainerToStopPolling);
 		});
-	}
-}
-
-void STobiiGazeFocusableWidget::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
-{
-	SWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
-
-	if (!UMGWidget.IsValid()
-		|| UMGWidget->CleanUIMode == ETobiiCleanUIMode::Disabled
-		|| GEngine == nullptr
-		|| GEngine->GameViewport == nullptr 
-		|| GEngine->GameViewport->GetGameViewport() == nullptr
-		|| GetChildren()->Num() == 0)
-	{
-		CleanUIAlpha = 1.0f;
-		return;
-	}
-	
-	bool bTriggerCleanUIOnMouseOver = UMGWidget.IsValid() && UMGWidget->bTriggerCleanUIOnMouseOver;
-	bool bHitByGaze = HitByGaze();
-	bool bShouldFadeIn = bHitByGaze || (bTriggerCleanUIOnMouseOver && bIsHovered);
-
-	// Check if we have any hits on our CleanUIContainersToPollHitsFrom to see if we should still fade in even though we still think we should fade out
-	if (!bShouldFadeIn)
-	{
-		for (CleanUIPollingInfo& PollingInfo : CleanUIContainersToPollHitsFrom)
+		CleanUIContainerToStopPolling->CleanUIContainersPollingHitsFromThis.RemoveAll([=](TWeakPtr<SWidget>& PollingWidget)
 		{
-			if (PollingInfo.CleanUIToPollFrom.IsValid())
-			{
-				TSharedPtr<SWidget> CleanUIWidget = PollingInfo.CleanUIToPollFrom.Pin();
-				STobiiGazeFocusableWidget* CleanUIToPollFrom = (STobiiGazeFocusableWidget*)CleanUIWidget.Get();
-
-				if ((PollingInfo.PollGaze && CleanUIToPollFrom->HitByGaze())
-					|| PollingInfo.PollPointer && bTriggerCleanUIOnMouseOver && CleanUIToPollFrom->bIsHovered)
-				{
-					bShouldFadeIn = true;
-					break;
-				}
-			}
-		}
-	}
-
-	UMGWidget->TimeCleanUIIsSuppressedForSecs = FMath::Max(UMGWidget->TimeCleanUIIsSuppressedForSecs -= InDeltaTime, 0.0f);
-	bool bCleanUISuppressed = UMGWidget->TimeCleanUIIsSuppressedForSecs > FLT_EPSILON;
-	bShouldFadeIn = bShouldFadeIn || bCleanUISuppressed;
+			return !PollingWidget.IsValid() || PollingWidget.HasSameObject(this);
+		});
 
-	float MinAlpha = UMGWidget->CleanUIMinAlphaOverride >= 0.0f ? UMGWidget->CleanUIMinAlphaOverride : CVarCleanUIMinAlpha.GetValueOnAnyThread();
-	float MaxAlpha = UMGWidget->CleanUIMaxAlphaOverride >= 0.0f ? UMGWidget->CleanUIMaxAlphaOverride : CVarCleanUIMaxAlpha.GetValueOnAnyThread();
-	if (bShouldFadeIn)
-	{
-		float FadeInTime = UMGWidget->CleanUIFadeInTimeSecsOverride >= 0.0f ? UMGWidget->CleanUIFadeInTimeSecsOverride : CVarCleanUIFadeInTimeSecs.GetValueOnAnyThread();
-		CleanUIAlpha = FadeInTime > 0.0f ? FMath::Clamp(CleanUIAlpha + InDeltaTime / FadeInTime, MinAlpha, MaxAlpha) : MaxAlpha;
-	}
-	else
-	{
-		float FadeOutTime = UMGWidget->CleanUIFadeOutTimeSecsOverride >= 0.0f ? UMGWidget->CleanUIFadeOutTimeSecsOverride : CVarCleanUIFadeOutTimeSecs.GetValueOnAnyThread();
-		CleanUIAlpha = FadeOutTime > 0.0f ? FMath::Clamp(CleanUIAlpha - InDeltaTime / FadeOutTime, MinAlpha, MaxAlpha) : MinAlpha;
+		RefreshCleanUI();
 	}
 }
 
@@ -140,6 +124,7 @@ void STobiiGazeFocusableWidget::OnMouseEnter(const FGeometry& MyGeometry, const
 	SWidget::OnMouseEnter(MyGeometry, MouseEvent);
 	OnHovered.ExecuteIfBound();
 	Invalidate(EInvalidateWidget::Layout);
+	RefreshCleanUI();
 }
 
 void STobiiGazeFocusableWidget::OnMouseLeave(const FPointerEvent& MouseEvent)
@@ -148,6 +133,7 @@ void STobiiGazeFocusableWidget::OnMouseLeave(const FPointerEvent& MouseEvent)
 	SWidget::OnMouseLeave(MouseEvent);
 	OnUnhovered.ExecuteIfBound();
 	Invalidate(EInvalidateWidget::Layout);
+	RefreshCleanUI();
 }
 
 STobiiGazeFocusableWidget* STobiiGazeFocusableWidget::TryCastToTobiiGazeFocusable(SWidget* Widget)
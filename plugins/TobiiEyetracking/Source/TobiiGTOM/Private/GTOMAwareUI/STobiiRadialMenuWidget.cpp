@@ -68,14 +68,77 @@ int32 STobiiRadialMenuWidget::RemoveSlot(const TSharedRef<SWidget>& SlotWidget)
 	return -1;
 }
 
+const TArray<FTobiiRadialMenuPanelRenderData>& STobiiRadialMenuWidget::UpdatePanelRenderData(const FGeometry& AllottedGeometry) const
+{
+	FTobiiRadialMenuGeometryKey GeometryKey;
+	GeometryKey.LocalSize = AllottedGeometry.GetLocalSize();
+	GeometryKey.RenderTransform = AllottedGeometry.GetAccumulatedRenderTransform();
+	GeometryKey.NrChildren = Children.Num();
+	GeometryKey.VertexCount = VertexCount;
+	GeometryKey.SegmentSeparationPx = SegmentSeparationPx;
+	GeometryKey.BorderThicknessPx = BorderThicknessPx;
+	GeometryKey.AngularDisplacementDeg = AngularDisplacementDeg;
+
+	if (!CachedGeometryKey.IsSet() || !(CachedGeometryKey.GetValue() == GeometryKey))
+	{
+		GeneratePanelRenderData(AllottedGeometry, Children.Num(), CachedChildRenderData);
+		CachedGeometryKey = GeometryKey;
+	}
+
+	for (int32 ChildIndex = 0; ChildIndex < CachedChildRenderData.Num(); ++ChildIndex)
+	{
+		const float ChildAlpha = Children[ChildIndex].AlphaAttr.Get();
+
+		FColor AdjustedBorderColor = BorderColor;
+		AdjustedBorderColor.A *= ChildAlpha;
+		FColor AdjustedPanelColor = PanelColor;
+		AdjustedPanelColor.A *= ChildAlpha;
+
+		ApplyPanelColors(CachedChildRenderData[ChildIndex], AdjustedPanelColor, AdjustedBorderColor, bUseHardBorder);
+	}
+
+	return CachedChildRenderData;
+}
+
+void STobiiRadialMenuWidget::ApplyPanelColors(FTobiiRadialMenuPanelRenderData& RenderData, const FColor& NewPanelColor, const FColor& NewBorderColor, bool bNewHardBorder)
+{
+	if (RenderData.bHasAppliedColors
+		&& RenderData.AppliedPanelColor == NewPanelColor
+		&& RenderData.AppliedBorderColor == NewBorderColor
+		&& RenderData.bAppliedHardBorder == bNewHardBorder)
+	{
+		return;
+	}
+
+	for (FSlateVertex& PanelVertex : RenderData.PanelVertexData)
+	{
+		PanelVertex.Color = NewPanelColor;
+	}
+
+	//The border vertex data is the outer border vertices followed by a copy of the panel vertices.
+	const int32 FirstPanelVertexIdx = RenderData.BorderVertexData.Num() - RenderData.PanelVertexData.Num();
+	const FColor InnerBorderColor = bNewHardBorder ? NewBorderColor : NewPanelColor;
+	for (int32 VertexIdx = 0; VertexIdx < RenderData.BorderVertexData.Num(); VertexIdx++)
+	{
+		RenderData.BorderVertexData[VertexIdx].Color = VertexIdx < FirstPanelVertexIdx ? NewBorderColor : InnerBorderColor;
+	}
+
+	RenderData.bHasAppliedColors = true;
+	RenderData.AppliedPanelColor = NewPanelColor;
+	RenderData.AppliedBorderColor = NewBorderColor;
+	RenderData.bAppliedHardBorder = bNewHardBorder;
+}
+
 void STobiiRadialMenuWidget::GeneratePanelRenderData(const FGeometry& AllottedGeometry, int32 NrChildren, TArray<FTobiiRadialMenuPanelRenderData>& OutChildRenderData) const
 {
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_TobiiEyetracking_RadialMenuTessellate);
+
 	OutChildRenderData.Empty(NrChildren);
 
 	const FVector2D WidgetCenter = AllottedGeometry.GetLocalSize() / 2.0f;
-	const int32 VerticesPerSegment = FMath::Max(VertexCount / Children.Num(), 3);
+	const int32 VerticesPerSegment = FMath::Max(VertexCount / NrChildren, 3);
 	const float ActualRadius = FMath::Min(WidgetCenter.X, WidgetCenter.Y);
-	const float AngleStep = TWO_PI / Children.Num();
+	const float AngleStep = TWO_PI / NrChildren;
 	const float AngleHalfStep = AngleStep / 2.0f;
 	const float AngleMinorStep = AngleStep / VerticesPerSegment;
 	const float HalfSeparation = SegmentSeparationPx / 2.0f;
@@ -93,13 +156,8 @@ void STobiiRadialMenuWidget::GeneratePanelRenderData(const FGeometry& AllottedGe
 	{
 		FTobiiRadialMenuPanelRenderData NewRenderData;
 
-		const STobiiRadialMenuWidget::FSlot& CurChild = Children[ChildIndex];
-		const float ChildAlpha = CurChild.AlphaAttr.Get();
-
-		FColor AdjustedBorderColor = BorderColor;
-		AdjustedBorderColor.A *= ChildAlpha;
-		FColor AdjustedPanelColor = PanelColor;
-		AdjustedPanelColor.A *= ChildAlpha;
+		//Colors are applied separately in ApplyPanelColors since they change far more often than the geometry.
+		const FColor UncoloredVertex = FColor::White;
 
 		//Panel polygon
 		{
@@ -109,7 +167,7 @@ void STobiiRadialMenuWidget::GeneratePanelRenderData(const FGeometry& AllottedGe
 			
 			//First generate the nexus point
 			const FVector2D CenterVertexPosition = WidgetCenter + WidgetCenterToChildCenterDir * NoBorderCenterOffsetDist;
-			FSlateVertex CenterVertex = FSlateVertex::Make<ESlateVertexRounding::Enabled>(AllottedGeometry.GetAccumulatedRenderTransform(), CenterVertexPosition, FVector2D::ZeroVector, AdjustedPanelColor);
+			FSlateVertex CenterVertex = FSlateVertex::Make<ESlateVertexRounding::Enabled>(AllottedGeometry.GetAccumulatedRenderTransform(), CenterVertexPosition, FVector2D::ZeroVector, UncoloredVertex);
 			NewRenderData.PanelVertexData.Add(CenterVertex);
 
 			//Next we need to find our segment extreme points
@@ -125,7 +183,7 @@ void STobiiRadialMenuWidget::GeneratePanelRenderData(const FGeometry& AllottedGe
 				FMath::SinCos(&VertexSine, &VertexCosine, -CurrentAngle);
 
 				const FVector2D SegmentVertexPosition = WidgetCenter + FVector2D(NoBorderRadius * VertexCosine, NoBorderRadius * VertexSine);
-				FSlateVertex SegmentVertex = FSlateVertex::Make<ESlateVertexRounding::Enabled>(AllottedGeometry.GetAccumulatedRenderTransform(), SegmentVertexPosition, FVector2D::ZeroVector, AdjustedPanelColor);
+				FSlateVertex SegmentVertex = FSlateVertex::Make<ESlateVertexRounding::Enabled>(AllottedGeometry.GetAccumulatedRenderTransform(), SegmentVertexPosition, FVector2D::ZeroVector, UncoloredVertex);
 				NewRenderData.PanelVertexData.Add(SegmentVertex);
 			}
 
@@ -146,7 +204,7 @@ void STobiiRadialMenuWidget::GeneratePanelRenderData(const FGeometry& AllottedGe
 
 			//First generate the nexus point
 			const FVector2D CenterVertexPosition = WidgetCenter + WidgetCenterToChildCenterDir * BorderCenterOffsetDist;
-			FSlateVertex CenterVertex = FSlateVertex::Make<ESlateVertexRounding::Enabled>(AllottedGeometry.GetAccumulatedRenderTransform(), CenterVertexPosition, FVector2D::ZeroVector, AdjustedBorderColor);
+			FSlateVertex CenterVertex = FSlateVertex::Make<ESlateVertexRounding::Enabled>(AllottedGeometry.GetAccumulatedRenderTransform(), CenterVertexPosition, FVector2D::ZeroVector, UncoloredVertex);
 			NewRenderData.BorderVertexData.Add(CenterVertex);
 
 			//Next we need to find our segment extreme points
@@ -163,21 +221,13 @@ void STobiiRadialMenuWidget::GeneratePanelRenderData(const FGeometry& AllottedGe
 
 				const FVector2D SegmentVertexPosition = WidgetCenter + FVector2D(ActualRadius * VertexCosine, ActualRadius * VertexSine);
 
-				FSlateVertex SegmentVertex = FSlateVertex::Make<ESlateVertexRounding::Enabled>(AllottedGeometry.GetAccumulatedRenderTransform(), SegmentVertexPosition, FVector2D::ZeroVector, AdjustedBorderColor);
+				FSlateVertex SegmentVertex = FSlateVertex::Make<ESlateVertexRounding::Enabled>(AllottedGeometry.GetAccumulatedRenderTransform(), SegmentVertexPosition, FVector2D::ZeroVector, UncoloredVertex);
 				NewRenderData.BorderVertexData.Add(SegmentVertex);
 			}
 
 			//Add the panel vertices at the end of the array
 			const int32 FirstPanelVertexIdx = NewRenderData.BorderVertexData.Num();
-			for (FSlateVertex SlateVertex : NewRenderData.PanelVertexData)
-			{
-				if (bUseHardBorder)
-				{
-					SlateVertex.Color = AdjustedBorderColor;
-				}
-
-				NewRenderData.BorderVertexData.Add(SlateVertex);
-			}
+			NewRenderData.BorderVertexData.Append(NewRenderData.PanelVertexData);
 
 			//Build indices, building quads from the inner panel outwards
 			for (int32 VertexIdx = 0; VertexIdx < VerticesPerSegment; VertexIdx++)
@@ -259,8 +309,7 @@ int32 STobiiRadialMenuWidget::OnPaint(const FPaintArgs& Args, const FGeometry& A
 	FArrangedChildren ArrangedChildren(EVisibility::Visible);
 	OnArrangeChildren(AllottedGeometry, ArrangedChildren);
 
-	TArray<FTobiiRadialMenuPanelRenderData> ChildRenderData;
-	GeneratePanelRenderData(AllottedGeometry, Children.Num(), ChildRenderData);
+	const TArray<FTobiiRadialMenuPanelRenderData>& ChildRenderData = UpdatePanelRenderData(AllottedGeometry);
 
 	const bool bForwardedEnabled = ShouldBeEnabled(bParentEnabled);
 	const float AngleStep = TWO_PI / Children.Num();
@@ -61,6 +61,8 @@ TSharedRef<SWidget> UTobiiGazeFocusableWidget::RebuildWidget()
 	{
 		Cast<USizeBoxSlot>(GetContentSlot())->BuildSlot(MySizeBox.ToSharedRef());
 	}
+
+	MySlateWidget->RefreshCleanUI();
 	 
 	return MySizeBox.ToSharedRef();
 }
@@ -139,6 +141,20 @@ float UTobiiGazeFocusableWidget::GetCleanUIAlpha()
 	return 1.0f;
 }
 
+void UTobiiGazeFocusableWidget::SuppressCleanUI(float DurationSecs)
+{
+	TimeCleanUIIsSuppressedForSecs = FMath::Max(TimeCleanUIIsSuppressedForSecs, DurationSecs);
+	RefreshCleanUI();
+}
+
+void UTobiiGazeFocusableWidget::RefreshCleanUI()
+{
+	if (MySlateWidget.IsValid())
+	{
+		MySlateWidget->RefreshCleanUI();
+	}
+}
+
 void UTobiiGazeFocusableWidget::AddGazeFocusableWidgetToPollHitsFrom(UTobiiGazeFocusableWidget* GazeFocusableWidgetToPoll, bool PollGazeHits /*= true*/, bool PollMouseHits /*= true*/)
 {
 	if (GazeFocusableWidgetToPoll != nullptr)
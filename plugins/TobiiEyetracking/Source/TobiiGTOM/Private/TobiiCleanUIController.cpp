@@ -0,0 +1,239 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#include "TobiiCleanUIController.h"
+#include "STobiiGazeFocusableWidget.h"
+#include "TobiiGazeFocusableWidget.h"
+
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Slate/SceneViewport.h"
+
+static TAutoConsoleVariable<int32> CVarEnableCleanUI(TEXT("tobii.EnableCleanUI"), 1, TEXT("0 - CleanUI is disabled. 1 - CleanUI is enabled."));
+static TAutoConsoleVariable<float> CVarCleanUIFadeInTimeSecs(TEXT("tobii.CleanUIFadeInTimeSecs"), 0.0f, TEXT("We want the fade in time to be fairly fast so that the information is instantly available to the user."));
+static TAutoConsoleVariable<float> CVarCleanUIFadeOutTimeSecs(TEXT("tobii.CleanUIFadeOutTimeSecs"), 1.8f, TEXT("The fade out time should be fairly slow however to make sure that it doesn't draw peripheral vision attention."));
+static TAutoConsoleVariable<float> CVarCleanUIMinAlpha(TEXT("tobii.CleanUIMinAlpha"), 0.3f, TEXT("The clean UI won't fade something out beyond this minimum alpha."));
+static TAutoConsoleVariable<float> CVarCleanUIMaxAlpha(TEXT("tobii.CleanUIMaxAlpha"), 1.0f, TEXT("Change this if you don't want the clean UI to increase alpha beyond this point"));
+
+static bool IsCleanUIActiveForWidget(STobiiGazeFocusableWidget& Widget)
+{
+	return Widget.UMGWidget.IsValid()
+		&& Widget.UMGWidget->CleanUIMode != ETobiiCleanUIMode::Disabled
+		&& GEngine != nullptr
+		&& GEngine->GameViewport != nullptr
+		&& GEngine->GameViewport->GetGameViewport() != nullptr
+		&& Widget.GetChildren()->Num() > 0;
+}
+
+FTobiiCleanUIController::FTobiiCleanUIController()
+	: TopFocusWidget()
+	, FocusCollectionWidgets()
+	, ActiveFades()
+{
+}
+
+void FTobiiCleanUIController::Tick(float DeltaTimeSecs)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_TobiiEyetracking_CleanUI);
+
+	for (int32 FadeIdx = ActiveFades.Num() - 1; FadeIdx >= 0; FadeIdx--)
+	{
+		TSharedPtr<STobiiGazeFocusableWidget> Widget = ActiveFades[FadeIdx].Pin();
+		if (!Widget.IsValid())
+		{
+			ActiveFades.RemoveAtSwap(FadeIdx);
+			continue;
+		}
+
+		if (!IsCleanUIActiveForWidget(*Widget))
+		{
+			Widget->CleanUIAlpha = 1.0f;
+			Widget->bIsCleanUIFadeActive = false;
+			ActiveFades.RemoveAtSwap(FadeIdx);
+			continue;
+		}
+
+		//Suppression is a timer, so it is the only input that can change without an event telling us about it.
+		bool bCleanUISuppressed = false;
+		if (Widget->UMGWidget->TimeCleanUIIsSuppressedForSecs > FLT_EPSILON)
+		{
+			Widget->UMGWidget->TimeCleanUIIsSuppressedForSecs = FMath::Max(Widget->UMGWidget->TimeCleanUIIsSuppressedForSecs - DeltaTimeSecs, 0.0f);
+			bCleanUISuppressed = Widget->UMGWidget->TimeCleanUIIsSuppressedForSecs > FLT_EPSILON;
+			Widget->bShouldCleanUIFadeIn = ShouldFadeIn(*Widget);
+		}
+
+		const bool bFadeSettled = AdvanceFade(*Widget, DeltaTimeSecs);
+		if (bFadeSettled && !bCleanUISuppressed)
+		{
+			Widget->bIsCleanUIFadeActive = false;
+			ActiveFades.RemoveAtSwap(FadeIdx);
+		}
+	}
+}
+
+void FTobiiCleanUIController::UpdateGazeHits(const TArray<FTobiiGazeFocusData>& FocusData)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_TobiiEyetracking_CleanUI_UpdateGazeHits);
+
+	UTobiiGazeFocusableWidget* NewTopFocusWidget = (FocusData.Num() > 0 && FocusData[0].FocusedWidget.IsValid()) ? FocusData[0].FocusedWidget.Get() : nullptr;
+
+	TMap<FTobiiFocusableUID, TWeakObjectPtr<UTobiiGazeFocusableWidget>> NewFocusCollectionWidgets;
+	for (const FTobiiGazeFocusData& Data : FocusData)
+	{
+		if (Data.FocusedWidget.IsValid())
+		{
+			NewFocusCollectionWidgets.Add(Data.FocusedWidget->GetUniqueID(), Data.FocusedWidget);
+		}
+	}
+
+	//Nothing changed is by far the most common case, so make sure it is cheap.
+	const bool bTopFocusChanged = TopFocusWidget.Get() != NewTopFocusWidget;
+	bool bFocusCollectionChanged = FocusCollectionWidgets.Num() != NewFocusCollectionWidgets.Num();
+	if (!bFocusCollectionChanged)
+	{
+		for (const auto& WidgetPair : NewFocusCollectionWidgets)
+		{
+			if (!FocusCollectionWidgets.Contains(WidgetPair.Key))
+			{
+				bFocusCollectionChanged = true;
+				break;
+			}
+		}
+	}
+
+	if (!bTopFocusChanged && !bFocusCollectionChanged)
+	{
+		return;
+	}
+
+	//Swap in the new state before refreshing so that the evaluation sees it.
+	TWeakObjectPtr<UTobiiGazeFocusableWidget> PreviousTopFocusWidget = TopFocusWidget;
+	TMap<FTobiiFocusableUID, TWeakObjectPtr<UTobiiGazeFocusableWidget>> PreviousFocusCollectionWidgets = MoveTemp(FocusCollectionWidgets);
+	TopFocusWidget = NewTopFocusWidget;
+	FocusCollectionWidgets = MoveTemp(NewFocusCollectionWidgets);
+
+	if (bTopFocusChanged)
+	{
+		RefreshUMGWidget(PreviousTopFocusWidget.Get());
+		RefreshUMGWidget(NewTopFocusWidget);
+	}
+
+	if (bFocusCollectionChanged)
+	{
+		for (const auto& WidgetPair : PreviousFocusCollectionWidgets)
+		{
+			if (!FocusCollectionWidgets.Contains(WidgetPair.Key))
+			{
+				RefreshUMGWidget(WidgetPair.Value.Get());
+			}
+		}
+		for (const auto& WidgetPair : FocusCollectionWidgets)
+		{
+			if (!PreviousFocusCollectionWidgets.Contains(WidgetPair.Key))
+			{
+				RefreshUMGWidget(WidgetPair.Value.Get());
+			}
+		}
+	}
+}
+
+void FTobiiCleanUIController::RefreshWidget(STobiiGazeFocusableWidget& Widget)
+{
+	EvaluateWidget(Widget);
+
+	for (int32 DependentIdx = Widget.CleanUIContainersPollingHitsFromThis.Num() - 1; DependentIdx >= 0; DependentIdx--)
+	{
+		TSharedPtr<SWidget> DependentWidget = Widget.CleanUIContainersPollingHitsFromThis[DependentIdx].Pin();
+		if (DependentWidget.IsValid())
+		{
+			EvaluateWidget(*(STobiiGazeFocusableWidget*)DependentWidget.Get());
+		}
+		else
+		{
+			Widget.CleanUIContainersPollingHitsFromThis.RemoveAtSwap(DependentIdx);
+		}
+	}
+}
+
+bool FTobiiCleanUIController::HasTopGazeFocus(const UTobiiGazeFocusableWidget* Widget) const
+{
+	return Widget != nullptr && TopFocusWidget.Get() == Widget;
+}
+
+bool FTobiiCleanUIController::IsInFocusCollection(const UTobiiGazeFocusableWidget* Widget) const
+{
+	return Widget != nullptr && FocusCollectionWidgets.Contains(Widget->GetUniqueID());
+}
+
+void FTobiiCleanUIController::RefreshUMGWidget(UTobiiGazeFocusableWidget* Widget)
+{
+	if (Widget != nullptr && Widget->GetSlateGazeFocusableWidget() != nullptr)
+	{
+		RefreshWidget(*Widget->GetSlateGazeFocusableWidget());
+	}
+}
+
+void FTobiiCleanUIController::EvaluateWidget(STobiiGazeFocusableWidget& Widget)
+{
+	if (!IsCleanUIActiveForWidget(Widget))
+	{
+		Widget.CleanUIAlpha = 1.0f;
+		return;
+	}
+
+	Widget.bShouldCleanUIFadeIn = ShouldFadeIn(Widget);
+
+	if (!Widget.bIsCleanUIFadeActive)
+	{
+		Widget.bIsCleanUIFadeActive = true;
+		ActiveFades.Add(StaticCastSharedRef<STobiiGazeFocusableWidget>(Widget.AsShared()));
+	}
+}
+
+bool FTobiiCleanUIController::ShouldFadeIn(STobiiGazeFocusableWidget& Widget) const
+{
+	const bool bTriggerCleanUIOnMouseOver = Widget.UMGWidget->bTriggerCleanUIOnMouseOver;
+	if (Widget.HitByGaze() || (bTriggerCleanUIOnMouseOver && Widget.IsHoveredByPointer()))
+	{
+		return true;
+	}
+
+	//Check if we have any hits on our CleanUIContainersToPollHitsFrom to see if we should still fade in even though we still think we should fade out
+	for (const STobiiGazeFocusableWidget::CleanUIPollingInfo& PollingInfo : Widget.CleanUIContainersToPollHitsFrom)
+	{
+		TSharedPtr<SWidget> CleanUIWidget = PollingInfo.CleanUIToPollFrom.Pin();
+		if (CleanUIWidget.IsValid())
+		{
+			STobiiGazeFocusableWidget* CleanUIToPollFrom = (STobiiGazeFocusableWidget*)CleanUIWidget.Get();
+			if ((PollingInfo.PollGaze && CleanUIToPollFrom->HitByGaze())
+				|| (PollingInfo.PollPointer && bTriggerCleanUIOnMouseOver && CleanUIToPollFrom->IsHoveredByPointer()))
+			{
+				return true;
+			}
+		}
+	}
+
+	return Widget.UMGWidget->TimeCleanUIIsSuppressedForSecs > FLT_EPSILON;
+}
+
+bool FTobiiCleanUIController::AdvanceFade(STobiiGazeFocusableWidget& Widget, float DeltaTimeSecs) const
+{
+	UTobiiGazeFocusableWidget* UMGWidget = Widget.UMGWidget.Get();
+	const float MinAlpha = UMGWidget->CleanUIMinAlphaOverride >= 0.0f ? UMGWidget->CleanUIMinAlphaOverride : CVarCleanUIMinAlpha.GetValueOnAnyThread();
+	const float MaxAlpha = UMGWidget->CleanUIMaxAlphaOverride >= 0.0f ? UMGWidget->CleanUIMaxAlphaOverride : CVarCleanUIMaxAlpha.GetValueOnAnyThread();
+	if (Widget.bShouldCleanUIFadeIn)
+	{
+		const float FadeInTime = UMGWidget->CleanUIFadeInTimeSecsOverride >= 0.0f ? UMGWidget->CleanUIFadeInTimeSecsOverride : CVarCleanUIFadeInTimeSecs.GetValueOnAnyThread();
+		Widget.CleanUIAlpha = FadeInTime > 0.0f ? FMath::Clamp(Widget.CleanUIAlpha + DeltaTimeSecs / FadeInTime, MinAlpha, MaxAlpha) : MaxAlpha;
+		return Widget.CleanUIAlpha >= MaxAlpha;
+	}
+	else
+	{
+		const float FadeOutTime = UMGWidget->CleanUIFadeOutTimeSecsOverride >= 0.0f ? UMGWidget->CleanUIFadeOutTimeSecsOverride : CVarCleanUIFadeOutTimeSecs.GetValueOnAnyThread();
+		Widget.CleanUIAlpha = FadeOutTime > 0.0f ? FMath::Clamp(Widget.CleanUIAlpha - DeltaTimeSecs / FadeOutTime, MinAlpha, MaxAlpha) : MinAlpha;
+		return Widget.CleanUIAlpha <= MinAlpha;
+	}
+}
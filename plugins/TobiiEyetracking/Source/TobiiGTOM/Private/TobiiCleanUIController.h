@@ -0,0 +1,49 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#pragma once
+
+#include "TobiiGTOMTypes.h"
+
+#include "CoreMinimal.h"
+
+class STobiiGazeFocusableWidget;
+class UTobiiGazeFocusableWidget;
+
+/**
+  * Drives CleanUI for all gaze focusable widgets from one place.
+  * Instead of having every widget poll GTOM in its own tick, the GTOM engine hands us the focus results once per frame.
+  * We diff them against the previous frame and only re-evaluate the widgets whose gaze state actually changed (and the widgets that poll them).
+  * Widgets that still have somewhere to fade to are kept in a single list that is advanced once per frame, and are dropped from it once they settle.
+  */
+class FTobiiCleanUIController
+{
+public:
+	FTobiiCleanUIController();
+
+	//Advances all active fades. Should be called once per frame.
+	void Tick(float DeltaTimeSecs);
+
+	//Should be called whenever GTOM has produced new focus results.
+	void UpdateGazeHits(const TArray<FTobiiGazeFocusData>& FocusData);
+
+	//Re-evaluates the CleanUI state of a widget and of all widgets that poll hits from it. Call this whenever any input to the CleanUI state of the widget changes.
+	void RefreshWidget(STobiiGazeFocusableWidget& Widget);
+
+	bool HasTopGazeFocus(const UTobiiGazeFocusableWidget* Widget) const;
+	bool IsInFocusCollection(const UTobiiGazeFocusableWidget* Widget) const;
+
+private:
+	TWeakObjectPtr<UTobiiGazeFocusableWidget> TopFocusWidget;
+	TMap<FTobiiFocusableUID, TWeakObjectPtr<UTobiiGazeFocusableWidget>> FocusCollectionWidgets;
+
+	TArray<TWeakPtr<STobiiGazeFocusableWidget>> ActiveFades;
+
+	void RefreshUMGWidget(UTobiiGazeFocusableWidget* Widget);
+	void EvaluateWidget(STobiiGazeFocusableWidget& Widget);
+	bool ShouldFadeIn(STobiiGazeFocusableWidget& Widget) const;
+	bool AdvanceFade(STobiiGazeFocusableWidget& Widget, float DeltaTimeSecs) const;
+};
@@ -0,0 +1,218 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#include "TobiiGTOMAttentionLedger.h"
+#include "TobiiGazeFocusableWidget.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+#include "Misc/FileHelper.h"
+
+static const float GTobiiAttentionLedgerCompactionIntervalSecs = 5.0f;
+
+FTobiiGTOMAttentionLedger::FTobiiGTOMAttentionLedger()
+	: ElapsedSecs(0.0f)
+	, SecsSinceCompaction(0.0f)
+	, CurrentFocusId(0)
+	, bHasCurrentFocus(false)
+{
+	Rehash(MinNumSlots);
+}
+
+void FTobiiGTOMAttentionLedger::Tick(float DeltaTimeSecs, const FTobiiGazeFocusData* TopFocusData)
+{
+	ElapsedSecs += DeltaTimeSecs;
+	SecsSinceCompaction += DeltaTimeSecs;
+	if (SecsSinceCompaction >= GTobiiAttentionLedgerCompactionIntervalSecs)
+	{
+		Compact();
+	}
+
+	//A world space widget's focus data has both the widget and its host component. The widget is what was looked at.
+	UObject* Focusable = nullptr;
+	if (TopFocusData != nullptr && TopFocusData->FocusedWidget.IsValid())
+	{
+		Focusable = TopFocusData->FocusedWidget.Get();
+	}
+	else if (TopFocusData != nullptr && TopFocusData->FocusedPrimitiveComponent.IsValid())
+	{
+		Focusable = TopFocusData->FocusedPrimitiveComponent.Get();
+	}
+
+	if (Focusable == nullptr)
+	{
+		bHasCurrentFocus = false;
+		return;
+	}
+
+	const FTobiiFocusableUID FocusableId = Focusable->GetUniqueID();
+	bool bWasAdded = false;
+	FEntry& Entry = FindOrAddEntry(FocusableId, bWasAdded);
+	if (!bWasAdded && !Entry.Focusable.IsValid())
+	{
+		//Object indices are reused. The old focusable is gone, so it is retired here rather than waiting for the next compaction.
+		DestroyedStats.Add(MakeStats(Entry));
+		bWasAdded = true;
+	}
+
+	if (bWasAdded)
+	{
+		UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(Focusable);
+		Entry.Focusable = Focusable;
+		Entry.Name = PrimitiveComponent != nullptr && PrimitiveComponent->GetOwner() != nullptr
+			? FString::Printf(TEXT("%s.%s"), *PrimitiveComponent->GetOwner()->GetName(), *PrimitiveComponent->GetName())
+			: Focusable->GetName();
+		Entry.DwellSecs = 0.0f;
+		Entry.NumVisits = 0;
+		Entry.TimeToFirstFocusSecs = ElapsedSecs - DeltaTimeSecs;
+		Entry.ConfidenceSecs = 0.0f;
+	}
+
+	if (!bHasCurrentFocus || CurrentFocusId != FocusableId)
+	{
+		Entry.NumVisits++;
+		CurrentFocusId = FocusableId;
+		bHasCurrentFocus = true;
+	}
+
+	Entry.DwellSecs += DeltaTimeSecs;
+	Entry.ConfidenceSecs += TopFocusData->FocusConfidence * DeltaTimeSecs;
+}
+
+void FTobiiGTOMAttentionLedger::Reset()
+{
+	Entries.Empty();
+	DestroyedStats.Empty();
+	Rehash(MinNumSlots);
+	ElapsedSecs = 0.0f;
+	SecsSinceCompaction = 0.0f;
+	bHasCurrentFocus = false;
+}
+
+bool FTobiiGTOMAttentionLedger::FindStats(FTobiiFocusableUID FocusableId, FTobiiAttentionStats& OutStats) const
+{
+	const int32 EntryIdx = Slots[FindSlot(FocusableId)];
+	if (EntryIdx == INDEX_NONE || !Entries[EntryIdx].Focusable.IsValid())
+	{
+		return false;
+	}
+
+	OutStats = MakeStats(Entries[EntryIdx]);
+	return true;
+}
+
+void FTobiiGTOMAttentionLedger::GetAllStats(TArray<FTobiiAttentionStats>& OutStats) const
+{
+	OutStats.Reset(Entries.Num() + DestroyedStats.Num());
+	for (const FEntry& Entry : Entries)
+	{
+		OutStats.Add(MakeStats(Entry));
+	}
+	OutStats.Append(DestroyedStats);
+	OutStats.Sort([](const FTobiiAttentionStats& A, const FTobiiAttentionStats& B) { return A.DwellSecs > B.DwellSecs; });
+}
+
+bool FTobiiGTOMAttentionLedger::ExportCSV(const FString& FilePath) const
+{
+	TArray<FTobiiAttentionStats> AllStats;
+	GetAllStats(AllStats);
+
+	FString CSV = TEXT("Name,DwellSecs,NumVisits,TimeToFirstFocusSecs,AverageFocusConfidence,IsDestroyed");
+	CSV += LINE_TERMINATOR;
+	for (const FTobiiAttentionStats& Stats : AllStats)
+	{
+		CSV += FString::Printf(TEXT("\"%s\",%.4f,%d,%.4f,%.4f,%d"), *Stats.Name.Replace(TEXT("\""), TEXT("\"\"")), Stats.DwellSecs, Stats.NumVisits, Stats.TimeToFirstFocusSecs, Stats.AverageFocusConfidence, Stats.bIsDestroyed ? 1 : 0);
+		CSV += LINE_TERMINATOR;
+	}
+
+	return FFileHelper::SaveStringToFile(CSV, *FilePath);
+}
+
+int32 FTobiiGTOMAttentionLedger::FindSlot(FTobiiFocusableUID FocusableId) const
+{
+	//Object indices are handed out roughly in order, so they are spread with a Fibonacci hash. Its high bits are the well mixed ones.
+	const uint32 SlotMask = (uint32)Slots.Num() - 1;
+	uint32 SlotIdx = (FocusableId * 2654435769u) >> (32 - FMath::FloorLog2((uint32)Slots.Num()));
+	while (Slots[SlotIdx] != INDEX_NONE && Entries[Slots[SlotIdx]].Id != FocusableId)
+	{
+		SlotIdx = (SlotIdx + 1) & SlotMask;
+	}
+	return (int32)SlotIdx;
+}
+
+FTobiiGTOMAttentionLedger::FEntry& FTobiiGTOMAttentionLedger::FindOrAddEntry(FTobiiFocusableUID FocusableId, bool& bOutWasAdded)
+{
+	int32 SlotIdx = FindSlot(FocusableId);
+	bOutWasAdded = Slots[SlotIdx] == INDEX_NONE;
+	if (!bOutWasAdded)
+	{
+		return Entries[Slots[SlotIdx]];
+	}
+
+	if ((Entries.Num() + 1) * 2 > Slots.Num())
+	{
+		Rehash(Slots.Num() * 2);
+		SlotIdx = FindSlot(FocusableId);
+	}
+
+	Slots[SlotIdx] = Entries.AddDefaulted();
+	FEntry& Entry = Entries.Last();
+	Entry.Id = FocusableId;
+	return Entry;
+}
+
+void FTobiiGTOMAttentionLedger::Rehash(int32 NumSlots)
+{
+	Slots.Init(INDEX_NONE, FMath::RoundUpToPowerOfTwo(FMath::Max(NumSlots, (int32)MinNumSlots)));
+	for (int32 EntryIdx = 0; EntryIdx < Entries.Num(); EntryIdx++)
+	{
+		Slots[FindSlot(Entries[EntryIdx].Id)] = EntryIdx;
+	}
+}
+
+void FTobiiGTOMAttentionLedger::Compact()
+{
+	SecsSinceCompaction = 0.0f;
+
+	int32 NumLiveEntries = 0;
+	for (int32 EntryIdx = 0; EntryIdx < Entries.Num(); EntryIdx++)
+	{
+		if (Entries[EntryIdx].Focusable.IsValid())
+		{
+			if (NumLiveEntries != EntryIdx)
+			{
+				Entries[NumLiveEntries] = MoveTemp(Entries[EntryIdx]);
+			}
+			NumLiveEntries++;
+		}
+		else
+		{
+			DestroyedStats.Add(MakeStats(Entries[EntryIdx]));
+		}
+	}
+
+	if (NumLiveEntries == Entries.Num())
+	{
+		return;
+	}
+
+	//Linear probing can't just clear a slot, so the table is rebuilt at the smallest size that keeps it half empty.
+	Entries.SetNum(NumLiveEntries);
+	Rehash(NumLiveEntries * 2);
+}
+
+FTobiiAttentionStats FTobiiGTOMAttentionLedger::MakeStats(const FEntry& Entry)
+{
+	FTobiiAttentionStats Stats;
+	Stats.Focusable = Entry.Focusable;
+	Stats.Name = Entry.Name;
+	Stats.DwellSecs = Entry.DwellSecs;
+	Stats.NumVisits = Entry.NumVisits;
+	Stats.TimeToFirstFocusSecs = Entry.TimeToFirstFocusSecs;
+	Stats.AverageFocusConfidence = Entry.DwellSecs > 0.0f ? Entry.ConfidenceSecs / Entry.DwellSecs : 0.0f;
+	Stats.bIsDestroyed = !Entry.Focusable.IsValid();
+	return Stats;
+}
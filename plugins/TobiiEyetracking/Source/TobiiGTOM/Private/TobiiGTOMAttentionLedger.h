@@ -0,0 +1,72 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#pragma once
+
+#include "TobiiGTOMTypes.h"
+
+#include "CoreMinimal.h"
+
+/**
+  * Accumulates attention statistics for every focusable that has been GTOM's top focus.
+  * Lookups happen every frame, so the stats live in a dense array indexed by a small open addressing table (linear probing, power of two size) instead of a TMap.
+  * Focusables that are destroyed are moved out of the table every few seconds, so the table only grows with what is alive and their stats are still reported.
+  */
+class FTobiiGTOMAttentionLedger
+{
+public:
+	FTobiiGTOMAttentionLedger();
+
+	/**
+	  * Add a frame of attention.
+	  *
+	  * @param DeltaTimeSecs		Length of the frame.
+	  * @param TopFocusData			GTOM's top focus this frame, or null if nothing was focused.
+	  */
+	void Tick(float DeltaTimeSecs, const FTobiiGazeFocusData* TopFocusData);
+
+	/** Forget everything and restart the clock for time to first focus. */
+	void Reset();
+
+	/** @returns					True if the focusable has been the top focus since the last reset. */
+	bool FindStats(FTobiiFocusableUID FocusableId, FTobiiAttentionStats& OutStats) const;
+
+	/** Stats for live and destroyed focusables, longest dwell first. */
+	void GetAllStats(TArray<FTobiiAttentionStats>& OutStats) const;
+
+	/** Write all stats as CSV with a header line. */
+	bool ExportCSV(const FString& FilePath) const;
+
+private:
+	struct FEntry
+	{
+		FTobiiFocusableUID Id;
+		TWeakObjectPtr<UObject> Focusable;
+		FString Name;
+		float DwellSecs;
+		int32 NumVisits;
+		float TimeToFirstFocusSecs;
+		float ConfidenceSecs;
+	};
+
+	enum { MinNumSlots = 64 };
+
+	//Indices into Entries, INDEX_NONE for empty slots. Never more than half full so probes stay short.
+	TArray<int32> Slots;
+	TArray<FEntry> Entries;
+	TArray<FTobiiAttentionStats> DestroyedStats;
+
+	float ElapsedSecs;
+	float SecsSinceCompaction;
+	FTobiiFocusableUID CurrentFocusId;
+	bool bHasCurrentFocus;
+
+	int32 FindSlot(FTobiiFocusableUID FocusableId) const;
+	FEntry& FindOrAddEntry(FTobiiFocusableUID FocusableId, bool& bOutWasAdded);
+	void Rehash(int32 NumSlots);
+	void Compact();
+	static FTobiiAttentionStats MakeStats(const FEntry& Entry);
+};
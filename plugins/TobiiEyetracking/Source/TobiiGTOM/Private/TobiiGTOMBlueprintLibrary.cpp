@@ -134,6 +134,43 @@ bool UTobiiGTOMBlueprintLibrary::GetAllFilteredGazeFocusData(const TArray<FName>
 	return OutFocusData.Num() > 0;
 }
 
+bool UTobiiGTOMBlueprintLibrary::GetAttentionStats(UObject* Focusable, FTobiiAttentionStats& OutStats)
+{
+	if (Focusable != nullptr && FTobiiGTOMModule::IsAvailable() && FTobiiGTOMModule::Get().GTOMInputDevice.IsValid())
+	{
+		return FTobiiGTOMModule::Get().GTOMInputDevice->AttentionLedger.FindStats(Focusable->GetUniqueID(), OutStats);
+	}
+
+	return false;
+}
+
+void UTobiiGTOMBlueprintLibrary::GetAllAttentionStats(TArray<FTobiiAttentionStats>& OutStats)
+{
+	OutStats.Empty();
+	if (FTobiiGTOMModule::IsAvailable() && FTobiiGTOMModule::Get().GTOMInputDevice.IsValid())
+	{
+		FTobiiGTOMModule::Get().GTOMInputDevice->AttentionLedger.GetAllStats(OutStats);
+	}
+}
+
+void UTobiiGTOMBlueprintLibrary::ResetAttentionStats()
+{
+	if (FTobiiGTOMModule::IsAvailable() && FTobiiGTOMModule::Get().GTOMInputDevice.IsValid())
+	{
+		FTobiiGTOMModule::Get().GTOMInputDevice->AttentionLedger.Reset();
+	}
+}
+
+bool UTobiiGTOMBlueprintLibrary::ExportAttentionStatsCSV(const FString& FilePath)
+{
+	if (FTobiiGTOMModule::IsAvailable() && FTobiiGTOMModule::Get().GTOMInputDevice.IsValid())
+	{
+		return FTobiiGTOMModule::Get().GTOMInputDevice->AttentionLedger.ExportCSV(FilePath);
+	}
+
+	return false;
+}
+
 void UTobiiGTOMBlueprintLibrary::RegisterScreenSpaceGazeFocusableWidgets(UWidget* Root)
 {
 	UUserWidget* UserWidget = Cast<UUserWidget>(Root);
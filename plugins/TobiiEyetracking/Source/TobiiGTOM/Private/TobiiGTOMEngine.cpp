@@ -8,6 +8,7 @@
 #include "TobiiGazeFocusableComponent.h"
 #include "TobiiGazeFocusableWidget.h"
 #include "TobiiGTOMBlueprintLibrary.h"
+#include "TobiiGazeHeatmap.h"
 #include "TobiiGTOMInternalTypes.h"
 
 #include "Engine/Engine.h"
@@ -40,6 +41,9 @@ void FTobiiGTOMEngine::Tick(float DeltaTimeSecs)
 	static const auto MaximumTraceDistanceCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("tobii.MaximumTraceDistance"));
 	static const auto FocusTraceChannelCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("tobii.FocusTraceChannel"));
 
+	//CleanUI fades must keep running even if we can't produce new focus data this frame.
+	CleanUIController.Tick(DeltaTimeSecs);
+
 	if (GEngine == nullptr 
 		|| GEngine->GameViewport == nullptr
 		|| GEngine->GameViewport->GetWorld() == nullptr
@@ -381,8 +385,12 @@ void FTobiiGTOMEngine::Tick(float DeltaTimeSecs)
 	{
 		QUICK_SCOPE_CYCLE_COUNTER(STAT_TobiiEyetracking_GTOM_G2OMNotify);
 		UpdateWinners(NewTopFocusPrimitive, NewTopFocusWidget);
+		CleanUIController.UpdateGazeHits(G2OMFocusResults);
 	}
 
+	AttentionLedger.Tick(DeltaTimeSecs, G2OMFocusResults.Num() > 0 ? &G2OMFocusResults[0] : nullptr);
+	UTobiiGazeHeatmap::TickHeatmaps(DeltaTimeSecs, GTOMPlayerController.Get(), CombinedGazeData, ScreenGazePointPx, ViewportSize);
+
 	if (DrawDebugCVar->GetInt() && CVarDebugDisplayG2OMCandidateSet.GetValueOnGameThread() != 0)
 	{
 		for (g2om_candidate& Candidate : Candidates)
@@ -628,4 +636,5 @@ void FTobiiGTOMEngine::EmulateGazeFocus(TArray<FTobiiGazeFocusData>& EmulatedFoc
 	}
 
 	UpdateWinners(TopPrimitive, TopWidget);
+	CleanUIController.UpdateGazeHits(G2OMFocusResults);
 }
@@ -7,6 +7,8 @@
 #pragma once
 
 #include "TobiiGTOMOcclusionTester.h"
+#include "TobiiCleanUIController.h"
+#include "TobiiGTOMAttentionLedger.h"
 #include "TobiiGazeFocusableWidget.h"
 #include "TobiiGTOMTypes.h"
 #include "tobii_g2om.h"
@@ -22,6 +24,8 @@ public:
 
 	FHitResult CombinedWorldGazeHitData;
 	TWeakObjectPtr<APlayerController> GTOMPlayerController;
+	FTobiiCleanUIController CleanUIController;
+	FTobiiGTOMAttentionLedger AttentionLedger;
 
 	const TArray<FTobiiGazeFocusData>& GetFocusData() { return G2OMFocusResults; }
 	void EmulateGazeFocus(TArray<FTobiiGazeFocusData>& EmulatedFocusData);
@@ -0,0 +1,171 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#include "TobiiGazeHeatmap.h"
+#include "TobiiGazeHeatmapWorker.h"
+#include "TobiiGTOMModule.h"
+#include "TobiiGTOMEngine.h"
+
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "UObject/Package.h"
+
+static TArray<TWeakObjectPtr<UTobiiGazeHeatmap>> GActiveTobiiGazeHeatmaps;
+
+UTobiiGazeHeatmap::UTobiiGazeHeatmap()
+	: bIsPaused(false)
+	, Worker(nullptr)
+	, RecordedSecs(0.0f)
+{
+}
+
+UTobiiGazeHeatmap* UTobiiGazeHeatmap::CreateGazeHeatmap(int32 Width /*= 256*/, int32 Height /*= 144*/)
+{
+	UTobiiGazeHeatmap* Heatmap = NewObject<UTobiiGazeHeatmap>(GetTransientPackage());
+	Heatmap->Worker = new FTobiiGazeHeatmapWorker(FMath::Max(Width, 1), FMath::Max(Height, 1));
+	GActiveTobiiGazeHeatmaps.Add(Heatmap);
+	return Heatmap;
+}
+
+void UTobiiGazeHeatmap::StopRecording()
+{
+	GActiveTobiiGazeHeatmaps.Remove(this);
+}
+
+void UTobiiGazeHeatmap::ResetHeatmap()
+{
+	if (Worker != nullptr)
+	{
+		Worker->Reset();
+	}
+
+	RecordedSecs = 0.0f;
+}
+
+void UTobiiGazeHeatmap::GetHeatmapSnapshot(TArray<float>& OutSeconds, int32& OutWidth, int32& OutHeight) const
+{
+	if (Worker == nullptr)
+	{
+		OutSeconds.Empty();
+		OutWidth = OutHeight = 0;
+		return;
+	}
+
+	Worker->CopyToSeconds(OutSeconds, OutWidth, OutHeight);
+}
+
+TArray<FTobiiAttentionStats> UTobiiGazeHeatmap::GetDwellTimes() const
+{
+	//GTOM keeps one account of what held the top focus, so the heatmap and the attention stats can't disagree.
+	TArray<FTobiiAttentionStats> DwellTimes;
+	if (FTobiiGTOMModule::IsAvailable() && FTobiiGTOMModule::Get().GTOMInputDevice.IsValid())
+	{
+		FTobiiGTOMModule::Get().GTOMInputDevice->AttentionLedger.GetAllStats(DwellTimes);
+	}
+	return DwellTimes;
+}
+
+bool UTobiiGazeHeatmap::ExportHeatmapCSV(const FString& FilePath) const
+{
+	TArray<float> Seconds;
+	int32 Width, Height;
+	GetHeatmapSnapshot(Seconds, Width, Height);
+
+	FString CSV;
+	CSV.Reserve(Width * Height * 8);
+	for (int32 Y = 0; Y < Height; Y++)
+	{
+		for (int32 X = 0; X < Width; X++)
+		{
+			if (X > 0)
+			{
+				CSV += TEXT(",");
+			}
+			CSV += FString::Printf(TEXT("%.4f"), Seconds[Y * Width + X]);
+		}
+		CSV += LINE_TERMINATOR;
+	}
+
+	return FFileHelper::SaveStringToFile(CSV, *FilePath);
+}
+
+bool UTobiiGazeHeatmap::ExportDwellTimesCSV(const FString& FilePath) const
+{
+	if (FTobiiGTOMModule::IsAvailable() && FTobiiGTOMModule::Get().GTOMInputDevice.IsValid())
+	{
+		return FTobiiGTOMModule::Get().GTOMInputDevice->AttentionLedger.ExportCSV(FilePath);
+	}
+
+	return false;
+}
+
+void UTobiiGazeHeatmap::BeginDestroy()
+{
+	GActiveTobiiGazeHeatmaps.Remove(this);
+
+	//Joins the worker thread.
+	delete Worker;
+	Worker = nullptr;
+
+	Super::BeginDestroy();
+}
+
+void UTobiiGazeHeatmap::TickHeatmaps(float DeltaTimeSecs, APlayerController* PlayerController, const FEyeTrackerGazeData& GazeData, const FVector2D& ScreenGazePointPx, const FVector2D& ViewportSize)
+{
+	if (GActiveTobiiGazeHeatmaps.Num() == 0 || PlayerController == nullptr || PlayerController->PlayerCameraManager == nullptr)
+	{
+		return;
+	}
+
+	if (GazeData.ConfidenceValue < 0.5f || ViewportSize.X <= 0.0f || ViewportSize.Y <= 0.0f)
+	{
+		return;
+	}
+
+	//We only see the engine's eye tracker interface here, so the foveal region is found by projecting the edge of the foveal cone the same way the gaze point is.
+	static const auto FovealConeAngleCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("tobii.FovealConeAngleDegrees"));
+	const float FovealConeAngleDeg = FovealConeAngleCVar != nullptr ? FMath::Max(FovealConeAngleCVar->GetFloat(), 0.0f) : 5.0f;
+	const FRotator CameraRotation = PlayerController->PlayerCameraManager->GetCameraRotation();
+	const FVector CameraRight = FRotationMatrix(CameraRotation).GetScaledAxis(EAxis::Y);
+	const FVector CameraUp = FRotationMatrix(CameraRotation).GetScaledAxis(EAxis::Z);
+
+	FVector2D FovealEdgeXPx, FovealEdgeYPx;
+	const FVector GazeDirection = GazeData.GazeDirection.GetSafeNormal();
+	PlayerController->ProjectWorldLocationToScreen(GazeData.GazeOrigin + GazeDirection.RotateAngleAxis(FovealConeAngleDeg, CameraUp) * 10.0f, FovealEdgeXPx);
+	PlayerController->ProjectWorldLocationToScreen(GazeData.GazeOrigin + GazeDirection.RotateAngleAxis(FovealConeAngleDeg, CameraRight) * 10.0f, FovealEdgeYPx);
+
+	const FVector2D GazePointUNorm(ScreenGazePointPx.X / ViewportSize.X, ScreenGazePointPx.Y / ViewportSize.Y);
+	const FVector2D FovealRadiiUNorm(FMath::Abs(FovealEdgeXPx.X - ScreenGazePointPx.X) / ViewportSize.X, FMath::Abs(FovealEdgeYPx.Y - ScreenGazePointPx.Y) / ViewportSize.Y);
+
+	for (int32 HeatmapIdx = GActiveTobiiGazeHeatmaps.Num() - 1; HeatmapIdx >= 0; HeatmapIdx--)
+	{
+		UTobiiGazeHeatmap* Heatmap = GActiveTobiiGazeHeatmaps[HeatmapIdx].Get();
+		if (Heatmap == nullptr)
+		{
+			GActiveTobiiGazeHeatmaps.RemoveAtSwap(HeatmapIdx);
+			continue;
+		}
+
+		Heatmap->Record(DeltaTimeSecs, GazePointUNorm, FovealRadiiUNorm);
+	}
+}
+
+void UTobiiGazeHeatmap::Record(float DeltaTimeSecs, const FVector2D& GazePointUNorm, const FVector2D& FovealRadiiUNorm)
+{
+	if (bIsPaused || Worker == nullptr)
+	{
+		return;
+	}
+
+	FTobiiGazeHeatmapSample Sample;
+	Sample.GazePointUNorm = GazePointUNorm;
+	Sample.FovealRadiiUNorm = FovealRadiiUNorm;
+	Sample.DurationSecs = DeltaTimeSecs;
+	Worker->AddSample(Sample);
+	RecordedSecs += DeltaTimeSecs;
+}
@@ -0,0 +1,204 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#include "TobiiGazeHeatmapWorker.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/ScopeLock.h"
+
+FTobiiGazeHeatmapGrid::FTobiiGazeHeatmapGrid(int32 InWidth, int32 InHeight)
+	: Width(FMath::Max(InWidth, 1))
+	, Height(FMath::Max(InHeight, 1))
+{
+	NumTilesX = FMath::DivideAndRoundUp(Width, (int32)TileSize);
+	NumTilesY = FMath::DivideAndRoundUp(Height, (int32)TileSize);
+	Tiles.SetNum(NumTilesX * NumTilesY);
+}
+
+void FTobiiGazeHeatmapGrid::Splat(const FVector2D& CenterUNorm, const FVector2D& RadiiUNorm, float WeightSecs)
+{
+	const uint32 PeakFixedPoint = (uint32)FMath::Clamp(WeightSecs * FixedPointOne, 0.0f, (float)MAX_int32);
+	if (PeakFixedPoint == 0)
+	{
+		return;
+	}
+
+	//An axis aligned Gaussian is separable, so the per axis weights are computed once and each cell is just a multiply.
+	const FVector2D CenterCells(CenterUNorm.X * Width, CenterUNorm.Y * Height);
+	const FVector2D SigmaCells(FMath::Max(RadiiUNorm.X * Width * 0.5f, 0.5f), FMath::Max(RadiiUNorm.Y * Height * 0.5f, 0.5f));
+	const int32 MinX = FMath::Max(FMath::FloorToInt(CenterCells.X - 3.0f * SigmaCells.X), 0);
+	const int32 MaxX = FMath::Min(FMath::CeilToInt(CenterCells.X + 3.0f * SigmaCells.X), Width - 1);
+	const int32 MinY = FMath::Max(FMath::FloorToInt(CenterCells.Y - 3.0f * SigmaCells.Y), 0);
+	const int32 MaxY = FMath::Min(FMath::CeilToInt(CenterCells.Y + 3.0f * SigmaCells.Y), Height - 1);
+	if (MinX > MaxX || MinY > MaxY)
+	{
+		return;
+	}
+
+	WeightsX.SetNumUninitialized(MaxX - MinX + 1, false);
+	for (int32 X = MinX; X <= MaxX; X++)
+	{
+		const float Offset = (X + 0.5f - CenterCells.X) / SigmaCells.X;
+		WeightsX[X - MinX] = FMath::Exp(-0.5f * Offset * Offset);
+	}
+	WeightsY.SetNumUninitialized(MaxY - MinY + 1, false);
+	for (int32 Y = MinY; Y <= MaxY; Y++)
+	{
+		const float Offset = (Y + 0.5f - CenterCells.Y) / SigmaCells.Y;
+		WeightsY[Y - MinY] = FMath::Exp(-0.5f * Offset * Offset) * PeakFixedPoint;
+	}
+
+	for (int32 TileY = MinY / TileSize; TileY <= MaxY / TileSize; TileY++)
+	{
+		for (int32 TileX = MinX / TileSize; TileX <= MaxX / TileSize; TileX++)
+		{
+			TArray<uint32>& Tile = Tiles[TileY * NumTilesX + TileX];
+			if (Tile.Num() == 0)
+			{
+				Tile.SetNumZeroed(TileSize * TileSize);
+			}
+
+			const int32 StartX = FMath::Max(MinX, TileX * TileSize);
+			const int32 EndX = FMath::Min(MaxX, TileX * TileSize + TileSize - 1);
+			const int32 StartY = FMath::Max(MinY, TileY * TileSize);
+			const int32 EndY = FMath::Min(MaxY, TileY * TileSize + TileSize - 1);
+			for (int32 Y = StartY; Y <= EndY; Y++)
+			{
+				uint32* Row = Tile.GetData() + (Y - TileY * TileSize) * TileSize;
+				const float WeightY = WeightsY[Y - MinY];
+				for (int32 X = StartX; X <= EndX; X++)
+				{
+					//Saturate rather than wrap, a full cell should stay the hottest one.
+					uint32& Cell = Row[X - TileX * TileSize];
+					const uint32 Add = (uint32)(WeightY * WeightsX[X - MinX]);
+					Cell = (Cell > MAX_uint32 - Add) ? MAX_uint32 : Cell + Add;
+				}
+			}
+		}
+	}
+}
+
+void FTobiiGazeHeatmapGrid::Reset()
+{
+	for (TArray<uint32>& Tile : Tiles)
+	{
+		Tile.Empty();
+	}
+}
+
+int32 FTobiiGazeHeatmapGrid::GetNumAllocatedTiles() const
+{
+	int32 NumAllocated = 0;
+	for (const TArray<uint32>& Tile : Tiles)
+	{
+		NumAllocated += Tile.Num() > 0 ? 1 : 0;
+	}
+	return NumAllocated;
+}
+
+void FTobiiGazeHeatmapGrid::CopyToSeconds(TArray<float>& OutSeconds) const
+{
+	OutSeconds.SetNumZeroed(Width * Height);
+	for (int32 TileY = 0; TileY < NumTilesY; TileY++)
+	{
+		for (int32 TileX = 0; TileX < NumTilesX; TileX++)
+		{
+			const TArray<uint32>& Tile = Tiles[TileY * NumTilesX + TileX];
+			if (Tile.Num() == 0)
+			{
+				continue;
+			}
+
+			const int32 EndX = FMath::Min(TileX * TileSize + TileSize, Width);
+			const int32 EndY = FMath::Min(TileY * TileSize + TileSize, Height);
+			for (int32 Y = TileY * TileSize; Y < EndY; Y++)
+			{
+				for (int32 X = TileX * TileSize; X < EndX; X++)
+				{
+					OutSeconds[Y * Width + X] = Tile[(Y - TileY * TileSize) * TileSize + (X - TileX * TileSize)] / (float)FixedPointOne;
+				}
+			}
+		}
+	}
+}
+
+FTobiiGazeHeatmapWorker::FTobiiGazeHeatmapWorker(int32 Width, int32 Height)
+	: Grid(Width, Height)
+	, Thread(nullptr)
+	, WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, bStopRequested(false)
+{
+	Thread = FRunnableThread::Create(this, TEXT("TobiiGazeHeatmap"), 0, TPri_BelowNormal);
+}
+
+FTobiiGazeHeatmapWorker::~FTobiiGazeHeatmapWorker()
+{
+	if (Thread != nullptr)
+	{
+		//Kill calls Stop and waits for Run to return.
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+void FTobiiGazeHeatmapWorker::AddSample(const FTobiiGazeHeatmapSample& Sample)
+{
+	Samples.Enqueue(Sample);
+	WakeEvent->Trigger();
+}
+
+void FTobiiGazeHeatmapWorker::CopyToSeconds(TArray<float>& OutSeconds, int32& OutWidth, int32& OutHeight) const
+{
+	FScopeLock Lock(&GridCriticalSection);
+	Grid.CopyToSeconds(OutSeconds);
+	OutWidth = Grid.GetWidth();
+	OutHeight = Grid.GetHeight();
+}
+
+void FTobiiGazeHeatmapWorker::Reset()
+{
+	FScopeLock Lock(&GridCriticalSection);
+	Grid.Reset();
+}
+
+int32 FTobiiGazeHeatmapWorker::GetNumAllocatedTiles() const
+{
+	FScopeLock Lock(&GridCriticalSection);
+	return Grid.GetNumAllocatedTiles();
+}
+
+uint32 FTobiiGazeHeatmapWorker::Run()
+{
+	FTobiiGazeHeatmapSample Sample;
+	while (!bStopRequested)
+	{
+		if (Samples.IsEmpty())
+		{
+			WakeEvent->Wait(100);
+			continue;
+		}
+
+		FScopeLock Lock(&GridCriticalSection);
+		while (Samples.Dequeue(Sample))
+		{
+			Grid.Splat(Sample.GazePointUNorm, Sample.FovealRadiiUNorm, Sample.DurationSecs);
+		}
+	}
+
+	return 0;
+}
+
+void FTobiiGazeHeatmapWorker::Stop()
+{
+	bStopRequested = true;
+	WakeEvent->Trigger();
+}
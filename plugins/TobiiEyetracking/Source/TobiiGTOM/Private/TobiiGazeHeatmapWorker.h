@@ -0,0 +1,91 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+
+class FRunnableThread;
+class FEvent;
+
+/** One frame of gaze, as handed from the game thread to the heatmap worker. */
+struct FTobiiGazeHeatmapSample
+{
+	FVector2D GazePointUNorm;
+	FVector2D FovealRadiiUNorm;
+	float DurationSecs;
+};
+
+/**
+  * Accumulated gaze time over the viewport, in fixed point.
+  * The cells are grouped in square tiles that are only allocated once gaze touches them, so parts of the screen nobody looks at cost nothing.
+  */
+class FTobiiGazeHeatmapGrid
+{
+public:
+	enum { TileSize = 16 };
+
+	//Cell values are in 1/65536ths of a second. That resolves a fraction of a frame and still holds 18 hours per cell.
+	enum { FixedPointOne = 65536 };
+
+	FTobiiGazeHeatmapGrid(int32 InWidth, int32 InHeight);
+
+	/** Add a Gaussian footprint that peaks at WeightSecs in the center, with one standard deviation at half of RadiiUNorm. */
+	void Splat(const FVector2D& CenterUNorm, const FVector2D& RadiiUNorm, float WeightSecs);
+	void Reset();
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+	int32 GetNumAllocatedTiles() const;
+
+	/** Row major seconds for every cell. */
+	void CopyToSeconds(TArray<float>& OutSeconds) const;
+
+private:
+	int32 Width;
+	int32 Height;
+	int32 NumTilesX;
+	int32 NumTilesY;
+	TArray<TArray<uint32>> Tiles;
+
+	//Kept between splats so they don't allocate.
+	TArray<float> WeightsX;
+	TArray<float> WeightsY;
+};
+
+/**
+  * Splats the game thread's gaze samples into a grid on its own thread, so a heatmap costs the game thread one queue push per frame.
+  */
+class FTobiiGazeHeatmapWorker : public FRunnable
+{
+public:
+	FTobiiGazeHeatmapWorker(int32 Width, int32 Height);
+	virtual ~FTobiiGazeHeatmapWorker();
+
+	/** Game thread side. */
+	void AddSample(const FTobiiGazeHeatmapSample& Sample);
+
+	/** Any thread. Waits for the worker to finish the splat it is in. Samples still in the queue are not included. */
+	void CopyToSeconds(TArray<float>& OutSeconds, int32& OutWidth, int32& OutHeight) const;
+	void Reset();
+	int32 GetNumAllocatedTiles() const;
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	TQueue<FTobiiGazeHeatmapSample, EQueueMode::Spsc> Samples;
+	FTobiiGazeHeatmapGrid Grid;
+	mutable FCriticalSection GridCriticalSection;
+
+	FRunnableThread* Thread;
+	FEvent* WakeEvent;
+	FThreadSafeBool bStopRequested;
+};
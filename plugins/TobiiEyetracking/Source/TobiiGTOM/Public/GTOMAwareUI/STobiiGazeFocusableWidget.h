@@ -59,6 +59,9 @@ public:
 	bool IsHoveredByPointer() { return bIsHovered; }
 	bool HitByGaze();
 
+	//CleanUI state is driven by the GTOM engine's CleanUI controller. Call this if something it cannot observe, like the CleanUI settings of the UMG widget, has changed.
+	void RefreshCleanUI();
+
 	void AddExtraCleanUIContainerToPollHitsFrom(STobiiGazeFocusableWidget* CleanUIContainerToPoll, bool PollGazeHits = true, bool PollMouseHits = true);
 	void RemoveExtraCleanUIContainerToPollHitsFrom(STobiiGazeFocusableWidget* CleanUIContainerToStopPolling);
 
@@ -71,12 +74,13 @@ public:
 	FSimpleDelegate OnHovered;
 	FSimpleDelegate OnUnhovered;
 
-	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyClippingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 	virtual void OnMouseEnter(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
 	virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
 
 private:
+	friend class FTobiiCleanUIController;
+
 	struct CleanUIPollingInfo
 	{
 		TWeakPtr<SWidget> CleanUIToPollFrom;
@@ -85,6 +89,11 @@ private:
 	};
 
 	float CleanUIAlpha;
+	bool bShouldCleanUIFadeIn;
+	bool bIsCleanUIFadeActive;
 
 	TArray<CleanUIPollingInfo> CleanUIContainersToPollHitsFrom;
+
+	//The reverse of CleanUIContainersToPollHitsFrom. These need to be re-evaluated when our hit state changes.
+	TArray<TWeakPtr<SWidget>> CleanUIContainersPollingHitsFromThis;
 };
@@ -22,6 +22,42 @@ struct FTobiiRadialMenuPanelRenderData
 
 	TArray<FSlateVertex> BorderVertexData; //This also contains the PanelVertexData in the end.
 	TArray<SlateIndex> BorderIndexData;
+
+	//The colors currently written into the vertex data. Only when these change do we need to touch the vertices again.
+	bool bHasAppliedColors;
+	FColor AppliedPanelColor;
+	FColor AppliedBorderColor;
+	bool bAppliedHardBorder;
+
+	FTobiiRadialMenuPanelRenderData()
+		: bHasAppliedColors(false)
+		, AppliedPanelColor(FColor::White)
+		, AppliedBorderColor(FColor::White)
+		, bAppliedHardBorder(false)
+	{ }
+};
+
+//Everything that affects the tessellated panel geometry. If none of this changes, we can reuse the vertices from the last paint.
+struct FTobiiRadialMenuGeometryKey
+{
+	FVector2D LocalSize;
+	FSlateRenderTransform RenderTransform;
+	int32 NrChildren;
+	int32 VertexCount;
+	float SegmentSeparationPx;
+	float BorderThicknessPx;
+	float AngularDisplacementDeg;
+
+	bool operator==(const FTobiiRadialMenuGeometryKey& Other) const
+	{
+		return LocalSize == Other.LocalSize
+			&& RenderTransform == Other.RenderTransform
+			&& NrChildren == Other.NrChildren
+			&& VertexCount == Other.VertexCount
+			&& SegmentSeparationPx == Other.SegmentSeparationPx
+			&& BorderThicknessPx == Other.BorderThicknessPx
+			&& AngularDisplacementDeg == Other.AngularDisplacementDeg;
+	}
 };
 
 //This is the underlying slate widget. 
@@ -155,5 +191,11 @@ public:
 	int32 VertexCount;
 
 private:
+	//Paint is const, but the tessellated panels are pure caches of our properties so we keep them here.
+	mutable TOptional<FTobiiRadialMenuGeometryKey> CachedGeometryKey;
+	mutable TArray<FTobiiRadialMenuPanelRenderData> CachedChildRenderData;
+
+	const TArray<FTobiiRadialMenuPanelRenderData>& UpdatePanelRenderData(const FGeometry& AllottedGeometry) const;
 	void GeneratePanelRenderData(const FGeometry& AllottedGeometry, int32 NrChildren, TArray<FTobiiRadialMenuPanelRenderData>& OutChildRenderData) const;
+	static void ApplyPanelColors(FTobiiRadialMenuPanelRenderData& RenderData, const FColor& NewPanelColor, const FColor& NewBorderColor, bool bNewHardBorder);
 };
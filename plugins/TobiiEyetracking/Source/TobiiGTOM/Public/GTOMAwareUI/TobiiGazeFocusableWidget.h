@@ -116,7 +116,7 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CleanUI")
 	ETobiiCleanUIMode CleanUIMode;
 
-	//If this is larger than 0, CleanUI is currently being suppressed.
+	//If this is larger than 0, CleanUI is currently being suppressed. If you change this at runtime, prefer SuppressCleanUI so the change is picked up immediately.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "CleanUI")
 	float TimeCleanUIIsSuppressedForSecs;
 
@@ -137,6 +137,14 @@ public:
 	UFUNCTION(BlueprintPure, Category = "CleanUI")
 	float GetCleanUIAlpha();
 
+	//This will fade the widget in and keep it faded in for the given duration.
+	UFUNCTION(BlueprintCallable, Category = "CleanUI")
+	void SuppressCleanUI(float DurationSecs);
+
+	//CleanUI is only re-evaluated when gaze or pointer state changes. Call this after changing any of the CleanUI properties above at runtime.
+	UFUNCTION(BlueprintCallable, Category = "CleanUI")
+	void RefreshCleanUI();
+
 public:
 	//If this widget should fade out when another container is being looked at, use these functions to make that happen. This requires bUseFastHitTesting to be off.
 	UFUNCTION(BlueprintCallable, Category = "Dependent Widgets")
@@ -66,6 +66,34 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Tobii GTOM")
 	static bool GetAllFilteredGazeFocusData(const TArray<FName>& FocusLayerFilterList, const bool bIsWhiteList, const bool bWantPrimitives, const bool bWantWidgets, TArray<FTobiiGazeFocusData>& OutFocusData);
 
+	/**
+	  * Get the attention statistics GTOM has collected for a primitive component or widget since the ledger was last reset.
+	  *
+	  * @param Focusable			The focused primitive component, or the focused widget for widgets.
+	  * @param OutStats				Output stats.
+	  * @returns					False if the focusable has not been GTOM's top focus yet.
+	  */
+	UFUNCTION(BlueprintPure, Category = "Tobii GTOM Attention")
+	static bool GetAttentionStats(UObject* Focusable, FTobiiAttentionStats& OutStats);
+
+	/**
+	  * Get the attention statistics for everything that has been GTOM's top focus, including focusables that have since been destroyed. Longest dwell first.
+	  */
+	UFUNCTION(BlueprintPure, Category = "Tobii GTOM Attention")
+	static void GetAllAttentionStats(TArray<FTobiiAttentionStats>& OutStats);
+
+	/**
+	  * Clear the attention statistics and restart the clock for time to first focus.
+	  */
+	UFUNCTION(BlueprintCallable, Category = "Tobii GTOM Attention")
+	static void ResetAttentionStats();
+
+	/**
+	  * Write the attention statistics as CSV.
+	  */
+	UFUNCTION(BlueprintCallable, Category = "Tobii GTOM Attention")
+	static bool ExportAttentionStatsCSV(const FString& FilePath);
+
 
 	/************************************************************************/
 	/* Utils                                                                */
@@ -75,6 +75,54 @@ public:
 	float FocusConfidence;
 };
 
+/**
+  * What GTOM's attention ledger knows about one focusable, accumulated over every frame it was the top focus.
+  */
+USTRUCT(BlueprintType)
+struct FTobiiAttentionStats
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	FTobiiAttentionStats()
+		: Focusable()
+		, Name()
+		, DwellSecs(0.0f)
+		, NumVisits(0)
+		, TimeToFirstFocusSecs(0.0f)
+		, AverageFocusConfidence(0.0f)
+		, bIsDestroyed(false)
+	{}
+
+	//The focused widget, or the focused primitive component if there was no widget.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attention Stats")
+	TWeakObjectPtr<UObject> Focusable;
+
+	//Owning actor and component name for primitives, widget name for widgets. Kept after the focusable is destroyed.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attention Stats")
+	FString Name;
+
+	//Total time this was the top focus.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attention Stats")
+	float DwellSecs;
+
+	//How many times the top focus moved to this from something else, or from nothing.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attention Stats")
+	int32 NumVisits;
+
+	//Seconds from when the ledger was started or reset until this first became the top focus.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attention Stats")
+	float TimeToFirstFocusSecs;
+
+	//The focus confidence while this was the top focus, weighted by frame time.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attention Stats")
+	float AverageFocusConfidence;
+
+	//The focusable is gone. These are the stats it had when it was destroyed.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attention Stats")
+	bool bIsDestroyed;
+};
+
 //This contains the tags that can optionally be used to inform the GTOM system about the primitive component they are attached to. These only exist since we cannot add UPROPERTY's to primitive components without engine modifications. 
 //If you want to override behavior or widgets, please change the relevant properties on the TobiiGazeFocusableWidget since we have full access to that type.
 class TOBIIGTOM_API FTobiiPrimitiveComponentGazeFocusTags
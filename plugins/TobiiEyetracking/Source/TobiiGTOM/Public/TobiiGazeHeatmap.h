@@ -0,0 +1,89 @@
+/******************************************************************************
+* Copyright 2017- Tobii Technology AB. All rights reserved.
+*
+* @author Temaran | Fredrik Lindh | fredrik.lindh@tobii.com | https://github.com/Temaran
+******************************************************************************/
+
+#pragma once
+
+#include "TobiiGTOMTypes.h"
+
+#include "CoreMinimal.h"
+#include "IEyeTracker.h"
+#include "UObject/Object.h"
+
+#include "TobiiGazeHeatmap.generated.h"
+
+class APlayerController;
+
+/**
+  * Records where the user looked for as long as it exists, so attention can be summarized live instead of logging every gaze point.
+  * Every frame the gaze point is splatted into a grid over the viewport with the size of the foveal region, and how long each focusable held GTOM's top focus comes from the engine's attention stats.
+  * The grid is filled on a worker thread. It is resolution independent, each cell covers 1 / Width of the viewport horizontally and 1 / Height vertically.
+  * Keep a reference to the heatmap, it records until it is stopped or garbage collected.
+  */
+UCLASS(BlueprintType, Category = "Tobii GTOM")
+class TOBIIGTOM_API UTobiiGazeHeatmap : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UTobiiGazeHeatmap();
+
+	/**
+	  * Start a new heatmap.
+	  *
+	  * @param Width				Number of cells across the viewport.
+	  * @param Height				Number of cells down the viewport.
+	  * @returns					The heatmap, recording from the next GTOM tick.
+	  */
+	UFUNCTION(BlueprintCallable, Category = "Tobii GTOM Heatmap")
+	static UTobiiGazeHeatmap* CreateGazeHeatmap(int32 Width = 256, int32 Height = 144);
+
+	/** Stop recording. What was recorded stays available. */
+	UFUNCTION(BlueprintCallable, Category = "Tobii GTOM Heatmap")
+	void StopRecording();
+
+	/** Clear the grid. The dwell times are GTOM's attention stats, ResetAttentionStats clears those. */
+	UFUNCTION(BlueprintCallable, Category = "Tobii GTOM Heatmap")
+	void ResetHeatmap();
+
+	/**
+	  * Copy the grid as it is now.
+	  *
+	  * @param OutSeconds			Row major, the gaze time in seconds at each cell's center.
+	  */
+	UFUNCTION(BlueprintCallable, Category = "Tobii GTOM Heatmap")
+	void GetHeatmapSnapshot(TArray<float>& OutSeconds, int32& OutWidth, int32& OutHeight) const;
+
+	/** Dwell times per focusable, longest first. The same as GetAllAttentionStats. */
+	UFUNCTION(BlueprintCallable, Category = "Tobii GTOM Heatmap")
+	TArray<FTobiiAttentionStats> GetDwellTimes() const;
+
+	/** Seconds of valid gaze that went into the heatmap. */
+	UFUNCTION(BlueprintPure, Category = "Tobii GTOM Heatmap")
+	float GetRecordedSecs() const { return RecordedSecs; }
+
+	/** Write the grid as CSV, one line per row of cells, in seconds. */
+	UFUNCTION(BlueprintCallable, Category = "Tobii GTOM Heatmap")
+	bool ExportHeatmapCSV(const FString& FilePath) const;
+
+	/** Write the dwell times as CSV with a header line. The same as ExportAttentionStatsCSV. */
+	UFUNCTION(BlueprintCallable, Category = "Tobii GTOM Heatmap")
+	bool ExportDwellTimesCSV(const FString& FilePath) const;
+
+	//Nothing is recorded while this is set. Unlike StopRecording, it can be resumed.
+	UPROPERTY(BlueprintReadWrite, Category = "Tobii GTOM Heatmap")
+	bool bIsPaused;
+
+	/** Called by the GTOM engine after each focus update. */
+	static void TickHeatmaps(float DeltaTimeSecs, APlayerController* PlayerController, const FEyeTrackerGazeData& GazeData, const FVector2D& ScreenGazePointPx, const FVector2D& ViewportSize);
+
+	virtual void BeginDestroy() override;
+
+private:
+	class FTobiiGazeHeatmapWorker* Worker;
+	float RecordedSecs;
+
+	void Record(float DeltaTimeSecs, const FVector2D& GazePointUNorm, const FVector2D& FovealRadiiUNorm);
+};
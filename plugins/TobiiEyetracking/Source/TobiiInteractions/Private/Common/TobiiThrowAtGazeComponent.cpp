@@ -18,6 +18,10 @@
 static TAutoConsoleVariable<int32> CVarThrowAtGazeEnabled(TEXT("tobii.interaction.ThrowAtGazeEnabled"), 1, TEXT("Throw where your are looking."));
 static TAutoConsoleVariable<int32> CVarThrowAtGazeDebug(TEXT("tobii.debug.ThrowAtGaze"), 1, TEXT("Draw throw at gaze debug data."));
 
+// Async trace user data layout: [8 bits request serial][8 bits candidate index][16 bits segment index]
+#define TOBII_ASYNC_THROW_MAX_CANDIDATES (0xFF)
+#define TOBII_ASYNC_THROW_MAX_SEGMENTS (0xFFFF)
+
 UTobiiThrowAtGazeComponent::UTobiiThrowAtGazeComponent()
 	: ThrowTarget(nullptr)
 	, MaxThrowSpeedCmPerSecs(1000.0f)
@@ -34,6 +38,7 @@ UTobiiThrowAtGazeComponent::UTobiiThrowAtGazeComponent()
 	, TraceStepSizeSecs(0.1f)
 	, MaxTraceDistance(10000.0f)
 	, NoTargetAcceptanceThreshold(10.0f)
+	, MaxAsyncTracesPerFrame(256)
 	, TraceChannel(ECC_Visibility)
 	, TraceIgnoreActors()
 	, bShouldTraceIgnoreOwner(true)
@@ -41,9 +46,15 @@ UTobiiThrowAtGazeComponent::UTobiiThrowAtGazeComponent()
 	, bUseCustomGravity(false)
 	, CustomProjectileGravity(FVector::ZeroVector)
 
-	, LastTargetVelocity(FVector::ZeroVector)
-	, CalculatedTargetAcceleration(FVector::ZeroVector)
+	, ThrowTargetMotion()
+	, ThrowTargetMotionSource(nullptr)
+
+	, PendingAsyncThrow()
+	, AsyncThrowSerial(0)
 {
+	PrimaryComponentTick.bCanEverTick = true;
+
+	AsyncThrowTraceDelegate.BindUObject(this, &UTobiiThrowAtGazeComponent::OnAsyncThrowTraceCompleted);
 }
 
 FVector UTobiiThrowAtGazeComponent::CalculateProjectileGravityVector()
@@ -80,12 +91,29 @@ bool UTobiiThrowAtGazeComponent::TraceBallisticProjectilePath(FVector Projectile
 
 void UTobiiThrowAtGazeComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	//ThrowTarget can be swapped from blueprint at any time, so the estimate must not mix velocities from two different targets.
+	if (ThrowTarget != ThrowTargetMotionSource)
+	{
+		ThrowTargetMotion.Reset();
+		ThrowTargetMotionSource = ThrowTarget;
+	}
+
 	if (ThrowTarget.IsValid())
 	{
-		const float AccelerationLerpSpeed = 0.7f;
-		FVector CurrentTargetVelocity = ThrowTarget->GetOwner()->GetVelocity();
-		CalculatedTargetAcceleration = FMath::Lerp(CalculatedTargetAcceleration, CurrentTargetVelocity - LastTargetVelocity, AccelerationLerpSpeed);
-		LastTargetVelocity = CurrentTargetVelocity;
+		ThrowTargetMotion.Update(ThrowTarget->GetOwner()->GetVelocity(), DeltaTime);
+	}
+
+	if (PendingAsyncThrow.IsSet())
+	{
+		DispatchAsyncThrowTraces();
+
+		const FTobiiAsyncThrowRequest& Request = PendingAsyncThrow.GetValue();
+		if (Request.NextCandidateToDispatch >= Request.Candidates.Num() && Request.NrOutstandingSegments <= 0)
+		{
+			FinishAsyncThrow();
+		}
 	}
 }
 
@@ -155,51 +183,14 @@ FVector UTobiiThrowAtGazeComponent::CorrectThrow(const FVector& ThrowOrigin, con
 
 ETobiiThrowAtGazeResult UTobiiThrowAtGazeComponent::CalculateThrowAtGazeVector(const FVector& ThrowOrigin, FTobiiBallisticResult& OutBallisticResult, TArray<FVector>& OutTracedPath)
 {
-	UWorld* World = GetWorld();
-	if (World == nullptr || GEngine == nullptr || !GEngine->EyeTrackingDevice.IsValid())
-	{
-		return ETobiiThrowAtGazeResult::UnknownError;
-	}
-
-	if (ThrowTarget.IsValid())
+	FVector TargetLocation, TargetVelocity, TargetAcceleration;
+	ETobiiThrowAtGazeResult Error;
+	if (!FindThrowAtGazeTarget(TargetLocation, TargetVelocity, TargetAcceleration, Error))
 	{
-		return CalculateThrowArc(ThrowOrigin, ThrowTarget->GetCenterOfMass(), ThrowTarget->GetOwner()->GetVelocity(), CalculatedTargetAcceleration, OutBallisticResult, OutTracedPath);
-	}
-	else if (World->GetFirstPlayerController() != nullptr && World->GetFirstPlayerController()->PlayerCameraManager != nullptr)
-	{
-		FVector GazeTargetPosition;
-		FVector GazeRayOrigin = FVector::ZeroVector;
-		FVector GazeRayDirection = FVector::ZeroVector;
-
-		FEyeTrackerGazeData CombinedGazeData;
-		GEngine->EyeTrackingDevice->GetEyeTrackerGazeData(CombinedGazeData);
-		if (CombinedGazeData.ConfidenceValue > 0.5f)
-		{
-			GazeRayOrigin = CombinedGazeData.GazeOrigin;
-			GazeRayDirection = CombinedGazeData.GazeDirection;
-		}
-		else
-		{
-			// If eyetracking data is not available this frame, just use the center of the screen
-			GazeRayOrigin = World->GetFirstPlayerController()->PlayerCameraManager->GetCameraLocation();
-			GazeRayDirection = World->GetFirstPlayerController()->PlayerCameraManager->GetCameraRotation().Vector();
-		}
-
-		FVector EndPoint = GazeRayOrigin + GazeRayDirection * MaxTraceDistance;
-		FHitResult HitResult;
-		if (World->LineTraceSingleByChannel(HitResult, GazeRayOrigin, EndPoint, TraceChannel))
-		{
-			GazeTargetPosition = HitResult.Location;
-		}
-		else
-		{
-			GazeTargetPosition = EndPoint;
-		}
-
-		return CalculateThrowArc(ThrowOrigin, GazeTargetPosition, FVector::ZeroVector, FVector::ZeroVector, OutBallisticResult, OutTracedPath);
+		return Error;
 	}
 
-	return ETobiiThrowAtGazeResult::NoEyetrackingInput;
+	return CalculateThrowArc(ThrowOrigin, TargetLocation, TargetVelocity, TargetAcceleration, OutBallisticResult, OutTracedPath);
 }
 
 ETobiiThrowAtGazeResult UTobiiThrowAtGazeComponent::CalculateThrowArc(const FVector& ThrowOrigin, const FVector& TargetLocation, const FVector& TargetVelocity, const FVector& TargetAcceleration, FTobiiBallisticResult& OutBallisticResult, TArray<FVector>& OutTracedPath)
@@ -213,8 +204,6 @@ ETobiiThrowAtGazeResult UTobiiThrowAtGazeComponent::CalculateThrowArc(const FVec
 
 	static const auto DrawDebugCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("tobii.debug"));
 	const FVector ProjectileAcceleration = CalculateProjectileGravityVector();
-	const float BaseAcceptanceThreshold = TraceRadiusCm + NoTargetAcceptanceThreshold;
-	const float TraceAcceptanceThresholdSq = BaseAcceptanceThreshold * BaseAcceptanceThreshold;
 
 	bool bShouldDrawDebug = DrawDebugCVar->GetInt() && CVarThrowAtGazeDebug.GetValueOnGameThread();
 	if (bShouldDrawDebug)
@@ -245,21 +234,7 @@ ETobiiThrowAtGazeResult UTobiiThrowAtGazeComponent::CalculateThrowArc(const FVec
 	TraceData.ProjectileAcceleration = ProjectileAcceleration;
 
 	TArray<float> ApexesToTest;
-	if (MaxIterations > 0)
-	{
-		//We want to first decide which apexes we should test, and then we can use logic to suss out which one ends up being the best.
-		int32 Iterations = FMath::Max(0, MaxIterations);
-		float ApexStep = (ThrowApexOffsetMaximumCm - ThrowApexOffsetMinimumCm) / Iterations;
-		for (int32 ApexIdx = 0; ApexIdx <= Iterations; ApexIdx++)
-		{
-			float CurrentApex = ThrowApexOffsetMinimumCm + ApexIdx * ApexStep;
-			ApexesToTest.Add(CurrentApex);
-		}
-	}
-	else
-	{
-		ApexesToTest.Add((ThrowApexOffsetMaximumCm + ThrowApexOffsetMinimumCm) / 2);
-	}
+	GatherApexesToTest(ApexesToTest);
 
 	// Loop variables
 	float BestResultDistanceToTargetSq = FLT_MAX;
@@ -309,97 +284,20 @@ ETobiiThrowAtGazeResult UTobiiThrowAtGazeComponent::CalculateThrowArc(const FVec
 					FHitResult HitResult;
 					if (UTobiiInteractionsBlueprintLibrary::TraceBallisticProjectilePath(GetWorld(), TraceData, TracedPath, HitResult))
 					{
-						FVector HitToTarget = TargetLocation - HitResult.Location;
-						float ToTargetDistSq = HitToTarget.SizeSquared();
-
-						if (ThrowTarget.IsValid())
-						{
-							if (HitResult.Actor != ThrowTarget->GetOwner())
-							{
-								bWayIsClear = false; // If we have a target, and hit something, that's okay as long as it's our target.
-							}
-						}
-						else
-						{
-							bWayIsClear = ToTargetDistSq < TraceAcceptanceThresholdSq;
-						}
-
-						DistanceToTargetSq = ToTargetDistSq;
+						bWayIsClear = IsThrowPathClear(HitResult, TargetLocation, ThrowTarget.IsValid() ? ThrowTarget->GetOwner() : nullptr, DistanceToTargetSq);
 					}
 
 					if (bShouldDrawDebug)
 					{
-						if (TracedPath.Num() > 1)
-						{
-							FColor DrawColor = bWayIsClear ? FColor::Green : FColor::Red;
-							FVector PrevPoint = TracedPath[0];
-							int32 MiddlePointIdx = (int32)(TracedPath.Num() / 2.0f);
-							if (MiddlePointIdx >= 0 && MiddlePointIdx < TracedPath.Num())
-							{
-								DrawDebugString(GetWorld(), TracedPath[MiddlePointIdx] + FVector(0.0f, 0.0f, 10.0f), FString::Printf(TEXT("%f"), BallisticData.ProjectileApexOffsetCm), nullptr, DrawColor, 5.0f);
-							}
-							for (auto& TracePoint : TracedPath)
-							{
-								DrawDebugLine(GetWorld(), PrevPoint, TracePoint, DrawColor, false, 5.0f, 0, 1.0f);
-								PrevPoint = TracePoint;
-							}
-						}
+						DrawThrowCandidateDebug(TracedPath, BallisticData.ProjectileApexOffsetCm, bWayIsClear);
 					}
 				}
 
-				if (bWayIsClear)
+				ConsiderThrowCandidate(Result, bIsInRange, bWayIsClear, DistanceToTargetSq, TracedPath, BestResultStatus, BestResultDistanceToTargetSq, OutBallisticResult, OutTracedPath);
+				if (BestResultStatus == ETobiiThrowAtGazeResult::DirectHit)
 				{
-					if (bIsInRange)
-					{
-						//We're done! Best outcome.
-						OutBallisticResult = Result;
-						OutTracedPath = TracedPath;
-						BestResultDistanceToTargetSq = DistanceToTargetSq;
-						BestResultStatus = ETobiiThrowAtGazeResult::DirectHit;
-						break;
-					}
-					else if (BestResultStatus <= ETobiiThrowAtGazeResult::OutOfRange)
-					{
-						bool bIsFaster = Result.ExpectedInterceptTimeSecs < OutBallisticResult.ExpectedInterceptTimeSecs;
-						if (bIsFaster)
-						{
-							OutBallisticResult = Result;
-							OutTracedPath = TracedPath;
-							BestResultDistanceToTargetSq = DistanceToTargetSq;
-							BestResultStatus = ETobiiThrowAtGazeResult::OutOfRange;
-						}
-					}
-				}
-				else if (TracedPath.Num() > 0)
-				{
-					if (bIsInRange)
-					{
-						if (BestResultStatus <= ETobiiThrowAtGazeResult::BlockedByWorldInRange)
-						{
-							bool bIsCloser = DistanceToTargetSq < BestResultDistanceToTargetSq;
-							if (bIsCloser)
-							{
-								OutBallisticResult = Result;
-								OutTracedPath = TracedPath;
-								BestResultDistanceToTargetSq = DistanceToTargetSq;
-								BestResultStatus = ETobiiThrowAtGazeResult::BlockedByWorldInRange;
-							}
-						}
-					}
-					else
-					{
-						if (BestResultStatus <= ETobiiThrowAtGazeResult::BlockedByWorldAndOutOfRange)
-						{
-							bool bIsCloser = DistanceToTargetSq < BestResultDistanceToTargetSq;
-							if (bIsCloser)
-							{
-								OutBallisticResult = Result;
-								OutTracedPath = TracedPath;
-								BestResultDistanceToTargetSq = DistanceToTargetSq;
-								BestResultStatus = ETobiiThrowAtGazeResult::BlockedByWorldAndOutOfRange;
-							}
-						}
-					}
+					//We're done! Best outcome.
+					break;
 				}
 			}
 		}
@@ -464,3 +362,387 @@ ETobiiThrowAtGazeResult UTobiiThrowAtGazeComponent::CalculateThrowArc(const FVec
 	// Output results
 	return BestResultStatus;
 }
+
+bool UTobiiThrowAtGazeComponent::CalculateThrowAtGazeVectorAsync(const FVector& ThrowOrigin, const FTobiiThrowAtGazeCompletedSignature& OnCompleted)
+{
+	FVector TargetLocation, TargetVelocity, TargetAcceleration;
+	ETobiiThrowAtGazeResult Error;
+	if (!FindThrowAtGazeTarget(TargetLocation, TargetVelocity, TargetAcceleration, Error))
+	{
+		return false;
+	}
+
+	return CalculateThrowArcAsync(ThrowOrigin, TargetLocation, TargetVelocity, TargetAcceleration, OnCompleted);
+}
+
+bool UTobiiThrowAtGazeComponent::CalculateThrowArcAsync(const FVector& ThrowOrigin, const FVector& TargetLocation, const FVector& TargetVelocity, const FVector& TargetAcceleration, const FTobiiThrowAtGazeCompletedSignature& OnCompleted)
+{
+	if (GetWorld() == nullptr || !OnCompleted.IsBound())
+	{
+		return false;
+	}
+
+	CancelAsyncThrow();
+
+	static const auto DrawDebugCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("tobii.debug"));
+	if (DrawDebugCVar->GetInt() && CVarThrowAtGazeDebug.GetValueOnGameThread())
+	{
+		DrawDebugSphere(GetWorld(), TargetLocation, 20.0f, 16, FColor::Yellow, false, 5.0f);
+	}
+
+	FTobiiAsyncThrowRequest Request;
+	Request.Serial = ++AsyncThrowSerial;
+	Request.ThrowOrigin = ThrowOrigin;
+	Request.TargetLocation = TargetLocation;
+	Request.TargetActor = ThrowTarget.IsValid() ? ThrowTarget->GetOwner() : nullptr;
+	Request.ProjectileAcceleration = CalculateProjectileGravityVector();
+	Request.CollisionParams.AddIgnoredActors(TraceIgnoreActors);
+	if (bShouldTraceIgnoreOwner)
+	{
+		Request.CollisionParams.AddIgnoredActor(GetOwner());
+	}
+	Request.NrSegmentsPerCandidate = bShouldTraceResult ? FMath::Clamp(MaxNrTraceSteps, 0, TOBII_ASYNC_THROW_MAX_SEGMENTS) : 0;
+	Request.NextCandidateToDispatch = 0;
+	Request.NextSegmentToDispatch = 0;
+	Request.NrOutstandingSegments = 0;
+	Request.OnCompleted = OnCompleted;
+
+	FTobiiBallisticData BallisticData;
+	BallisticData.ProjectileInitialPosition = ThrowOrigin;
+	BallisticData.ProjectileAcceleration = Request.ProjectileAcceleration;
+	BallisticData.TargetPosition = TargetLocation;
+	BallisticData.TargetVelocity = TargetVelocity;
+	BallisticData.TargetAcceleration = TargetAcceleration;
+
+	// Since all candidates are traced in parallel we can't prune apexes based on earlier results like the synchronous version does.
+	// Instead we solve every apex up front, in the same order the synchronous version would have picked them.
+	TArray<float> ApexesToTest;
+	GatherApexesToTest(ApexesToTest);
+	const bool bPreferLowApex = bAlwaysPreferLowApex || (bPreferLowApexForTargetsBelowThrower && TargetLocation.Z < ThrowOrigin.Z);
+	while (ApexesToTest.Num() > 0 && Request.Candidates.Num() < TOBII_ASYNC_THROW_MAX_CANDIDATES)
+	{
+		int32 SelectedApexIndex = bPreferLowApex ? 0 : (int32)(ApexesToTest.Num() / 2.0f);
+		SelectedApexIndex = FMath::Clamp(SelectedApexIndex, 0, ApexesToTest.Num() - 1);
+		BallisticData.ProjectileApexOffsetCm = ApexesToTest[SelectedApexIndex];
+		ApexesToTest.RemoveAt(SelectedApexIndex);
+
+		TArray<FTobiiBallisticResult> Results;
+		if (UTobiiInteractionsBlueprintLibrary::FindNeededInitialVelocityForBallisticProjectile(BallisticData, Results))
+		{
+			for (FTobiiBallisticResult& Result : Results)
+			{
+				float SuggestedInitialSpeed = Result.SuggestedInitialVelocity.Size();
+				if (SuggestedInitialSpeed < FLT_EPSILON || Request.Candidates.Num() >= TOBII_ASYNC_THROW_MAX_CANDIDATES)
+				{
+					continue;
+				}
+
+				FTobiiAsyncThrowCandidate Candidate;
+				Candidate.bIsInRange = SuggestedInitialSpeed < MaxThrowSpeedCmPerSecs;
+				if (!Candidate.bIsInRange)
+				{
+					Result.SuggestedInitialVelocity.Normalize();
+					Result.SuggestedInitialVelocity *= MaxThrowSpeedCmPerSecs;
+				}
+				Candidate.Result = Result;
+				Candidate.ApexOffsetCm = BallisticData.ProjectileApexOffsetCm;
+				Candidate.NrCompletedSegments = 0;
+				Candidate.FirstHitSegmentIdx = INDEX_NONE;
+				Request.Candidates.Add(MoveTemp(Candidate));
+			}
+		}
+	}
+
+	PendingAsyncThrow = MoveTemp(Request);
+
+	// Get the first batch going right away so results can be ready next frame.
+	DispatchAsyncThrowTraces();
+	return true;
+}
+
+bool UTobiiThrowAtGazeComponent::IsAsyncThrowPending() const
+{
+	return PendingAsyncThrow.IsSet();
+}
+
+void UTobiiThrowAtGazeComponent::CancelAsyncThrow()
+{
+	// Any traces still in flight will be discarded when they complete since their serial no longer matches.
+	PendingAsyncThrow.Reset();
+}
+
+bool UTobiiThrowAtGazeComponent::FindThrowAtGazeTarget(FVector& OutTargetLocation, FVector& OutTargetVelocity, FVector& OutTargetAcceleration, ETobiiThrowAtGazeResult& OutError)
+{
+	UWorld* World = GetWorld();
+	if (World == nullptr || GEngine == nullptr || !GEngine->EyeTrackingDevice.IsValid())
+	{
+		OutError = ETobiiThrowAtGazeResult::UnknownError;
+		return false;
+	}
+
+	if (ThrowTarget.IsValid())
+	{
+		OutTargetLocation = ThrowTarget->GetCenterOfMass();
+		OutTargetVelocity = ThrowTarget->GetOwner()->GetVelocity();
+		OutTargetAcceleration = ThrowTargetMotion.Acceleration;
+		return true;
+	}
+	else if (World->GetFirstPlayerController() != nullptr && World->GetFirstPlayerController()->PlayerCameraManager != nullptr)
+	{
+		FVector GazeRayOrigin = FVector::ZeroVector;
+		FVector GazeRayDirection = FVector::ZeroVector;
+
+		FEyeTrackerGazeData CombinedGazeData;
+		GEngine->EyeTrackingDevice->GetEyeTrackerGazeData(CombinedGazeData);
+		if (CombinedGazeData.ConfidenceValue > 0.5f)
+		{
+			GazeRayOrigin = CombinedGazeData.GazeOrigin;
+			GazeRayDirection = CombinedGazeData.GazeDirection;
+		}
+		else
+		{
+			// If eyetracking data is not available this frame, just use the center of the screen
+			GazeRayOrigin = World->GetFirstPlayerController()->PlayerCameraManager->GetCameraLocation();
+			GazeRayDirection = World->GetFirstPlayerController()->PlayerCameraManager->GetCameraRotation().Vector();
+		}
+
+		FVector EndPoint = GazeRayOrigin + GazeRayDirection * MaxTraceDistance;
+		FHitResult HitResult;
+		if (World->LineTraceSingleByChannel(HitResult, GazeRayOrigin, EndPoint, TraceChannel))
+		{
+			OutTargetLocation = HitResult.Location;
+		}
+		else
+		{
+			OutTargetLocation = EndPoint;
+		}
+
+		OutTargetVelocity = FVector::ZeroVector;
+		OutTargetAcceleration = FVector::ZeroVector;
+		return true;
+	}
+
+	OutError = ETobiiThrowAtGazeResult::NoEyetrackingInput;
+	return false;
+}
+
+void UTobiiThrowAtGazeComponent::GatherApexesToTest(TArray<float>& OutApexesToTest) const
+{
+	OutApexesToTest.Empty();
+	if (MaxIterations > 0)
+	{
+		//We want to first decide which apexes we should test, and then we can use logic to suss out which one ends up being the best.
+		int32 Iterations = FMath::Max(0, MaxIterations);
+		float ApexStep = (ThrowApexOffsetMaximumCm - ThrowApexOffsetMinimumCm) / Iterations;
+		for (int32 ApexIdx = 0; ApexIdx <= Iterations; ApexIdx++)
+		{
+			float CurrentApex = ThrowApexOffsetMinimumCm + ApexIdx * ApexStep;
+			OutApexesToTest.Add(CurrentApex);
+		}
+	}
+	else
+	{
+		OutApexesToTest.Add((ThrowApexOffsetMaximumCm + ThrowApexOffsetMinimumCm) / 2);
+	}
+}
+
+bool UTobiiThrowAtGazeComponent::IsThrowPathClear(const FHitResult& HitResult, const FVector& TargetLocation, const AActor* TargetActor, float& OutDistanceToTargetSq) const
+{
+	const float BaseAcceptanceThreshold = TraceRadiusCm + NoTargetAcceptanceThreshold;
+	const float TraceAcceptanceThresholdSq = BaseAcceptanceThreshold * BaseAcceptanceThreshold;
+
+	FVector HitToTarget = TargetLocation - HitResult.Location;
+	OutDistanceToTargetSq = HitToTarget.SizeSquared();
+
+	if (TargetActor != nullptr)
+	{
+		// If we have a target, and hit something, that's okay as long as it's our target.
+		return HitResult.GetActor() == TargetActor;
+	}
+
+	return OutDistanceToTargetSq < TraceAcceptanceThresholdSq;
+}
+
+void UTobiiThrowAtGazeComponent::ConsiderThrowCandidate(const FTobiiBallisticResult& Result, bool bIsInRange, bool bWayIsClear, float DistanceToTargetSq, const TArray<FVector>& TracedPath
+	, ETobiiThrowAtGazeResult& InOutBestResultStatus, float& InOutBestResultDistanceToTargetSq, FTobiiBallisticResult& OutBallisticResult, TArray<FVector>& OutTracedPath) const
+{
+	ETobiiThrowAtGazeResult CandidateStatus;
+	bool bIsBetter = false;
+	if (bWayIsClear)
+	{
+		if (bIsInRange)
+		{
+			CandidateStatus = ETobiiThrowAtGazeResult::DirectHit;
+			bIsBetter = InOutBestResultStatus < ETobiiThrowAtGazeResult::DirectHit;
+		}
+		else
+		{
+			CandidateStatus = ETobiiThrowAtGazeResult::OutOfRange;
+			bIsBetter = InOutBestResultStatus < ETobiiThrowAtGazeResult::OutOfRange
+				|| (InOutBestResultStatus == ETobiiThrowAtGazeResult::OutOfRange && Result.ExpectedInterceptTimeSecs < OutBallisticResult.ExpectedInterceptTimeSecs);
+		}
+	}
+	else if (TracedPath.Num() > 0)
+	{
+		CandidateStatus = bIsInRange ? ETobiiThrowAtGazeResult::BlockedByWorldInRange : ETobiiThrowAtGazeResult::BlockedByWorldAndOutOfRange;
+		bIsBetter = InOutBestResultStatus < CandidateStatus
+			|| (InOutBestResultStatus == CandidateStatus && DistanceToTargetSq < InOutBestResultDistanceToTargetSq);
+	}
+	else
+	{
+		return;
+	}
+
+	if (bIsBetter)
+	{
+		OutBallisticResult = Result;
+		OutTracedPath = TracedPath;
+		InOutBestResultDistanceToTargetSq = DistanceToTargetSq;
+		InOutBestResultStatus = CandidateStatus;
+	}
+}
+
+void UTobiiThrowAtGazeComponent::DrawThrowCandidateDebug(const TArray<FVector>& TracedPath, float ApexOffsetCm, bool bWayIsClear)
+{
+	if (TracedPath.Num() > 1)
+	{
+		FColor DrawColor = bWayIsClear ? FColor::Green : FColor::Red;
+		FVector PrevPoint = TracedPath[0];
+		int32 MiddlePointIdx = (int32)(TracedPath.Num() / 2.0f);
+		if (MiddlePointIdx >= 0 && MiddlePointIdx < TracedPath.Num())
+		{
+			DrawDebugString(GetWorld(), TracedPath[MiddlePointIdx] + FVector(0.0f, 0.0f, 10.0f), FString::Printf(TEXT("%f"), ApexOffsetCm), nullptr, DrawColor, 5.0f);
+		}
+		for (auto& TracePoint : TracedPath)
+		{
+			DrawDebugLine(GetWorld(), PrevPoint, TracePoint, DrawColor, false, 5.0f, 0, 1.0f);
+			PrevPoint = TracePoint;
+		}
+	}
+}
+
+void UTobiiThrowAtGazeComponent::DispatchAsyncThrowTraces()
+{
+	UWorld* World = GetWorld();
+	if (!PendingAsyncThrow.IsSet() || World == nullptr)
+	{
+		return;
+	}
+
+	FTobiiAsyncThrowRequest& Request = PendingAsyncThrow.GetValue();
+	if (Request.NrSegmentsPerCandidate <= 0)
+	{
+		Request.NextCandidateToDispatch = Request.Candidates.Num();
+		return;
+	}
+
+	const FCollisionShape TraceShape = FCollisionShape::MakeSphere(TraceRadiusCm);
+	const float StepSizeSecs = TraceStepSizeSecs;
+	int32 NrTracesLeftThisFrame = FMath::Max(1, MaxAsyncTracesPerFrame);
+
+	while (NrTracesLeftThisFrame > 0 && Request.NextCandidateToDispatch < Request.Candidates.Num())
+	{
+		const int32 CandidateIdx = Request.NextCandidateToDispatch;
+		const int32 SegmentIdx = Request.NextSegmentToDispatch;
+		const FVector& Velocity = Request.Candidates[CandidateIdx].Result.SuggestedInitialVelocity;
+
+		const float StartTime = SegmentIdx * StepSizeSecs;
+		const float EndTime = StartTime + StepSizeSecs;
+		const FVector StartPoint = Request.ThrowOrigin + Velocity * StartTime + 0.5f * Request.ProjectileAcceleration * StartTime * StartTime;
+		const FVector EndPoint = Request.ThrowOrigin + Velocity * EndTime + 0.5f * Request.ProjectileAcceleration * EndTime * EndTime;
+
+		const uint32 UserData = ((uint32)Request.Serial << 24) | ((uint32)CandidateIdx << 16) | (uint32)SegmentIdx;
+		World->AsyncSweepByChannel(EAsyncTraceType::Single, StartPoint, EndPoint, FQuat::Identity, TraceChannel, TraceShape, Request.CollisionParams
+			, FCollisionResponseParams::DefaultResponseParam, &AsyncThrowTraceDelegate, UserData);
+
+		Request.NrOutstandingSegments++;
+		NrTracesLeftThisFrame--;
+
+		Request.NextSegmentToDispatch++;
+		if (Request.NextSegmentToDispatch >= Request.NrSegmentsPerCandidate)
+		{
+			Request.NextSegmentToDispatch = 0;
+			Request.NextCandidateToDispatch++;
+		}
+	}
+}
+
+void UTobiiThrowAtGazeComponent::OnAsyncThrowTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	const uint8 Serial = (uint8)(TraceDatum.UserData >> 24);
+	const int32 CandidateIdx = (int32)((TraceDatum.UserData >> 16) & 0xFF);
+	const int32 SegmentIdx = (int32)(TraceDatum.UserData & 0xFFFF);
+
+	if (!PendingAsyncThrow.IsSet() || PendingAsyncThrow->Serial != Serial || !PendingAsyncThrow->Candidates.IsValidIndex(CandidateIdx))
+	{
+		return;
+	}
+
+	FTobiiAsyncThrowRequest& Request = PendingAsyncThrow.GetValue();
+	FTobiiAsyncThrowCandidate& Candidate = Request.Candidates[CandidateIdx];
+	Candidate.NrCompletedSegments++;
+	Request.NrOutstandingSegments--;
+
+	for (const FHitResult& Hit : TraceDatum.OutHits)
+	{
+		if (Hit.bBlockingHit && (Candidate.FirstHitSegmentIdx == INDEX_NONE || SegmentIdx < Candidate.FirstHitSegmentIdx))
+		{
+			Candidate.FirstHitSegmentIdx = SegmentIdx;
+			Candidate.FirstHit = Hit;
+			break;
+		}
+	}
+}
+
+void UTobiiThrowAtGazeComponent::FinishAsyncThrow()
+{
+	FTobiiAsyncThrowRequest Request = MoveTemp(PendingAsyncThrow.GetValue());
+	PendingAsyncThrow.Reset();
+
+	static const auto DrawDebugCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("tobii.debug"));
+	const bool bShouldDrawDebug = DrawDebugCVar->GetInt() && CVarThrowAtGazeDebug.GetValueOnGameThread();
+
+	FTobiiBallisticResult BestBallisticResult = FTobiiBallisticResult();
+	TArray<FVector> BestTracedPath;
+	float BestResultDistanceToTargetSq = FLT_MAX;
+	ETobiiThrowAtGazeResult BestResultStatus = ETobiiThrowAtGazeResult::NoPath;
+
+	TArray<FVector> TracedPath;
+	for (const FTobiiAsyncThrowCandidate& Candidate : Request.Candidates)
+	{
+		TracedPath.Reset();
+		bool bWayIsClear = true;
+		float DistanceToTargetSq = FLT_MAX;
+		if (Request.NrSegmentsPerCandidate > 0)
+		{
+			// Rebuild the path up until the first hit, same as TraceBallisticProjectilePath would have output.
+			const int32 NrSegmentsToOutput = Candidate.FirstHitSegmentIdx != INDEX_NONE ? Candidate.FirstHitSegmentIdx : Request.NrSegmentsPerCandidate;
+			const FVector& Velocity = Candidate.Result.SuggestedInitialVelocity;
+			TracedPath.Add(Request.ThrowOrigin);
+			for (int32 SegmentIdx = 1; SegmentIdx <= NrSegmentsToOutput; SegmentIdx++)
+			{
+				const float Time = SegmentIdx * TraceStepSizeSecs;
+				TracedPath.Add(Request.ThrowOrigin + Velocity * Time + 0.5f * Request.ProjectileAcceleration * Time * Time);
+			}
+
+			if (Candidate.FirstHitSegmentIdx != INDEX_NONE)
+			{
+				TracedPath.Add(Candidate.FirstHit.Location);
+				bWayIsClear = IsThrowPathClear(Candidate.FirstHit, Request.TargetLocation, Request.TargetActor.Get(), DistanceToTargetSq);
+			}
+
+			if (bShouldDrawDebug)
+			{
+				DrawThrowCandidateDebug(TracedPath, Candidate.ApexOffsetCm, bWayIsClear);
+			}
+		}
+
+		ConsiderThrowCandidate(Candidate.Result, Candidate.bIsInRange, bWayIsClear, DistanceToTargetSq, TracedPath, BestResultStatus, BestResultDistanceToTargetSq, BestBallisticResult, BestTracedPath);
+		if (BestResultStatus == ETobiiThrowAtGazeResult::DirectHit)
+		{
+			break;
+		}
+	}
+
+	Request.OnCompleted.ExecuteIfBound(BestResultStatus, BestBallisticResult, BestTracedPath);
+}
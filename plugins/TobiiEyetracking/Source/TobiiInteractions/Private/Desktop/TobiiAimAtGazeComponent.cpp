@@ -23,10 +23,14 @@ static TAutoConsoleVariable<int32> CVarAimAtGazeDebug(TEXT("tobii.debug.AimAtGaz
 UTobiiAimAtGazeComponent::UTobiiAimAtGazeComponent()
 	: bAllowRetarget(false)
 	, AimSpeed(0.2f)
+	, bPredictTargetMotion(false)
+	, AimSettleTimeSecs(0.15f)
+	, TargetMemorySecs(2.0f)
 
 	, CurrentFocusComponent(nullptr)
 	, CurrentAimTarget(0.0f, 0.0f, 0.0f)
 	, bIsGazeAiming(false)
+	, TargetModels()
 {
 	PrimaryComponentTick.bCanEverTick = true;
 }
@@ -52,6 +56,11 @@ void UTobiiAimAtGazeComponent::AimAtGaze()
 		CurrentFocusComponent = FocusData.FocusedPrimitiveComponent; 
 		CurrentAimTarget = FocusData.LastVisibleWorldLocation;
 		bIsGazeAiming = true;
+
+		if (bPredictTargetMotion && CurrentFocusComponent.IsValid())
+		{
+			CurrentAimTarget = PredictTargetFocusLocation(FindOrAddTargetModel(*CurrentFocusComponent));
+		}
 	}
 	else
 	{
@@ -79,7 +88,13 @@ void UTobiiAimAtGazeComponent::ContinuousAimAtGaze()
 		}
 	}
 
-	if (CurrentFocusComponent.IsValid())
+	if (CurrentFocusComponent.IsValid() && bPredictTargetMotion)
+	{
+		// The focus offset is only looked up when we start tracking a new target, after that the motion model takes over.
+		CurrentAimTarget = PredictTargetFocusLocation(FindOrAddTargetModel(*CurrentFocusComponent));
+		bIsGazeAiming = true;
+	}
+	else if (CurrentFocusComponent.IsValid())
 	{
 		FVector TargetFocusPosition;
 		UTobiiGTOMBlueprintLibrary::GetPrimitiveComponentFocusLocation(CurrentFocusComponent.Get(), TargetFocusPosition);
@@ -97,6 +112,25 @@ void UTobiiAimAtGazeComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	if (bPredictTargetMotion)
+	{
+		UpdateTargetModels(DeltaTime);
+
+		// Keep leading the target while we settle, even if nobody is calling ContinuousAimAtGaze.
+		if (bIsGazeAiming && CurrentFocusComponent.IsValid())
+		{
+			const FTobiiAimTargetModel* TargetModel = TargetModels.Find(CurrentFocusComponent->GetUniqueID());
+			if (TargetModel != nullptr)
+			{
+				CurrentAimTarget = PredictTargetFocusLocation(*TargetModel);
+			}
+		}
+	}
+	else if (TargetModels.Num() > 0)
+	{
+		TargetModels.Empty();
+	}
+
 	static const auto DrawDebugCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("tobii.debug"));
 	if (CurrentFocusComponent != nullptr && DrawDebugCVar->GetInt() && CVarAimAtGazeDebug.GetValueOnGameThread())
 	{
@@ -139,3 +173,62 @@ void UTobiiAimAtGazeComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 		}
 	}
 }
+
+UTobiiAimAtGazeComponent::FTobiiAimTargetModel& UTobiiAimAtGazeComponent::FindOrAddTargetModel(UPrimitiveComponent& Component)
+{
+	const FEngineFocusableUID TargetId = Component.GetUniqueID();
+	FTobiiAimTargetModel* ExistingModel = TargetModels.Find(TargetId);
+	if (ExistingModel != nullptr && ExistingModel->Component.Get() == &Component)
+	{
+		ExistingModel->TimeSinceAimedSecs = 0.0f;
+		return *ExistingModel;
+	}
+
+	FTobiiAimTargetModel NewModel;
+	NewModel.Component = &Component;
+	UTobiiGTOMBlueprintLibrary::GetPrimitiveComponentFocusOffset(&Component, NewModel.FocusOffset);
+	NewModel.Motion.Update(Component.GetComponentVelocity(), 0.0f);
+	NewModel.TimeSinceAimedSecs = 0.0f;
+	return TargetModels.Add(TargetId, MoveTemp(NewModel));
+}
+
+void UTobiiAimAtGazeComponent::UpdateTargetModels(float DeltaTimeSecs)
+{
+	for (auto ModelIterator = TargetModels.CreateIterator(); ModelIterator; ++ModelIterator)
+	{
+		FTobiiAimTargetModel& TargetModel = ModelIterator.Value();
+		if (!TargetModel.Component.IsValid())
+		{
+			ModelIterator.RemoveCurrent();
+			continue;
+		}
+
+		if (TargetModel.Component == CurrentFocusComponent)
+		{
+			TargetModel.TimeSinceAimedSecs = 0.0f;
+		}
+		else
+		{
+			TargetModel.TimeSinceAimedSecs += DeltaTimeSecs;
+			if (TargetModel.TimeSinceAimedSecs > TargetMemorySecs)
+			{
+				ModelIterator.RemoveCurrent();
+				continue;
+			}
+		}
+
+		TargetModel.Motion.Update(TargetModel.Component->GetComponentVelocity(), DeltaTimeSecs);
+	}
+}
+
+FVector UTobiiAimAtGazeComponent::PredictTargetFocusLocation(const FTobiiAimTargetModel& TargetModel) const
+{
+	if (!TargetModel.Component.IsValid())
+	{
+		return CurrentAimTarget;
+	}
+
+	const FTransform& ComponentTransform = TargetModel.Component->GetComponentTransform();
+	const FVector FocusLocation = ComponentTransform.GetLocation() + ComponentTransform.TransformVector(TargetModel.FocusOffset);
+	return FocusLocation + TargetModel.Motion.PredictOffset(AimSettleTimeSecs);
+}
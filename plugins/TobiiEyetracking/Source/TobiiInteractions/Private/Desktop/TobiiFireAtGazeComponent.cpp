@@ -27,8 +27,13 @@ UTobiiFireAtGazeComponent::UTobiiFireAtGazeComponent()
 	, MaxDistance(10000.0f)
 	, NoTargetBehavior(ETobiiFireAtGazeNoTargetBehavior::PointGunToGaze)
 	, TraceChannel(ECC_Visibility)
+
+	, PendingSpreadRequest()
+	, SpreadRequestSerial(0)
 {
 	PrimaryComponentTick.bCanEverTick = true;
+
+	SpreadTraceDelegate.BindUObject(this, &UTobiiFireAtGazeComponent::OnSpreadTraceCompleted);
 }
 
 bool UTobiiFireAtGazeComponent::FireAtGazeAvailable()
@@ -59,6 +64,13 @@ void UTobiiFireAtGazeComponent::TickComponent(float DeltaTime, enum ELevelTick T
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	if (PendingSpreadRequest.IsSet() && PendingSpreadRequest->NrOutstandingTraces <= 0)
+	{
+		FTobiiFireAtGazeSpreadRequest Request = MoveTemp(PendingSpreadRequest.GetValue());
+		PendingSpreadRequest.Reset();
+		Request.OnCompleted.ExecuteIfBound(Request.Pellets);
+	}
+
 	if (!FireAtGazeAvailable() || GEngine == nullptr || !GEngine->EyeTrackingDevice.IsValid())
 	{
 		return;
@@ -112,3 +124,140 @@ void UTobiiFireAtGazeComponent::TickComponent(float DeltaTime, enum ELevelTick T
 		}
 	}
 }
+
+bool UTobiiFireAtGazeComponent::CalculateFireAtGazeSpread(const TArray<FVector2D>& SpreadPatternDeg, TArray<FTobiiFireAtGazePellet>& OutPellets)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(STAT_TobiiEyetracking_FireAtGaze_Spread);
+
+	FVector Origin;
+	TSet<const UPrimitiveComponent*> FocusableComponents;
+	FCollisionQueryParams QueryParams;
+	if (!PrepareFireAtGazeSpread(SpreadPatternDeg, Origin, OutPellets, FocusableComponents, QueryParams))
+	{
+		return false;
+	}
+
+	UWorld* World = GetWorld();
+	for (FTobiiFireAtGazePellet& Pellet : OutPellets)
+	{
+		FHitResult HitResult;
+		const bool bHit = World->LineTraceSingleByChannel(HitResult, Origin, Origin + Pellet.Direction * MaxDistance, TraceChannel, QueryParams);
+		ApplyPelletHit(Pellet, bHit ? &HitResult : nullptr, Origin, FocusableComponents);
+	}
+
+	return true;
+}
+
+bool UTobiiFireAtGazeComponent::CalculateFireAtGazeSpreadAsync(const TArray<FVector2D>& SpreadPatternDeg, const FTobiiFireAtGazeSpreadCompletedSignature& OnCompleted)
+{
+	if (!OnCompleted.IsBound() || SpreadPatternDeg.Num() > 0xFFFF)
+	{
+		return false;
+	}
+
+	PendingSpreadRequest.Reset();
+
+	FTobiiFireAtGazeSpreadRequest Request;
+	FVector Origin;
+	FCollisionQueryParams QueryParams;
+	if (!PrepareFireAtGazeSpread(SpreadPatternDeg, Origin, Request.Pellets, Request.FocusableComponents, QueryParams))
+	{
+		return false;
+	}
+
+	Request.Serial = ++SpreadRequestSerial;
+	Request.NrOutstandingTraces = Request.Pellets.Num();
+	Request.OnCompleted = OnCompleted;
+
+	// Until the traces come back, pellets point at the end of their rays.
+	for (FTobiiFireAtGazePellet& Pellet : Request.Pellets)
+	{
+		ApplyPelletHit(Pellet, nullptr, Origin, Request.FocusableComponents);
+	}
+
+	UWorld* World = GetWorld();
+	for (int32 PelletIdx = 0; PelletIdx < Request.Pellets.Num(); PelletIdx++)
+	{
+		const uint32 UserData = ((uint32)Request.Serial << 16) | (uint32)PelletIdx;
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Origin, Origin + Request.Pellets[PelletIdx].Direction * MaxDistance, TraceChannel, QueryParams
+			, FCollisionResponseParams::DefaultResponseParam, &SpreadTraceDelegate, UserData);
+	}
+
+	PendingSpreadRequest = MoveTemp(Request);
+	return true;
+}
+
+bool UTobiiFireAtGazeComponent::PrepareFireAtGazeSpread(const TArray<FVector2D>& SpreadPatternDeg, FVector& OutOrigin, TArray<FTobiiFireAtGazePellet>& OutPellets, TSet<const UPrimitiveComponent*>& OutFocusableComponents, FCollisionQueryParams& OutQueryParams)
+{
+	OutPellets.Reset();
+	OutFocusableComponents.Reset();
+
+	if (!FireAtGazeAvailable() || GetWorld() == nullptr)
+	{
+		return false;
+	}
+
+	// All pellets are centered on the target resolved this tick, so we don't need to redo the focus lookup per pellet.
+	OutOrigin = CameraComponent->GetComponentLocation();
+	FVector CenterDirection = FireAtGazeTargetLocation - OutOrigin;
+	if (!CenterDirection.Normalize())
+	{
+		CenterDirection = CameraComponent->GetForwardVector();
+	}
+	const FQuat CenterQuat = CenterDirection.ToOrientationQuat();
+
+	OutPellets.Reserve(SpreadPatternDeg.Num());
+	for (const FVector2D& PelletSpreadDeg : SpreadPatternDeg)
+	{
+		FTobiiFireAtGazePellet& Pellet = OutPellets.AddDefaulted_GetRef();
+		Pellet.Direction = CenterQuat.RotateVector(FRotator(PelletSpreadDeg.Y, PelletSpreadDeg.X, 0.0f).Vector());
+	}
+
+	// One pass over the GTOM focus data for the whole volley.
+	TArray<FTobiiGazeFocusData> AllFocusData;
+	UTobiiGTOMBlueprintLibrary::GetAllFilteredGazeFocusData(FocusLayerFilters, bIsWhiteList, true, false, AllFocusData);
+	OutFocusableComponents.Reserve(AllFocusData.Num());
+	for (const FTobiiGazeFocusData& FocusData : AllFocusData)
+	{
+		if (FocusData.FocusedPrimitiveComponent.IsValid())
+		{
+			OutFocusableComponents.Add(FocusData.FocusedPrimitiveComponent.Get());
+		}
+	}
+
+	OutQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(TobiiFireAtGazeSpread));
+	OutQueryParams.AddIgnoredActor(GetOwner());
+	return true;
+}
+
+void UTobiiFireAtGazeComponent::ApplyPelletHit(FTobiiFireAtGazePellet& Pellet, const FHitResult* HitResult, const FVector& Origin, const TSet<const UPrimitiveComponent*>& FocusableComponents) const
+{
+	if (HitResult != nullptr && HitResult->bBlockingHit)
+	{
+		Pellet.TargetActor = HitResult->GetActor();
+		Pellet.TargetComponent = HitResult->GetComponent();
+		Pellet.TargetLocation = HitResult->Location;
+		Pellet.bHitGazeFocusable = FocusableComponents.Contains(HitResult->GetComponent());
+	}
+	else
+	{
+		Pellet.TargetActor = nullptr;
+		Pellet.TargetComponent = nullptr;
+		Pellet.TargetLocation = Origin + Pellet.Direction * MaxDistance;
+		Pellet.bHitGazeFocusable = false;
+	}
+}
+
+void UTobiiFireAtGazeComponent::OnSpreadTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	const uint16 Serial = (uint16)(TraceDatum.UserData >> 16);
+	const int32 PelletIdx = (int32)(TraceDatum.UserData & 0xFFFF);
+	if (!PendingSpreadRequest.IsSet() || PendingSpreadRequest->Serial != Serial || !PendingSpreadRequest->Pellets.IsValidIndex(PelletIdx))
+	{
+		return;
+	}
+
+	FTobiiFireAtGazeSpreadRequest& Request = PendingSpreadRequest.GetValue();
+	ApplyPelletHit(Request.Pellets[PelletIdx], TraceDatum.OutHits.Num() > 0 ? &TraceDatum.OutHits[0] : nullptr, TraceDatum.Start, Request.FocusableComponents);
+	Request.NrOutstandingTraces--;
+}
@@ -11,9 +11,12 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Components/PrimitiveComponent.h"
+#include "WorldCollision.h"
 
 #include "TobiiThrowAtGazeComponent.generated.h"
 
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FTobiiThrowAtGazeCompletedSignature, ETobiiThrowAtGazeResult, Result, const FTobiiBallisticResult&, BallisticResult, const TArray<FVector>&, TracedPath);
+
 /**
   * This component will generate gaze contingent throw vectors on demand.
   * You can use this vector to either simulate a trajectory yourself, or simply apply it to the rigid body of some object.
@@ -87,6 +90,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw@gaze Configuration")
 	float NoTargetAcceptanceThreshold;
 
+	// When using the async functions, this is the maximum number of trace segments that will be dispatched per frame. Any remaining segments are dispatched on the following frames.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw@gaze Configuration")
+	int32 MaxAsyncTracesPerFrame;
+
 	// This is the channel that will be used when tracing.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Throw@gaze Configuration")
 	TEnumAsByte<ECollisionChannel> TraceChannel;
@@ -160,10 +167,77 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Throw@gaze")
 	ETobiiThrowAtGazeResult CalculateThrowArc(const FVector& ThrowOrigin, const FVector& TargetLocation, const FVector& TargetVelocity, const FVector& TargetAcceleration, FTobiiBallisticResult& OutBallisticResult, TArray<FVector>& OutTracedPath);
 
+	/**
+	  * Async version of CalculateThrowAtGazeVector.
+	  * Instead of testing apexes one by one on the calling thread, every candidate arc is solved up front and its path segments are swept using async traces, spread over frames according to MaxAsyncTracesPerFrame.
+	  * OnCompleted is invoked on the game thread from TickComponent once all candidates have been traced, usually the frame after the request.
+	  * Only one request can be in flight per component. Starting a new request will cancel the previous one without invoking its delegate.
+	  *
+	  * @param ThrowOrigin	This is where the projectile will start.
+	  * @param OnCompleted	This will receive the best result and its traced path.
+	  * @return				Whether the request could be started. If this is false, OnCompleted will never be invoked.
+	  */
+	UFUNCTION(BlueprintCallable, Category = "Throw@gaze")
+	bool CalculateThrowAtGazeVectorAsync(const FVector& ThrowOrigin, const FTobiiThrowAtGazeCompletedSignature& OnCompleted);
+
+	/**
+	  * Async version of CalculateThrowArc. See CalculateThrowAtGazeVectorAsync for details.
+	  */
+	UFUNCTION(BlueprintCallable, Category = "Throw@gaze")
+	bool CalculateThrowArcAsync(const FVector& ThrowOrigin, const FVector& TargetLocation, const FVector& TargetVelocity, const FVector& TargetAcceleration, const FTobiiThrowAtGazeCompletedSignature& OnCompleted);
+
+	UFUNCTION(BlueprintPure, Category = "Throw@gaze")
+	bool IsAsyncThrowPending() const;
+
+	// Cancels the currently pending async request, if any. Its delegate will not be invoked.
+	UFUNCTION(BlueprintCallable, Category = "Throw@gaze")
+	void CancelAsyncThrow();
+
 public:
 	void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 
 private:
-	FVector LastTargetVelocity;
-	FVector CalculatedTargetAcceleration;
+	struct FTobiiAsyncThrowCandidate
+	{
+		FTobiiBallisticResult Result;
+		float ApexOffsetCm;
+		bool bIsInRange;
+		int32 NrCompletedSegments;
+		int32 FirstHitSegmentIdx;
+		FHitResult FirstHit;
+	};
+
+	struct FTobiiAsyncThrowRequest
+	{
+		uint8 Serial;
+		FVector ThrowOrigin;
+		FVector TargetLocation;
+		TWeakObjectPtr<AActor> TargetActor;
+		FVector ProjectileAcceleration;
+		FCollisionQueryParams CollisionParams;
+		int32 NrSegmentsPerCandidate;
+		TArray<FTobiiAsyncThrowCandidate> Candidates;
+		int32 NextCandidateToDispatch;
+		int32 NextSegmentToDispatch;
+		int32 NrOutstandingSegments;
+		FTobiiThrowAtGazeCompletedSignature OnCompleted;
+	};
+
+	FTobiiTargetMotionEstimate ThrowTargetMotion;
+	TWeakObjectPtr<UPrimitiveComponent> ThrowTargetMotionSource;
+
+	TOptional<FTobiiAsyncThrowRequest> PendingAsyncThrow;
+	uint8 AsyncThrowSerial;
+	FTraceDelegate AsyncThrowTraceDelegate;
+
+	bool FindThrowAtGazeTarget(FVector& OutTargetLocation, FVector& OutTargetVelocity, FVector& OutTargetAcceleration, ETobiiThrowAtGazeResult& OutError);
+	void GatherApexesToTest(TArray<float>& OutApexesToTest) const;
+	bool IsThrowPathClear(const FHitResult& HitResult, const FVector& TargetLocation, const AActor* TargetActor, float& OutDistanceToTargetSq) const;
+	void ConsiderThrowCandidate(const FTobiiBallisticResult& Result, bool bIsInRange, bool bWayIsClear, float DistanceToTargetSq, const TArray<FVector>& TracedPath
+		, ETobiiThrowAtGazeResult& InOutBestResultStatus, float& InOutBestResultDistanceToTargetSq, FTobiiBallisticResult& OutBallisticResult, TArray<FVector>& OutTracedPath) const;
+	void DrawThrowCandidateDebug(const TArray<FVector>& TracedPath, float ApexOffsetCm, bool bWayIsClear);
+
+	void DispatchAsyncThrowTraces();
+	void FinishAsyncThrow();
+	void OnAsyncThrowTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
 };
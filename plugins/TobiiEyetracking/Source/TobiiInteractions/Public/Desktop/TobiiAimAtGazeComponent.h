@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include "TobiiInteractionsTypes.h"
+#include "TobiiGTOMTypes.h"
+
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 
@@ -34,6 +37,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim@gaze")
 	float AimSpeed;
 
+	//If this is true, a motion model is kept for each target and moving targets will be led by AimSettleTimeSecs instead of aimed at where they were last seen.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim@gaze Target Tracking")
+	bool bPredictTargetMotion;
+
+	//This is roughly how long it takes for the aim to settle on a target. Moving targets are led by this amount of time if bPredictTargetMotion is true.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim@gaze Target Tracking")
+	float AimSettleTimeSecs;
+
+	//Motion models for targets that have not been aimed at for longer than this are discarded.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Aim@gaze Target Tracking")
+	float TargetMemorySecs;
+
 public:
 	//Use this to test if the user has turned aim@gaze on and it is available.
 	UFUNCTION(BlueprintPure, Category = "Aim@gaze")
@@ -54,7 +69,21 @@ public:
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 
 private:
+	struct FTobiiAimTargetModel
+	{
+		TWeakObjectPtr<class UPrimitiveComponent> Component;
+		FVector FocusOffset;
+		FTobiiTargetMotionEstimate Motion;
+		float TimeSinceAimedSecs;
+	};
+
 	TWeakObjectPtr<class UPrimitiveComponent> CurrentFocusComponent;
 	FVector CurrentAimTarget;
 	bool bIsGazeAiming;
+
+	TMap<FEngineFocusableUID, FTobiiAimTargetModel> TargetModels;
+
+	FTobiiAimTargetModel& FindOrAddTargetModel(class UPrimitiveComponent& Component);
+	void UpdateTargetModels(float DeltaTimeSecs);
+	FVector PredictTargetFocusLocation(const FTobiiAimTargetModel& TargetModel) const;
 };
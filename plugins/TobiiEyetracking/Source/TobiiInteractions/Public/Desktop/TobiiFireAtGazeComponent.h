@@ -8,6 +8,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "WorldCollision.h"
 
 #include "TobiiFireAtGazeComponent.generated.h"
 
@@ -18,6 +19,41 @@ enum class ETobiiFireAtGazeNoTargetBehavior : uint8
 	PointGunToGaze
 };
 
+USTRUCT(BlueprintType)
+struct FTobiiFireAtGazePellet
+{
+	GENERATED_BODY()
+
+public:
+	FTobiiFireAtGazePellet()
+		: Direction(FVector::ForwardVector)
+		, TargetLocation(FVector::ZeroVector)
+		, TargetActor()
+		, TargetComponent()
+		, bHitGazeFocusable(false)
+	{}
+
+	//This is the world space direction of the pellet from the camera.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pellet Data")
+	FVector Direction;
+
+	//This is where the pellet will hit, or the end of the trace at MaxDistance if nothing was hit.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pellet Data")
+	FVector TargetLocation;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pellet Data")
+	TWeakObjectPtr<AActor> TargetActor;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pellet Data")
+	TWeakObjectPtr<UPrimitiveComponent> TargetComponent;
+
+	//This is true if the pellet hit a focusable that is currently considered by GTOM, given the component's focus layer filters.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pellet Data")
+	bool bHitGazeFocusable;
+};
+
+DECLARE_DYNAMIC_DELEGATE_OneParam(FTobiiFireAtGazeSpreadCompletedSignature, const TArray<FTobiiFireAtGazePellet>&, Pellets);
+
 UCLASS(BlueprintType, Blueprintable, meta = (BlueprintSpawnableComponent))
 class TOBIIINTERACTIONS_API UTobiiFireAtGazeComponent : public UActorComponent
 {
@@ -60,9 +96,47 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Fire@gaze")
 	bool WantsCrosshair();
 
+	/**
+	  * Resolves targets for a whole volley of pellets around the current fire@gaze target, for shotguns, burst weapons etc.
+	  * The GTOM focus data is fetched once for the whole volley and the pellet traces share the same query setup.
+	  *
+	  * @param SpreadPatternDeg	Yaw (X) and pitch (Y) offsets in degrees for each pellet, relative to the direction from the camera to FireAtGazeTargetLocation.
+	  * @param OutPellets		One resolved pellet per entry in SpreadPatternDeg.
+	  * @return					Whether fire@gaze was available. If false, OutPellets will be empty.
+	  */
+	UFUNCTION(BlueprintCallable, Category = "Fire@gaze")
+	bool CalculateFireAtGazeSpread(const TArray<FVector2D>& SpreadPatternDeg, TArray<FTobiiFireAtGazePellet>& OutPellets);
+
+	/**
+	  * Async version of CalculateFireAtGazeSpread. The pellet traces are issued as async traces and OnCompleted is invoked from TickComponent once they have all completed, usually the next frame.
+	  * Only one volley can be in flight per component. Starting a new one cancels the previous one without invoking its delegate.
+	  *
+	  * @return Whether the request could be started. If this is false, OnCompleted will never be invoked.
+	  */
+	UFUNCTION(BlueprintCallable, Category = "Fire@gaze")
+	bool CalculateFireAtGazeSpreadAsync(const TArray<FVector2D>& SpreadPatternDeg, const FTobiiFireAtGazeSpreadCompletedSignature& OnCompleted);
+
 	/************************************************************************/
 	/* UActorComponent                                                      */
 	/************************************************************************/
 public:
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+
+private:
+	struct FTobiiFireAtGazeSpreadRequest
+	{
+		uint16 Serial;
+		TArray<FTobiiFireAtGazePellet> Pellets;
+		TSet<const UPrimitiveComponent*> FocusableComponents;
+		int32 NrOutstandingTraces;
+		FTobiiFireAtGazeSpreadCompletedSignature OnCompleted;
+	};
+
+	TOptional<FTobiiFireAtGazeSpreadRequest> PendingSpreadRequest;
+	uint16 SpreadRequestSerial;
+	FTraceDelegate SpreadTraceDelegate;
+
+	bool PrepareFireAtGazeSpread(const TArray<FVector2D>& SpreadPatternDeg, FVector& OutOrigin, TArray<FTobiiFireAtGazePellet>& OutPellets, TSet<const UPrimitiveComponent*>& OutFocusableComponents, FCollisionQueryParams& OutQueryParams);
+	void ApplyPelletHit(FTobiiFireAtGazePellet& Pellet, const FHitResult* HitResult, const FVector& Origin, const TSet<const UPrimitiveComponent*>& FocusableComponents) const;
+	void OnSpreadTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
 };
@@ -144,3 +144,46 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Source Data")
 	FVector ProjectileAcceleration;
 };
+
+/**
+  * Exponentially smoothed acceleration estimate for a moving target, fed with the target's velocity once per tick.
+  * This is what the gaze interactions use to lead moving targets.
+  */
+struct FTobiiTargetMotionEstimate
+{
+public:
+	FTobiiTargetMotionEstimate()
+		: LastVelocity(FVector::ZeroVector)
+		, Acceleration(FVector::ZeroVector)
+		, bHasSample(false)
+	{}
+
+	void Update(const FVector& CurrentVelocity, float DeltaTimeSecs)
+	{
+		const float AccelerationLerpSpeed = 0.7f;
+		if (bHasSample && DeltaTimeSecs > SMALL_NUMBER)
+		{
+			Acceleration = FMath::Lerp(Acceleration, (CurrentVelocity - LastVelocity) / DeltaTimeSecs, AccelerationLerpSpeed);
+		}
+
+		LastVelocity = CurrentVelocity;
+		bHasSample = true;
+	}
+
+	void Reset()
+	{
+		LastVelocity = FVector::ZeroVector;
+		Acceleration = FVector::ZeroVector;
+		bHasSample = false;
+	}
+
+	FVector PredictOffset(float LeadTimeSecs) const
+	{
+		return LastVelocity * LeadTimeSecs + 0.5f * Acceleration * LeadTimeSecs * LeadTimeSecs;
+	}
+
+public:
+	FVector LastVelocity;
+	FVector Acceleration;
+	bool bHasSample;
+};
@@ -1,8 +1,8 @@
 //Based off the "Arduino and C++ (for Windows)" code found at: http://playground.arduino.cc/Interfacing/CPPWindows
+//Platform specific port handling lives in SerialWindows.cpp and SerialPosix.cpp.
 
 #include "Serial.h"
-
-#define BOOL2bool(B) B == 0 ? false : true
+#include "SerialIOWorker.h"
 
 USerial* USerial::OpenComPort(bool &bOpened, int32 Port, int32 BaudRate)
 {
@@ -47,12 +47,27 @@ TArray<uint8> USerial::FloatToBytes(const float &Float)
 
 USerial::USerial()
 	: WriteLineEnd(ELineEnd::n)
+	, AsyncLineTerminator('\n')
+#if PLATFORM_WINDOWS
 	, m_hIDComDev(NULL)
+#else
+	, m_FileDescriptor(-1)
+#endif
 	, m_Port(-1)
 	, m_Baud(-1)
+	, m_OpenCount(0)
+	, m_bDeviceError(false)
+	, m_AsyncWorker(nullptr)
+	, m_TotalBytesQueued(0)
+	, m_TotalBytesWritten(0)
+	, m_LastWriteCycles(0)
+	, m_NextFrameSequence(0)
+	, m_ReadBuffer(8192)
 {
+#if PLATFORM_WINDOWS
 	FMemory::Memset(&m_OverlappedRead, 0, sizeof(OVERLAPPED));
 	FMemory::Memset(&m_OverlappedWrite, 0, sizeof(OVERLAPPED));
+#endif
 }
 
 USerial::~USerial()
@@ -67,77 +82,102 @@ bool USerial::Open(int32 nPort, int32 nBaud)
 		UE_LOG(LogTemp, Error, TEXT("Invalid port number: %d"), nPort);
 		return false;
 	}
-	if (m_hIDComDev)
+	if (IsOpened())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Trying to use opened Serial instance to open a new one. "
 				"Current open instance port: %d | Port tried: %d"), m_Port, nPort);
 		return false;
 	}
 
-	FString szPort;
-	if (nPort < 10)
-		szPort = FString::Printf(TEXT("COM%d"), nPort);
-	else
-		szPort = FString::Printf(TEXT("\\\\.\\COM%d"), nPort);
-	DCB dcb;
+	const TArray<FString> DevicePaths = GetDevicePathsForPort(nPort);
+	if (DevicePaths.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("No serial device found for port %d"), nPort);
+		return false;
+	}
 
-	m_hIDComDev = CreateFile(*szPort, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, NULL);
-	if (m_hIDComDev == NULL)
+	for (const FString& DevicePath : DevicePaths)
 	{
-		unsigned long dwError = GetLastError();
-		UE_LOG(LogTemp, Error, TEXT("Failed to open port COM%d (%s). Error: %08X"), nPort, *szPort, dwError);
+		if (OpenDevice(DevicePath, nBaud))
+		{
+			OnDeviceOpened(DevicePath, nPort, nBaud);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool USerial::OpenPath(FString DevicePath, int32 BaudRate)
+{
+	if (IsOpened())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trying to use opened Serial instance to open a new one. "
+				"Current open instance: %s | Device tried: %s"), *m_PortName, *DevicePath);
 		return false;
 	}
 
-	FMemory::Memset(&m_OverlappedRead, 0, sizeof(OVERLAPPED));
-	FMemory::Memset(&m_OverlappedWrite, 0, sizeof(OVERLAPPED));
+	if (!OpenDevice(DevicePath, BaudRate)) return false;
+
+	OnDeviceOpened(DevicePath, -1, BaudRate);
+	return true;
+}
+
+bool USerial::AdoptOpenedDevice(const FString& DevicePath, int32 nBaud, FSerialDeviceHandle Handle)
+{
+	if (IsOpened())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trying to use opened Serial instance to open a new one. "
+				"Current open instance: %s | Device tried: %s"), *m_PortName, *DevicePath);
+		CloseDeviceHandle(Handle);
+		return false;
+	}
+
+	if (!AdoptDeviceHandle(Handle)) return false;
+
+	OnDeviceOpened(DevicePath, -1, nBaud);
+	return true;
+}
 
-	COMMTIMEOUTS CommTimeOuts;
-	//CommTimeOuts.ReadIntervalTimeout = 10;
-	CommTimeOuts.ReadIntervalTimeout = 0xFFFFFFFF;
-	CommTimeOuts.ReadTotalTimeoutMultiplier = 0;
-	CommTimeOuts.ReadTotalTimeoutConstant = 0;
-	CommTimeOuts.WriteTotalTimeoutMultiplier = 0;
-	CommTimeOuts.WriteTotalTimeoutConstant = 10;
-	SetCommTimeouts(m_hIDComDev, &CommTimeOuts);
-
-	m_OverlappedRead.hEvent = CreateEvent(NULL, true, false, NULL);
-	m_OverlappedWrite.hEvent = CreateEvent(NULL, true, false, NULL);
-
-	dcb.DCBlength = sizeof(DCB);
-	GetCommState(m_hIDComDev, &dcb);
-	dcb.BaudRate = nBaud;
-	dcb.ByteSize = 8;
-
-	if (!SetCommState(m_hIDComDev, &dcb) ||
-		!SetupComm(m_hIDComDev, 10000, 10000) ||
-		m_OverlappedRead.hEvent == NULL ||
-		m_OverlappedWrite.hEvent == NULL)
+bool USerial::OpenVirtual(TSharedRef<ISerialVirtualDevice, ESPMode::ThreadSafe> Device, const FString& DeviceName, int32 nBaud)
+{
+	if (IsOpened())
 	{
-		unsigned long dwError = GetLastError();
-		if (m_OverlappedRead.hEvent != NULL) CloseHandle(m_OverlappedRead.hEvent);
-		if (m_OverlappedWrite.hEvent != NULL) CloseHandle(m_OverlappedWrite.hEvent);
-		CloseHandle(m_hIDComDev);
-		m_hIDComDev = NULL;
-		UE_LOG(LogTemp, Error, TEXT("Failed to setup port COM%d. Error: %08X"), nPort, dwError);
+		UE_LOG(LogTemp, Warning, TEXT("Trying to use opened Serial instance to open a new one. "
+				"Current open instance: %s | Device tried: %s"), *m_PortName, *DeviceName);
 		return false;
 	}
 
-	//FPlatformProcess::Sleep(0.05f);
+	m_VirtualDevice = Device;
+	OnDeviceOpened(DeviceName, -1, nBaud);
+	return true;
+}
+
+bool USerial::OpenDevice(const FString& DevicePath, int32 nBaud)
+{
+	FSerialDeviceHandle Handle;
+	return OpenDeviceHandle(DevicePath, nBaud, Handle) && AdoptDeviceHandle(Handle);
+}
+
+void USerial::OnDeviceOpened(const FString& DevicePath, int32 nPort, int32 nBaud)
+{
 	AddToRoot();
+	m_OpenCount++;
+	m_bDeviceError = false;
 	m_Port = nPort;
 	m_Baud = nBaud;
-	return true;
+	m_PortName = DevicePath;
+	m_ReadBuffer.Reset();
+	m_FrameCodec.Reset();
 }
 
 void USerial::Close()
 {
-	if (!m_hIDComDev) return;
+	if (!IsOpened()) return;
 
-	if (m_OverlappedRead.hEvent != NULL) CloseHandle(m_OverlappedRead.hEvent);
-	if (m_OverlappedWrite.hEvent != NULL) CloseHandle(m_OverlappedWrite.hEvent);
-	CloseHandle(m_hIDComDev);
-	m_hIDComDev = NULL;
+	StopAsync();
+	CloseDevice();
+	m_ReadBuffer.Reset();
 
 	RemoveFromRoot();
 }
@@ -154,56 +194,59 @@ FString USerial::Readln(bool &bSuccess)
 
 FString USerial::ReadStringUntil(bool &bSuccess, uint8 Terminator)
 {
-	bSuccess = false;
-	if (!m_hIDComDev) return TEXT("");
+	TArrayView<const uint8> Line;
+	bSuccess = ReadLineView(Line, Terminator, true);
+	if (!bSuccess) return TEXT("");
 
-	TArray<uint8> Chars;
-	uint8 Byte = 0x0;
-	bool bReadStatus;
-	unsigned long dwBytesRead, dwErrorFlags;
-	COMSTAT ComStat;
+	auto Convert = FUTF8ToTCHAR((const ANSICHAR*)Line.GetData(), Line.Num());
+	return FString(Convert.Length(), Convert.Get());
+}
 
-	ClearCommError(m_hIDComDev, &dwErrorFlags, &ComStat);
-	if (!ComStat.cbInQue) return TEXT("");
+bool USerial::ReadLineView(TArrayView<const uint8>& OutLine, uint8 Terminator, bool bAllowPartialLine)
+{
+	OutLine = TArrayView<const uint8>();
+	if (!IsOpened()) return false;
 
-	do {
-		bReadStatus = BOOL2bool(ReadFile(
-			m_hIDComDev,
-			&Byte,
-			1,
-			&dwBytesRead,
-			&m_OverlappedRead));
-
-		if (!bReadStatus)
-		{
-			if (GetLastError() == ERROR_IO_PENDING)
-			{
-				WaitForSingleObject(m_OverlappedRead.hEvent, 2000);
-			}
-			else
-			{
-				Chars.Add(0x0);
-				break;
-			}
-		}
+	int32 TerminatorIdx = m_ReadBuffer.Find(Terminator);
+	if (TerminatorIdx == INDEX_NONE && FillReadBuffer() > 0)
+	{
+		TerminatorIdx = m_ReadBuffer.Find(Terminator);
+	}
 
-		if (Byte == Terminator || dwBytesRead == 0)
-		{
-			// when Terminator is \n, we know we're expecting lines from Arduino. But those
-			// are ended in \r\n. That means that if we found the line Terminator (\n), our previous
-			// character could be \r. If it is, we remove that from the array.
-			if (Chars.Num() > 0 && Terminator == '\n' && Chars.Top() == '\r') Chars.Pop(false);
+	if (TerminatorIdx != INDEX_NONE)
+	{
+		// when Terminator is \n, we know we're expecting lines from Arduino. But those
+		// are ended in \r\n. That means that if we found the line Terminator (\n), our previous
+		// character could be \r. If it is, we leave that out of the line.
+		int32 LineLength = TerminatorIdx;
+		if (LineLength > 0 && Terminator == '\n' && m_ReadBuffer.GetData()[LineLength - 1] == '\r') LineLength--;
+
+		OutLine = TArrayView<const uint8>(m_ReadBuffer.GetData(), LineLength);
+		m_ReadBuffer.Consume(TerminatorIdx + 1);
+		return true;
+	}
 
-			Chars.Add(0x0);
-			break;
-		}
-		else Chars.Add(Byte);
+	// A full buffer without a terminator can never complete, so hand it out rather than stalling forever.
+	if ((bAllowPartialLine && m_ReadBuffer.Num() > 0) || m_ReadBuffer.IsFull())
+	{
+		OutLine = TArrayView<const uint8>(m_ReadBuffer.GetData(), m_ReadBuffer.Num());
+		m_ReadBuffer.Consume(m_ReadBuffer.Num());
+		return true;
+	}
+
+	return false;
+}
 
-	} while (Byte != 0x0 && Byte != Terminator);
+bool USerial::TryReadLine(FString& OutLine, uint8 Terminator)
+{
+	OutLine.Reset();
 
-	bSuccess = true;
-	auto Convert = FUTF8ToTCHAR((ANSICHAR*)Chars.GetData());
-	return FString(Convert.Get());
+	TArrayView<const uint8> Line;
+	if (!ReadLineView(Line, Terminator, false)) return false;
+
+	auto Convert = FUTF8ToTCHAR((const ANSICHAR*)Line.GetData(), Line.Num());
+	OutLine.AppendChars(Convert.Get(), Convert.Length());
+	return true;
 }
 
 float USerial::ReadFloat(bool &bSuccess)
@@ -230,77 +273,45 @@ int32 USerial::ReadInt(bool &bSuccess)
 
 uint8 USerial::ReadByte(bool &bSuccess)
 {
-	bSuccess = false;
-	if (!m_hIDComDev) return 0x0;
-
 	uint8 Byte = 0x0;
-	bool bReadStatus;
-	unsigned long dwBytesRead, dwErrorFlags;
-	COMSTAT ComStat;
-
-	ClearCommError(m_hIDComDev, &dwErrorFlags, &ComStat);
-	if (!ComStat.cbInQue) return 0x0;
-
-	bReadStatus = BOOL2bool(ReadFile(
-		m_hIDComDev,
-		&Byte,
-		1,
-		&dwBytesRead,
-		&m_OverlappedRead));
-
-	if (!bReadStatus)
-	{
-		if (GetLastError() == ERROR_IO_PENDING)
-		{
-			WaitForSingleObject(m_OverlappedRead.hEvent, 2000);
-		}
-		else
-		{
-			return 0x0;
-		}
-	}
-
-	bSuccess = dwBytesRead > 0;
+	bSuccess = ReadBufferedBytes(&Byte, 1) > 0;
 	return Byte;
 }
 
 TArray<uint8> USerial::ReadBytes(int32 Limit)
 {
 	TArray<uint8> Data;
+	if (!IsOpened() || Limit <= 0) return Data;
 
-	if (!m_hIDComDev) return Data;
-
-	Data.Empty(Limit);
-
-	uint8* Buffer = new uint8[Limit];
-	bool bReadStatus;
-	unsigned long dwBytesRead, dwErrorFlags;
-	COMSTAT ComStat;
-
-	ClearCommError(m_hIDComDev, &dwErrorFlags, &ComStat);
-	if (!ComStat.cbInQue) return Data;
+	Data.SetNumUninitialized(Limit);
+	Data.SetNum(ReadBufferedBytes(Data.GetData(), Limit), false);
+	return Data;
+}
 
-	bReadStatus = BOOL2bool(ReadFile(
-		m_hIDComDev,
-		Buffer,
-		Limit,
-		&dwBytesRead,
-		&m_OverlappedRead));
+int32 USerial::ReadBufferedBytes(uint8* Dest, int32 MaxBytes)
+{
+	if (!IsOpened() || MaxBytes <= 0) return 0;
 
-	if (!bReadStatus)
+	// Anything left over from line reads comes first, then go straight to the source without an extra copy.
+	int32 NumRead = m_ReadBuffer.Read(Dest, MaxBytes);
+	if (NumRead < MaxBytes)
 	{
-		if (GetLastError() == ERROR_IO_PENDING)
-		{
-			WaitForSingleObject(m_OverlappedRead.hEvent, 2000);
-		}
-		else
-		{
-			return Data;
-		}
+		NumRead += FMath::Max(m_AsyncWorker ? m_AsyncWorker->Read(Dest + NumRead, MaxBytes - NumRead)
+			: ReadAvailableBytes(Dest + NumRead, MaxBytes - NumRead), 0);
 	}
 
-	Data.Append(Buffer, dwBytesRead);
-	return Data;
+	return NumRead;
+}
+
+int32 USerial::FillReadBuffer()
+{
+	int32 Space;
+	uint8* WriteSpace = m_ReadBuffer.GetWriteSpace(Space);
+	if (Space <= 0) return 0;
+
+	const int32 NumRead = m_AsyncWorker ? m_AsyncWorker->Read(WriteSpace, Space) : ReadAvailableBytes(WriteSpace, Space);
+	m_ReadBuffer.CommitWrite(NumRead);
+	return FMath::Max(NumRead, 0);
 }
 
 bool USerial::Print(FString String)
@@ -339,33 +350,124 @@ bool USerial::WriteByte(uint8 Value)
 
 bool USerial::WriteBytes(TArray<uint8> Buffer)
 {
-	if (!m_hIDComDev) false;
+	if (!IsOpened()) return false;
 
-	bool bWriteStat;
-	unsigned long dwBytesWritten;
+	if (m_AsyncWorker)
+	{
+		return Enqueue(Buffer);
+	}
 
-	bWriteStat = BOOL2bool(WriteFile(m_hIDComDev, Buffer.GetData(), Buffer.Num(), &dwBytesWritten, &m_OverlappedWrite));
-	if (!bWriteStat && (GetLastError() == ERROR_IO_PENDING))
+	m_TotalBytesQueued += Buffer.Num();
+
+	int32 NumWritten = 0;
+	while (NumWritten < Buffer.Num())
 	{
-		if (WaitForSingleObject(m_OverlappedWrite.hEvent, 1000))
+		const int32 NumWrittenNow = WriteRawBytes(Buffer.GetData() + NumWritten, Buffer.Num() - NumWritten);
+		if (NumWrittenNow <= 0)
 		{
-			dwBytesWritten = 0;
+			//Keep the queued and written totals comparable, the rest of the buffer is never going out.
+			m_TotalBytesQueued -= Buffer.Num() - NumWritten;
 			return false;
 		}
-		else
-		{
-			GetOverlappedResult(m_hIDComDev, &m_OverlappedWrite, &dwBytesWritten, false);
-			m_OverlappedWrite.Offset += dwBytesWritten;
-			return true;
-		}
+
+		NoteBytesWritten(NumWrittenNow);
+		NumWritten += NumWrittenNow;
+	}
+
+	return true;
+}
+
+void USerial::NoteBytesWritten(int32 NumBytes)
+{
+	//Time first, so whoever sees the new total also sees a time at least as recent as this write.
+	m_LastWriteCycles = FPlatformTime::Cycles64();
+	m_TotalBytesWritten += (uint64)NumBytes;
+}
+
+uint64 USerial::GetTotalBytesWritten(double& OutLastWriteTime) const
+{
+	const uint64 TotalBytesWritten = m_TotalBytesWritten;
+	OutLastWriteTime = FPlatformTime::ToSeconds64(m_LastWriteCycles);
+	return TotalBytesWritten;
+}
+
+bool USerial::WriteFrame(uint8 CommandId, const TArray<uint8>& Payload, int32& Sequence)
+{
+	Sequence = -1;
+	if (!WriteFrameWithSequence(CommandId, Payload, m_NextFrameSequence)) return false;
+
+	Sequence = m_NextFrameSequence++;
+	return true;
+}
+
+bool USerial::WriteFrameWithSequence(uint8 CommandId, const TArray<uint8>& Payload, uint8 Sequence)
+{
+	if (!IsOpened()) return false;
+
+	m_FrameScratch.Reset();
+	if (!FSerialFrameCodec::Encode(CommandId, Sequence, Payload.GetData(), Payload.Num(), m_FrameScratch))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Frame payload too large: %d bytes, the limit is %d"), Payload.Num(), SERIAL_FRAME_MAX_PAYLOAD);
+		return false;
 	}
 
+	return WriteBytes(m_FrameScratch);
+}
+
+bool USerial::WriteDriveFrame(int32 LeftDuty, int32 RightDuty, int32& Sequence)
+{
+	return WriteFrame((uint8)ESerialFrameCommand::Drive, MakeDrivePayload(LeftDuty, RightDuty), Sequence);
+}
+
+TArray<uint8> USerial::MakeDrivePayload(int32 LeftDuty, int32 RightDuty)
+{
+	const int16 Left = (int16)FMath::Clamp(LeftDuty, -255, 255);
+	const int16 Right = (int16)FMath::Clamp(RightDuty, -255, 255);
+	return TArray<uint8>({
+		(uint8)(Left & 0xFF), (uint8)((Left >> 8) & 0xFF),
+		(uint8)(Right & 0xFF), (uint8)((Right >> 8) & 0xFF)
+	});
+}
+
+bool USerial::ReadFrame(FSerialFrame& OutFrame)
+{
+	if (!IsOpened()) return false;
+
+	//The codec remembers partial frames, so everything handed to it can be consumed right away.
+	bool bFrameReady = false;
+	do {
+		if (m_ReadBuffer.Num() == 0 && !m_FrameCodec.HasPendingBytes() && FillReadBuffer() <= 0) break;
+
+		m_ReadBuffer.Consume(m_FrameCodec.Decode(m_ReadBuffer.GetData(), m_ReadBuffer.Num(), OutFrame, bFrameReady));
+	} while (!bFrameReady);
+
+	return bFrameReady;
+}
+
+bool USerial::BreakAckFrame(const FSerialFrame& Frame, int32& Sequence, uint8& AckedCommandId, ESerialFrameAckStatus& Status)
+{
+	Sequence = -1;
+	AckedCommandId = 0;
+	Status = ESerialFrameAckStatus::Ok;
+	if (Frame.CommandId != (uint8)ESerialFrameCommand::Ack || Frame.Payload.Num() < 2) return false;
+
+	Sequence = Frame.Sequence;
+	AckedCommandId = Frame.Payload[0];
+	Status = (ESerialFrameAckStatus)Frame.Payload[1];
 	return true;
 }
 
 void USerial::Flush()
 {
-	if (!m_hIDComDev) return;
+	if (!IsOpened()) return;
+
+	m_ReadBuffer.Reset();
+	m_FrameCodec.Reset();
+	if (m_AsyncWorker)
+	{
+		m_AsyncWorker->DiscardReceived();
+		return;
+	}
 
 	TArray<uint8> Data;
 
@@ -374,6 +476,13 @@ void USerial::Flush()
 	} while (Data.Num() > 0);
 }
 
+int32 USerial::GetPendingWriteBytes()
+{
+	if (!IsOpened()) return 0;
+
+	return (m_AsyncWorker ? m_AsyncWorker->NumQueuedToSend() : 0) + GetDriverWriteQueueSize();
+}
+
 FString USerial::LineEndToStr(ELineEnd LineEnd)
 {
 	switch (LineEnd)
@@ -389,4 +498,88 @@ FString USerial::LineEndToStr(ELineEnd LineEnd)
 	default:
 		return TEXT("null");
 	}
-}
\ No newline at end of file
+}
+
+bool USerial::StartAsync(int32 QueueSizeBytes)
+{
+	if (!IsOpened())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Can't start async mode on a closed port."));
+		return false;
+	}
+	if (m_AsyncWorker) return true;
+
+	m_AsyncWorker = new FSerialIOWorker(*this, QueueSizeBytes);
+	m_AsyncTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &USerial::TickAsync));
+	return true;
+}
+
+void USerial::StopAsync()
+{
+	StopAsyncWorker(nullptr);
+}
+
+void USerial::StopAsyncKeepingUnsent(TArray<uint8>& OutUnsentBytes)
+{
+	StopAsyncWorker(&OutUnsentBytes);
+}
+
+void USerial::StopAsyncWorker(TArray<uint8>* OutUnsentBytes)
+{
+	if (!m_AsyncWorker) return;
+
+	FTicker::GetCoreTicker().RemoveTicker(m_AsyncTickerHandle);
+	m_AsyncTickerHandle.Reset();
+
+	//Join the I/O thread first, after this we own the port again. Keep whatever it received that still fits.
+	m_AsyncWorker->StopAndJoin();
+	FillReadBuffer();
+	if (OutUnsentBytes)
+	{
+		m_AsyncWorker->TakeUnsent(*OutUnsentBytes);
+	}
+	delete m_AsyncWorker;
+	m_AsyncWorker = nullptr;
+}
+
+int32 USerial::TryRead(TArray<uint8>& OutBytes, int32 Limit)
+{
+	OutBytes.Reset();
+	if (!m_AsyncWorker || Limit <= 0) return 0;
+
+	OutBytes.SetNumUninitialized(Limit);
+	OutBytes.SetNum(ReadBufferedBytes(OutBytes.GetData(), Limit), false);
+	return OutBytes.Num();
+}
+
+bool USerial::Enqueue(const TArray<uint8>& Bytes)
+{
+	if (!m_AsyncWorker || !m_AsyncWorker->Enqueue(Bytes.GetData(), Bytes.Num())) return false;
+
+	m_TotalBytesQueued += Bytes.Num();
+	return true;
+}
+
+bool USerial::EnqueueLine(FString String)
+{
+	auto Convert = FTCHARToUTF8(*(String + LineEndToStr(WriteLineEnd)));
+	if (!m_AsyncWorker || !m_AsyncWorker->Enqueue((const uint8*)Convert.Get(), Convert.Length())) return false;
+
+	m_TotalBytesQueued += Convert.Length();
+	return true;
+}
+
+bool USerial::TickAsync(float DeltaTime)
+{
+	if (!m_AsyncWorker || !OnLineReceived.IsBound()) return true;
+
+	while (TryReadLine(m_AsyncLineScratch, AsyncLineTerminator))
+	{
+		OnLineReceived.Broadcast(this, m_AsyncLineScratch);
+
+		//A listener may have closed the port.
+		if (!m_AsyncWorker) break;
+	}
+
+	return true;
+}
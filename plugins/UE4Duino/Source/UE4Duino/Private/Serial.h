@@ -10,12 +10,29 @@
 #define ASCII_XON       0x11
 #define ASCII_XOFF      0x13
 
+#if PLATFORM_WINDOWS
 #include "Windows/AllowWindowsPlatformTypes.h"
 #include "windows.h"
 #include "Windows/HideWindowsPlatformTypes.h"
+#endif
+#include "SerialReadBuffer.h"
+#include "SerialFrame.h"
+#include "SerialVirtualDevice.h"
 #include "CoreTypes.h"
+#include "Containers/Ticker.h"
+#include "Templates/Atomic.h"
+#include "HAL/ThreadSafeBool.h"
 #include "Serial.generated.h"
 
+class FSerialIOWorker;
+
+/** An opened and configured device that no USerial owns yet. */
+#if PLATFORM_WINDOWS
+typedef void* FSerialDeviceHandle;
+#else
+typedef int32 FSerialDeviceHandle;
+#endif
+
 UENUM(BlueprintType, Category = "UE4Duino")
 enum class ELineEnd : uint8
 {
@@ -25,6 +42,8 @@ enum class ELineEnd : uint8
 	nr	UMETA(DisplayName = "\n\r")
 };
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSerialLineReceived, USerial*, Serial, const FString&, Line);
+
 UCLASS(BlueprintType, Category = "UE4Duino", meta = (Keywords = "com arduino serial"))
 class UE4DUINO_API USerial : public UObject
 {
@@ -35,6 +54,17 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | String")
 	ELineEnd WriteLineEnd;
 
+	/**
+	* Fired on the game thread for every complete line received while in async mode.
+	* While this is bound, received data is consumed as lines and won't be returned by TryRead.
+	*/
+	UPROPERTY(BlueprintAssignable, Category = "UE4Duino | Async")
+	FSerialLineReceived OnLineReceived;
+
+	/** The char that ends a line for OnLineReceived. A \r right before a \n terminator is stripped. */
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | Async")
+	uint8 AsyncLineTerminator;
+
 	USerial();
 	~USerial();
 
@@ -97,6 +127,42 @@ public:
 	*/
 	UFUNCTION(BlueprintCallable, meta=(DisplayName = "Open Port"), Category = "UE4Duino", meta = (Keywords = "com start init"))
 	bool Open(int32 Port = 2, int32 BaudRate = 9600);
+	/**
+	* Open a serial device by its path, like /dev/ttyACM0 or COM3.
+	* Useful for devices whose name doesn't follow the numbered pattern Open tries, and for pseudo terminals.
+	*
+	* @param DevicePath The path of the device to open.
+	* @param BaudRate BaudRate to open the serial port with.
+	* @return If the device was successfully opened.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Open Device Path"), Category = "UE4Duino", meta = (Keywords = "com start init tty dev"))
+	bool OpenPath(FString DevicePath, int32 BaudRate = 9600);
+	/**
+	* List the serial devices present on this computer, Bluetooth serial ports included.
+	* @return Paths that can be passed to Open Device Path, like COM3 or /dev/ttyACM0.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "List Serial Devices"), Category = "UE4Duino", meta = (Keywords = "com enumerate find ports tty dev"))
+	static TArray<FString> EnumerateDevicePaths();
+
+	/**
+	* Open and configure a device without touching any USerial, so it can run on any thread.
+	* Opening a Bluetooth port can block for seconds while the link comes up.
+	* The handle has to be passed to AdoptOpenedDevice or CloseDeviceHandle.
+	*/
+	static bool OpenDeviceHandle(const FString& DevicePath, int32 nBaud, FSerialDeviceHandle& OutHandle);
+	static void CloseDeviceHandle(FSerialDeviceHandle Handle);
+	/** Take ownership of a handle from OpenDeviceHandle, as if OpenPath had opened it. Game thread only. */
+	bool AdoptOpenedDevice(const FString& DevicePath, int32 nBaud, FSerialDeviceHandle Handle);
+	/**
+	* Talk to a device that only exists in software instead of real hardware. Everything else works the same, async mode included.
+	*
+	* @param Device The device. It is released when the port is closed.
+	* @param DeviceName Returned by GetPortName, for logs.
+	* @param nBaud Reported by GetBaud. The device is responsible for simulating the rate.
+	* @return If the device was opened.
+	*/
+	bool OpenVirtual(TSharedRef<ISerialVirtualDevice, ESPMode::ThreadSafe> Device, const FString& DeviceName, int32 nBaud);
+
 	/**
 	* Close and end the communication with the serial port. If not open, do nothing.
 	*/
@@ -127,6 +193,21 @@ public:
 	//UFUNCTION(BlueprintCallable, meta = (DisplayName = "Read String Until", keywords = "get read receive string words text characters"), Category = "UE4Duino")
 	FString ReadStringUntil(bool &bSuccess, uint8 Terminator);
 	/**
+	* Reads a line without allocating. The view points into the internal read buffer and is only valid until the next read from this port.
+	* A \r right before a \n Terminator is left out of the line.
+	*
+	* @param OutLine The line, without the terminator.
+	* @param Terminator The char that ends a line.
+	* @param bAllowPartialLine If there is no terminator, return whatever is available instead of waiting for the rest of the line.
+	* @return True if a line was read.
+	*/
+	bool ReadLineView(TArrayView<const uint8>& OutLine, uint8 Terminator = '\n', bool bAllowPartialLine = false);
+	/**
+	* Reads a complete line into OutLine, reusing its allocation.
+	* If the terminator hasn't arrived yet, nothing is consumed and false is returned.
+	*/
+	bool TryReadLine(FString& OutLine, uint8 Terminator = '\n');
+	/**
 	* Reads a float from the serial port (sent as 4 bytes).
 	* @param bSuccess True if there were 4 bytes to read.
 	* @return The read value
@@ -199,6 +280,62 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Write Bytes", keywords = "send"), Category = "UE4Duino")
 	bool WriteBytes(TArray<uint8> Buffer);
 
+	/**
+	* Sends a binary frame with the next sequence number. See SerialFrame.h for the layout.
+	* @param CommandId The command id, usually one of ESerialFrameCommand.
+	* @param Payload Up to 32 bytes of command data.
+	* @param Sequence The sequence number the frame was sent with. The device acks with the same number.
+	* @return True if the frame was sent (or queued, in async mode).
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Write Frame", keywords = "send binary packet command"), Category = "UE4Duino | Frame")
+	bool WriteFrame(uint8 CommandId, const TArray<uint8>& Payload, int32& Sequence);
+	/**
+	* Sends a binary frame with a sequence number of the caller's choosing, like a retransmission of an earlier frame.
+	* New frames should take their number from AllocateFrameSequence, so they never share one with frames sent by WriteFrame.
+	* @return True if the frame was sent (or queued, in async mode).
+	*/
+	bool WriteFrameWithSequence(uint8 CommandId, const TArray<uint8>& Payload, uint8 Sequence);
+	/** Take the sequence number the next WriteFrame would have used. */
+	uint8 AllocateFrameSequence() { return m_NextFrameSequence++; }
+	/**
+	* Sends a Drive frame, setting both motors at once.
+	* @param LeftDuty Left motor duty from -255 (full reverse) to 255 (full forward).
+	* @param RightDuty Right motor duty from -255 (full reverse) to 255 (full forward).
+	* @param Sequence The sequence number the frame was sent with.
+	* @return True if the frame was sent (or queued, in async mode).
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Write Drive Frame", keywords = "send binary motor steer pwm"), Category = "UE4Duino | Frame")
+	bool WriteDriveFrame(int32 LeftDuty, int32 RightDuty, int32& Sequence);
+	/**
+	* Builds the payload of a Drive frame. Duties are clamped to -255 to 255 and sent as little endian int16.
+	* @param LeftDuty Left motor duty from -255 (full reverse) to 255 (full forward).
+	* @param RightDuty Right motor duty from -255 (full reverse) to 255 (full forward).
+	* @return The 4 byte payload.
+	*/
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Make Drive Payload"), Category = "UE4Duino | Frame")
+	static TArray<uint8> MakeDrivePayload(int32 LeftDuty, int32 RightDuty);
+	/**
+	* Reads the next complete binary frame. Bytes that aren't part of a valid frame are skipped.
+	* Don't mix this with the line reading functions or OnLineReceived on the same port, they consume the same data.
+	* @param OutFrame The received frame.
+	* @return True if a frame was read.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Read Frame", keywords = "get read receive binary packet"), Category = "UE4Duino | Frame")
+	bool ReadFrame(FSerialFrame& OutFrame);
+	/**
+	* Splits an Ack frame into its fields.
+	* @param Frame A received frame.
+	* @param Sequence The sequence number of the acknowledged frame.
+	* @param AckedCommandId The command id of the acknowledged frame.
+	* @param Status What the device made of the acknowledged frame.
+	* @return False if Frame is not an Ack frame.
+	*/
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Break Ack Frame"), Category = "UE4Duino | Frame")
+	static bool BreakAckFrame(const FSerialFrame& Frame, int32& Sequence, uint8& AckedCommandId, ESerialFrameAckStatus& Status);
+	/** Number of received frames dropped because of a CRC mismatch. */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Frame CRC Errors"), Category = "UE4Duino | Frame")
+	int32 GetFrameCrcErrorCount() const { return m_FrameCodec.GetCrcErrorCount(); }
+
 	/** Clean the serial port by reading everything left to be read. */
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Flush Port"), Category = "UE4Duino")
 	void Flush();
@@ -208,7 +345,20 @@ public:
 	* @return True if the serial port is open.
 	*/
 	UFUNCTION(BlueprintPure, meta = (DisplayName = "Is Port Open"), Category = "UE4Duino")
-	bool IsOpened() { return m_hIDComDev != NULL; }
+	bool IsOpened();
+
+	/**
+	* Check if a read or write failed in a way that means the device is gone, like an unplugged cable or a dropped Bluetooth link.
+	* The port stays open until closed, but nothing will get through anymore.
+	* @return True if the device has failed since it was opened.
+	*/
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Has Device Error"), Category = "UE4Duino")
+	bool HasDeviceError() const { return m_bDeviceError; }
+	/**
+	* Ask the driver whether the device is still there, without reading or writing anything.
+	* @return False if the port is closed or the device is gone.
+	*/
+	bool CheckDeviceHealth();
 
 	/**
 	* Read the number of the serial port selected for this Serial instance.
@@ -224,6 +374,35 @@ public:
 	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Baud Rate"), Category = "UE4Duino")
 	int32 GetBaud() { return m_Baud; }
 
+	/**
+	* Read the path of the device opened by this Serial instance.
+	* @return The device path, like COM3 or /dev/ttyACM0.
+	*/
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Port Name"), Category = "UE4Duino")
+	FString GetPortName() { return m_PortName; }
+
+	/**
+	* Number of times this Serial instance has opened a device. Changes when the port is reopened, for example after a reconnect.
+	* @return The number of successful opens.
+	*/
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Open Count"), Category = "UE4Duino")
+	int32 GetOpenCount() const { return m_OpenCount; }
+
+	/**
+	* Number of written bytes that haven't left the computer yet, in the async queue and the driver buffer.
+	* @return The number of bytes still waiting to be sent.
+	*/
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Pending Write Bytes"), Category = "UE4Duino")
+	int32 GetPendingWriteBytes();
+
+	/** Total number of bytes accepted by the Write functions since the port was created. Game thread only. */
+	uint64 GetTotalBytesQueued() const { return m_TotalBytesQueued; }
+	/**
+	* Total number of bytes the driver has accepted since the port was created. Safe to call while the async thread is writing.
+	* @param OutLastWriteTime FPlatformTime::Seconds of the most recent completed write.
+	*/
+	uint64 GetTotalBytesWritten(double& OutLastWriteTime) const;
+
 	/**
 	* Converts a LineEnd enum value to String.
 	* @param LineEnd LineEnd enum value.
@@ -231,12 +410,109 @@ public:
 	*/
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Line End to String", keywords = "cast convert"), Category = "UE4Duino")
 	FString LineEndToStr(ELineEnd LineEnd);
+
+	/**
+	* Start async mode. A dedicated thread per port then does all reading and writing,
+	* and the game thread only talks to bounded queues so it never waits on the device.
+	* While in async mode, the regular Read and Write functions also go through the queues and never block.
+	*
+	* @param QueueSizeBytes Size of each of the receive and transmit queues.
+	* @return True if async mode is running.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Start Async"), Category = "UE4Duino | Async", meta = (Keywords = "thread background nonblocking"))
+	bool StartAsync(int32 QueueSizeBytes = 4096);
+	/** Stop async mode and go back to reading and writing on the caller's thread. Received data that hasn't been read yet is kept, as far as the read buffer allows. */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Stop Async"), Category = "UE4Duino | Async")
+	void StopAsync();
+	/** Stop async mode like StopAsync, and move the queued bytes that haven't been written to the port yet into OutUnsentBytes instead of dropping them. */
+	void StopAsyncKeepingUnsent(TArray<uint8>& OutUnsentBytes);
+	/**
+	* Check if the serial port is in async mode.
+	* @return True if a background thread is doing the I/O.
+	*/
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Is Async"), Category = "UE4Duino | Async")
+	bool IsAsync() const { return m_AsyncWorker != nullptr; }
+	/**
+	* Non-blocking read of up to Limit bytes already received by the async thread.
+	* @param OutBytes The read bytes.
+	* @return The number of bytes read.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Try Read", keywords = "get read receive nonblocking"), Category = "UE4Duino | Async")
+	int32 TryRead(TArray<uint8>& OutBytes, int32 Limit = 256);
+	/**
+	* Queue bytes to be sent by the async thread. Never blocks.
+	* @param Bytes The bytes to send.
+	* @return False if not in async mode or if the transmit queue can't fit all of the bytes. Nothing is queued in that case.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Enqueue Bytes", keywords = "send write nonblocking"), Category = "UE4Duino | Async")
+	bool Enqueue(const TArray<uint8>& Bytes);
+	/**
+	* Queue a string with WriteLineEnd appended to be sent by the async thread. Never blocks.
+	* @param String The string to send.
+	* @return False if not in async mode or if the transmit queue is full.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Enqueue Line", keywords = "send write string nonblocking"), Category = "UE4Duino | Async")
+	bool EnqueueLine(FString String);
 	
 protected:
+	friend class FSerialIOWorker;
+
+#if PLATFORM_WINDOWS
 	void* m_hIDComDev;
 	OVERLAPPED m_OverlappedRead, m_OverlappedWrite;
+#else
+	int32 m_FileDescriptor;
+#endif
 
 	int32 m_Port;
 	int32 m_Baud;
+	FString m_PortName;
+	int32 m_OpenCount;
+	/** Set by whichever thread does the I/O when the device fails. */
+	FThreadSafeBool m_bDeviceError;
+
+	/** Set instead of a platform handle while a virtual device is open. */
+	TSharedPtr<ISerialVirtualDevice, ESPMode::ThreadSafe> m_VirtualDevice;
+
+	FSerialIOWorker* m_AsyncWorker;
+	FDelegateHandle m_AsyncTickerHandle;
+	FString m_AsyncLineScratch;
+
+	uint64 m_TotalBytesQueued;
+	TAtomic<uint64> m_TotalBytesWritten;
+	TAtomic<uint64> m_LastWriteCycles;
+
+	uint8 m_NextFrameSequence;
+	FSerialFrameCodec m_FrameCodec;
+	TArray<uint8> m_FrameScratch;
+
+	/** Received bytes that have been pulled from the port or the async queue but not yet handed out. */
+	FSerialReadBuffer m_ReadBuffer;
+
+	/** The device paths Open tries for a port number, in order of preference. */
+	static TArray<FString> GetDevicePathsForPort(int32 nPort);
+	bool OpenDevice(const FString& DevicePath, int32 nBaud);
+	/** Set up whatever else the platform needs to do I/O on an opened device. Closes the handle on failure. */
+	bool AdoptDeviceHandle(FSerialDeviceHandle Handle);
+	void CloseDevice();
+	void OnDeviceOpened(const FString& DevicePath, int32 nPort, int32 nBaud);
+	/** Number of bytes in the driver's transmit buffer. */
+	int32 GetDriverWriteQueueSize();
+	/** Block until data arrives or TimeoutMs passes. Returns true only if data is waiting, false on a timeout or if the backend can't wait on the device. */
+	bool WaitUntilReadable(int32 TimeoutMs);
+
+	/** Read whatever the driver has buffered, up to BufferSize bytes. Returns the number of bytes read. */
+	int32 ReadAvailableBytes(uint8* Buffer, int32 BufferSize);
+	/** Write bytes straight to the port. Returns the number of bytes written or -1 on error. */
+	int32 WriteRawBytes(const uint8* Data, int32 NumBytes);
+
+	/** Called by whichever thread does the writing, right after the driver accepted NumBytes. */
+	void NoteBytesWritten(int32 NumBytes);
+	/** Pull everything currently available into m_ReadBuffer with a single read. Returns the number of bytes added. */
+	int32 FillReadBuffer();
+	/** Read up to MaxBytes, first from m_ReadBuffer and then directly from the port or async queue. */
+	int32 ReadBufferedBytes(uint8* Dest, int32 MaxBytes);
+	bool TickAsync(float DeltaTime);
+	void StopAsyncWorker(TArray<uint8>* OutUnsentBytes);
 
 };
\ No newline at end of file
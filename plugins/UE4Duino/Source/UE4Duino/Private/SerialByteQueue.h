@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+
+/**
+* Bounded single producer / single consumer byte queue.
+* One thread may call Write while another calls Read without any locking.
+* The capacity is rounded up to the next power of two.
+*/
+class FSerialByteQueue
+{
+public:
+	explicit FSerialByteQueue(int32 InCapacity)
+		: Head(0)
+		, Tail(0)
+	{
+		const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 16));
+		Buffer.SetNumUninitialized(Capacity);
+		Mask = Capacity - 1;
+	}
+
+	/** Number of bytes that can currently be read. */
+	int32 Num() const
+	{
+		return (int32)(Head.Load() - Tail.Load());
+	}
+
+	/** Number of bytes that can currently be written. */
+	int32 Slack() const
+	{
+		return Buffer.Num() - Num();
+	}
+
+	int32 Capacity() const
+	{
+		return Buffer.Num();
+	}
+
+	/**
+	* Producer side. Writes as many bytes as there is room for.
+	* @return The number of bytes written.
+	*/
+	int32 Write(const uint8* Data, int32 NumBytes)
+	{
+		const uint32 CurrentHead = Head.Load();
+		const uint32 Free = Buffer.Num() - (CurrentHead - Tail.Load());
+		const uint32 ToWrite = FMath::Min((uint32)FMath::Max(NumBytes, 0), Free);
+		if (ToWrite == 0) return 0;
+
+		const uint32 Start = CurrentHead & Mask;
+		const uint32 FirstChunk = FMath::Min(ToWrite, (uint32)Buffer.Num() - Start);
+		FMemory::Memcpy(Buffer.GetData() + Start, Data, FirstChunk);
+		FMemory::Memcpy(Buffer.GetData(), Data + FirstChunk, ToWrite - FirstChunk);
+
+		Head.Store(CurrentHead + ToWrite);
+		return (int32)ToWrite;
+	}
+
+	/**
+	* Consumer side. Reads up to MaxBytes bytes.
+	* @return The number of bytes read.
+	*/
+	int32 Read(uint8* Data, int32 MaxBytes)
+	{
+		const int32 NumRead = Peek(Data, MaxBytes);
+		Pop(NumRead);
+		return NumRead;
+	}
+
+	/** Consumer side. Consumes bytes previously returned by Peek. */
+	void Pop(int32 NumBytes)
+	{
+		const uint32 CurrentTail = Tail.Load();
+		const uint32 Available = Head.Load() - CurrentTail;
+		Tail.Store(CurrentTail + FMath::Min((uint32)FMath::Max(NumBytes, 0), Available));
+	}
+
+	/** Consumer side. Copies up to MaxBytes bytes without consuming them. */
+	int32 Peek(uint8* Data, int32 MaxBytes) const
+	{
+		const uint32 CurrentTail = Tail.Load();
+		const uint32 Available = Head.Load() - CurrentTail;
+		const uint32 ToRead = FMath::Min((uint32)FMath::Max(MaxBytes, 0), Available);
+		if (ToRead == 0) return 0;
+
+		const uint32 Start = CurrentTail & Mask;
+		const uint32 FirstChunk = FMath::Min(ToRead, (uint32)Buffer.Num() - Start);
+		FMemory::Memcpy(Data, Buffer.GetData() + Start, FirstChunk);
+		FMemory::Memcpy(Data + FirstChunk, Buffer.GetData(), ToRead - FirstChunk);
+		return (int32)ToRead;
+	}
+
+	/** Consumer side. Drops everything that has been written so far. */
+	void Discard()
+	{
+		Tail.Store(Head.Load());
+	}
+
+private:
+	TArray<uint8> Buffer;
+	uint32 Mask;
+
+	//Only the producer writes Head and only the consumer writes Tail.
+	TAtomic<uint32> Head;
+	TAtomic<uint32> Tail;
+};
@@ -0,0 +1,144 @@
+#include "SerialFrame.h"
+
+#include <string.h>
+
+FSerialFrameCodec::FSerialFrameCodec()
+	: bInFrame(false)
+	, NumReceived(0)
+	, NumPending(0)
+	, CrcErrorCount(0)
+{
+}
+
+uint16 FSerialFrameCodec::Crc16(const uint8* Data, int32 NumBytes, uint16 Crc)
+{
+	//Bitwise on purpose, so it matches the sketch, which can't spare the RAM for a table.
+	for (int32 i = 0; i < NumBytes; i++)
+	{
+		Crc ^= (uint16)Data[i] << 8;
+		for (int32 Bit = 0; Bit < 8; Bit++)
+		{
+			Crc = (Crc & 0x8000) ? (uint16)((Crc << 1) ^ 0x1021) : (uint16)(Crc << 1);
+		}
+	}
+	return Crc;
+}
+
+bool FSerialFrameCodec::Encode(uint8 CommandId, uint8 Sequence, const uint8* Payload, int32 PayloadSize, TArray<uint8>& OutBytes)
+{
+	if (PayloadSize < 0 || PayloadSize > SERIAL_FRAME_MAX_PAYLOAD) return false;
+
+	const int32 Start = OutBytes.AddUninitialized(SERIAL_FRAME_HEADER_SIZE + PayloadSize + SERIAL_FRAME_CRC_SIZE);
+	uint8* Frame = OutBytes.GetData() + Start;
+
+	Frame[0] = SERIAL_FRAME_SYNC;
+	Frame[1] = CommandId;
+	Frame[2] = Sequence;
+	Frame[3] = (uint8)PayloadSize;
+	if (PayloadSize > 0)
+	{
+		FMemory::Memcpy(Frame + SERIAL_FRAME_HEADER_SIZE, Payload, PayloadSize);
+	}
+
+	const uint16 Crc = Crc16(Frame + 1, SERIAL_FRAME_HEADER_SIZE - 1 + PayloadSize);
+	Frame[SERIAL_FRAME_HEADER_SIZE + PayloadSize] = (uint8)(Crc & 0xFF);
+	Frame[SERIAL_FRAME_HEADER_SIZE + PayloadSize + 1] = (uint8)(Crc >> 8);
+	return true;
+}
+
+int32 FSerialFrameCodec::Decode(const uint8* Data, int32 NumBytes, FSerialFrame& OutFrame, bool& bOutFrameReady)
+{
+	bOutFrameReady = false;
+
+	int32 NumConsumed = 0;
+	while (!bOutFrameReady)
+	{
+		//Leftovers of a broken frame go first, they were received before anything in Data.
+		if (NumPending > 0)
+		{
+			const uint8 Byte = Pending[0];
+			NumPending--;
+			FMemory::Memmove(Pending, Pending + 1, NumPending);
+			bOutFrameReady = Feed(Byte, OutFrame);
+		}
+		else if (NumConsumed < NumBytes)
+		{
+			bOutFrameReady = Feed(Data[NumConsumed++], OutFrame);
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	return NumConsumed;
+}
+
+bool FSerialFrameCodec::Feed(uint8 Byte, FSerialFrame& OutFrame)
+{
+	if (!bInFrame)
+	{
+		if (Byte == SERIAL_FRAME_SYNC)
+		{
+			bInFrame = true;
+			NumReceived = 0;
+		}
+		return false;
+	}
+
+	Body[NumReceived++] = Byte;
+	if (NumReceived < SERIAL_FRAME_HEADER_SIZE - 1) return false;
+
+	//A length we can't hold means we locked onto a sync byte inside some other data.
+	const int32 PayloadSize = Body[2];
+	if (PayloadSize > SERIAL_FRAME_MAX_PAYLOAD)
+	{
+		Resync();
+		return false;
+	}
+
+	const int32 CrcOffset = SERIAL_FRAME_HEADER_SIZE - 1 + PayloadSize;
+	if (NumReceived < CrcOffset + SERIAL_FRAME_CRC_SIZE) return false;
+
+	const uint16 ReceivedCrc = (uint16)Body[CrcOffset] | ((uint16)Body[CrcOffset + 1] << 8);
+	if (ReceivedCrc != Crc16(Body, CrcOffset))
+	{
+		CrcErrorCount++;
+		Resync();
+		return false;
+	}
+
+	OutFrame.CommandId = Body[0];
+	OutFrame.Sequence = Body[1];
+	OutFrame.Payload.Reset();
+	OutFrame.Payload.Append(Body + SERIAL_FRAME_HEADER_SIZE - 1, PayloadSize);
+
+	bInFrame = false;
+	NumReceived = 0;
+	return true;
+}
+
+void FSerialFrameCodec::Resync()
+{
+	bInFrame = false;
+
+	//Everything after the next sync byte in the broken frame has to be looked at again.
+	const uint8* NextSync = (const uint8*)memchr(Body, SERIAL_FRAME_SYNC, NumReceived);
+	if (NextSync != nullptr)
+	{
+		//Only bytes taken from Pending can be in Body while Pending isn't empty, so this always fits.
+		const int32 NumReplay = FMath::Min((int32)(Body + NumReceived - NextSync), MaxFrameBody - NumPending);
+		FMemory::Memmove(Pending + NumReplay, Pending, NumPending);
+		FMemory::Memcpy(Pending, NextSync, NumReplay);
+		NumPending += NumReplay;
+	}
+
+	NumReceived = 0;
+}
+
+void FSerialFrameCodec::Reset()
+{
+	bInFrame = false;
+	NumReceived = 0;
+	NumPending = 0;
+}
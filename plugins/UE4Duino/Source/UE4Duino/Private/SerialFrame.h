@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SerialFrame.generated.h"
+
+/**
+* Binary frame layout, shared with the Arduino sketch:
+*
+*   [0xA5 sync][command id][sequence][payload length][payload ...][crc16 lo][crc16 hi]
+*
+* The CRC is CRC-16/CCITT-FALSE over everything between the sync byte and the CRC.
+* Multi-byte payload values are little endian, the same as IntToBytes and FloatToBytes.
+*/
+#define SERIAL_FRAME_SYNC 0xA5
+#define SERIAL_FRAME_HEADER_SIZE 4
+#define SERIAL_FRAME_CRC_SIZE 2
+#define SERIAL_FRAME_MAX_PAYLOAD 32
+
+/** Command ids understood by ArduinoMovement.ino. */
+UENUM(BlueprintType, Category = "UE4Duino")
+enum class ESerialFrameCommand : uint8
+{
+	None	= 0x00	UMETA(Hidden),
+	/** Payload: left and right motor duty as int16, -255 (full reverse) to 255 (full forward). */
+	Drive	= 0x01,
+	/** Payload: one byte, 0 turns the light off, anything else on. */
+	Light	= 0x02,
+	/** No payload. Stops both motors and turns the light off. */
+	Stop	= 0x03,
+	/** Sent by the device. The sequence is the one of the acknowledged frame. Payload: acknowledged command id and status. */
+	Ack		= 0x80
+};
+
+/** Status byte of an Ack frame. */
+UENUM(BlueprintType, Category = "UE4Duino")
+enum class ESerialFrameAckStatus : uint8
+{
+	Ok				= 0x00,
+	UnknownCommand	= 0x01,
+	BadPayload		= 0x02
+};
+
+USTRUCT(BlueprintType)
+struct UE4DUINO_API FSerialFrame
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino")
+	uint8 CommandId;
+
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino")
+	uint8 Sequence;
+
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino")
+	TArray<uint8> Payload;
+
+	FSerialFrame()
+		: CommandId(0)
+		, Sequence(0)
+	{}
+};
+
+/**
+* Encoding and incremental decoding of binary frames.
+* The decoder keeps its state between calls, so a frame may arrive split over any number of reads.
+* When a frame turns out to be broken, decoding resumes at the next sync byte inside it, so a real frame right after some garbage isn't lost.
+*/
+class FSerialFrameCodec
+{
+public:
+	FSerialFrameCodec();
+
+	static uint16 Crc16(const uint8* Data, int32 NumBytes, uint16 Crc = 0xFFFF);
+
+	/**
+	* Appends an encoded frame to OutBytes.
+	* @return False if the payload is larger than SERIAL_FRAME_MAX_PAYLOAD. Nothing is appended in that case.
+	*/
+	static bool Encode(uint8 CommandId, uint8 Sequence, const uint8* Payload, int32 PayloadSize, TArray<uint8>& OutBytes);
+
+	/**
+	* Feeds received bytes to the decoder, stopping as soon as a frame is complete.
+	* May be called with no bytes to finish decoding what is left over from a broken frame.
+	* @param bOutFrameReady Set to true if OutFrame holds a newly decoded frame.
+	* @return The number of bytes consumed.
+	*/
+	int32 Decode(const uint8* Data, int32 NumBytes, FSerialFrame& OutFrame, bool& bOutFrameReady);
+
+	/** True if bytes from a broken frame still need to be decoded. */
+	bool HasPendingBytes() const { return NumPending > 0; }
+
+	/** Forget any partially received frame. */
+	void Reset();
+
+	/** Number of frames dropped because of a CRC mismatch. */
+	int32 GetCrcErrorCount() const { return CrcErrorCount; }
+
+private:
+	enum { MaxFrameBody = SERIAL_FRAME_HEADER_SIZE - 1 + SERIAL_FRAME_MAX_PAYLOAD + SERIAL_FRAME_CRC_SIZE };
+
+	bool Feed(uint8 Byte, FSerialFrame& OutFrame);
+	void Resync();
+
+	bool bInFrame;
+	//Everything after the sync byte of the frame being received.
+	uint8 Body[MaxFrameBody];
+	int32 NumReceived;
+	//Bytes to decode again after a broken frame, before any new input.
+	uint8 Pending[MaxFrameBody];
+	int32 NumPending;
+	int32 CrcErrorCount;
+};
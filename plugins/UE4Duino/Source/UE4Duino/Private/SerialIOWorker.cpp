@@ -0,0 +1,126 @@
+#include "SerialIOWorker.h"
+#include "Serial.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+
+#define SERIAL_IO_CHUNK_SIZE 4096
+
+FSerialIOWorker::FSerialIOWorker(USerial& InSerial, int32 QueueCapacity)
+	: Serial(InSerial)
+	, RxQueue(QueueCapacity)
+	, TxQueue(QueueCapacity)
+	, Thread(nullptr)
+	, WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, bStopRequested(false)
+	, RxStallCount(0)
+{
+	Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("UE4DuinoSerialIO_%d"), InSerial.GetPort()), 0, TPri_AboveNormal);
+}
+
+FSerialIOWorker::~FSerialIOWorker()
+{
+	StopAndJoin();
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+void FSerialIOWorker::StopAndJoin()
+{
+	if (Thread != nullptr)
+	{
+		//Kill calls Stop and waits for Run to return.
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+}
+
+bool FSerialIOWorker::Enqueue(const uint8* Data, int32 NumBytes)
+{
+	if (NumBytes <= 0) return true;
+
+	//We are the only producer, so the slack can only grow between this check and the write.
+	if (TxQueue.Slack() < NumBytes) return false;
+
+	TxQueue.Write(Data, NumBytes);
+	WakeEvent->Trigger();
+	return true;
+}
+
+void FSerialIOWorker::TakeUnsent(TArray<uint8>& OutBytes)
+{
+	check(Thread == nullptr);
+
+	//With the thread gone the game thread is the consumer of TxQueue too.
+	const int32 NumUnsent = TxQueue.Num();
+	const int32 Offset = OutBytes.AddUninitialized(NumUnsent);
+	TxQueue.Read(OutBytes.GetData() + Offset, NumUnsent);
+}
+
+uint32 FSerialIOWorker::Run()
+{
+	uint8 Chunk[SERIAL_IO_CHUNK_SIZE];
+
+	while (!bStopRequested)
+	{
+		//The device is gone. Don't hammer it, whoever owns the port will close it.
+		if (Serial.HasDeviceError())
+		{
+			WakeEvent->Wait(10);
+			continue;
+		}
+
+		bool bDidWork = false;
+
+		//Transmit. Only consume what the port actually accepted so nothing is lost on a partial write.
+		const int32 NumToSend = TxQueue.Peek(Chunk, SERIAL_IO_CHUNK_SIZE);
+		if (NumToSend > 0)
+		{
+			const int32 NumSent = Serial.WriteRawBytes(Chunk, NumToSend);
+			if (NumSent > 0)
+			{
+				Serial.NoteBytesWritten(NumSent);
+				TxQueue.Pop(NumSent);
+				bDidWork = true;
+			}
+		}
+
+		//Receive. If the queue is full, leave the data in the driver buffer until the game thread catches up.
+		const int32 RxRoom = FMath::Min(RxQueue.Slack(), SERIAL_IO_CHUNK_SIZE);
+		if (RxRoom > 0)
+		{
+			const int32 NumReceived = Serial.ReadAvailableBytes(Chunk, RxRoom);
+			if (NumReceived > 0)
+			{
+				RxQueue.Write(Chunk, NumReceived);
+				bDidWork = true;
+			}
+		}
+		else
+		{
+			RxStallCount++;
+		}
+
+		if (!bDidWork)
+		{
+			//Backends that can block on the device until data arrives do so instead of sleeping blind, received data is then picked up within a millisecond.
+			//Enqueue only interrupts the event wait, so while waiting on the device new writes can sit for up to a millisecond.
+			//With the receive queue full the driver still holds unread data and would always be readable, so wait for the game thread instead.
+			if (RxRoom <= 0 || !Serial.WaitUntilReadable(1))
+			{
+				WakeEvent->Wait(1);
+			}
+		}
+	}
+
+	return 0;
+}
+
+void FSerialIOWorker::Stop()
+{
+	bStopRequested = true;
+	WakeEvent->Trigger();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "SerialByteQueue.h"
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+
+class USerial;
+class FRunnableThread;
+class FEvent;
+
+/**
+* Owns the I/O thread of a USerial in async mode.
+* The thread is the only one touching the port. It moves received bytes into RxQueue and drains TxQueue to the port.
+* The game thread only ever talks to the queues, so it never waits on the device.
+*/
+class FSerialIOWorker : public FRunnable
+{
+public:
+	FSerialIOWorker(USerial& InSerial, int32 QueueCapacity);
+	virtual ~FSerialIOWorker();
+
+	/** Stop the thread and wait for it to exit. The queues stay readable afterwards. */
+	void StopAndJoin();
+
+	/** Game thread side. Non-blocking read from the receive queue. */
+	int32 Read(uint8* Data, int32 MaxBytes) { return RxQueue.Read(Data, MaxBytes); }
+
+	/** Game thread side. Queues all bytes for sending, or nothing if they don't fit. */
+	bool Enqueue(const uint8* Data, int32 NumBytes);
+
+	/** Game thread side. Number of received bytes waiting to be read. */
+	int32 NumReceived() const { return RxQueue.Num(); }
+
+	/** Game thread side. Number of queued bytes the thread hasn't handed to the port yet. */
+	int32 NumQueuedToSend() const { return TxQueue.Num(); }
+
+	/** Only once the thread has stopped. Moves the queued bytes that never reached the port into OutBytes. */
+	void TakeUnsent(TArray<uint8>& OutBytes);
+
+	/** Game thread side. Drop everything received so far. */
+	void DiscardReceived() { RxQueue.Discard(); }
+
+	/** Number of times the receive queue was full and the thread had to leave data in the driver buffer. */
+	int32 GetRxStallCount() const { return RxStallCount; }
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	USerial& Serial;
+	FSerialByteQueue RxQueue;
+	FSerialByteQueue TxQueue;
+
+	FRunnableThread* Thread;
+	FEvent* WakeEvent;
+	FThreadSafeBool bStopRequested;
+	volatile int32 RxStallCount;
+};
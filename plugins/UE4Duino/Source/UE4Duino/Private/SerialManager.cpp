@@ -0,0 +1,283 @@
+#include "SerialManager.h"
+
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+
+USerialManager::USerialManager()
+	: InitialReconnectDelay(0.5f)
+	, MaxReconnectDelay(10.0f)
+{
+}
+
+void USerialManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &USerialManager::Tick));
+}
+
+void USerialManager::Deinitialize()
+{
+	FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+
+	for (FSerialManagedDevice& Device : ManagedDevices)
+	{
+		AbandonOpen(Device);
+		if (USerial* Serial = Devices.FindRef(Device.Id))
+		{
+			Serial->Close();
+		}
+	}
+	ManagedDevices.Reset();
+	Devices.Reset();
+
+	Super::Deinitialize();
+}
+
+USerial* USerialManager::AddDevice(FName DeviceId, FString DevicePath, int32 BaudRate, bool bAsync, int32 AsyncQueueSize)
+{
+	RemoveDevice(DeviceId);
+
+	USerial* Serial = NewObject<USerial>(this);
+	Devices.Add(DeviceId, Serial);
+
+	FSerialManagedDevice& Device = ManagedDevices.AddDefaulted_GetRef();
+	Device.Id = DeviceId;
+	Device.DevicePath = DevicePath;
+	Device.BaudRate = BaudRate;
+	Device.bAsync = bAsync;
+	Device.AsyncQueueSize = AsyncQueueSize;
+	Device.State = ESerialDeviceState::Disconnected;
+	Device.NextCandidate = 0;
+	Device.NextAttemptTime = 0.0;
+	Device.ReconnectDelay = InitialReconnectDelay;
+	Device.bHasConnected = false;
+	Device.NumReconnects = 0;
+
+	BeginOpen(Device, FPlatformTime::Seconds());
+	return Serial;
+}
+
+void USerialManager::RemoveDevice(FName DeviceId)
+{
+	for (int32 DeviceIdx = 0; DeviceIdx < ManagedDevices.Num(); DeviceIdx++)
+	{
+		if (ManagedDevices[DeviceIdx].Id == DeviceId)
+		{
+			AbandonOpen(ManagedDevices[DeviceIdx]);
+			ManagedDevices.RemoveAt(DeviceIdx);
+			break;
+		}
+	}
+
+	USerial* Serial = nullptr;
+	if (Devices.RemoveAndCopyValue(DeviceId, Serial) && Serial != nullptr)
+	{
+		Serial->Close();
+	}
+}
+
+USerial* USerialManager::GetDevice(FName DeviceId) const
+{
+	return Devices.FindRef(DeviceId);
+}
+
+ESerialDeviceState USerialManager::GetDeviceState(FName DeviceId) const
+{
+	const FSerialManagedDevice* Device = FindManagedDevice(DeviceId);
+	return Device != nullptr ? Device->State : ESerialDeviceState::Unknown;
+}
+
+int32 USerialManager::GetNumReconnects(FName DeviceId) const
+{
+	const FSerialManagedDevice* Device = FindManagedDevice(DeviceId);
+	return Device != nullptr ? Device->NumReconnects : 0;
+}
+
+TArray<FName> USerialManager::GetDeviceIds() const
+{
+	TArray<FName> DeviceIds;
+	for (const FSerialManagedDevice& Device : ManagedDevices)
+	{
+		DeviceIds.Add(Device.Id);
+	}
+	return DeviceIds;
+}
+
+FSerialManagedDevice* USerialManager::FindManagedDevice(FName DeviceId)
+{
+	return ManagedDevices.FindByPredicate([DeviceId](const FSerialManagedDevice& Device) { return Device.Id == DeviceId; });
+}
+
+const FSerialManagedDevice* USerialManager::FindManagedDevice(FName DeviceId) const
+{
+	return ManagedDevices.FindByPredicate([DeviceId](const FSerialManagedDevice& Device) { return Device.Id == DeviceId; });
+}
+
+bool USerialManager::ChooseDevicePath(FSerialManagedDevice& Device, FString& OutPath)
+{
+	if (!Device.DevicePath.IsEmpty())
+	{
+		OutPath = Device.DevicePath;
+		return true;
+	}
+
+	//Skip whatever the other devices are using or trying to open. Rotate through the rest, so one device that
+	//opens but isn't ours doesn't block the others forever.
+	TArray<FString> Candidates = USerial::EnumerateDevicePaths();
+	for (const FSerialManagedDevice& Other : ManagedDevices)
+	{
+		if (&Other != &Device && Other.State != ESerialDeviceState::Disconnected)
+		{
+			Candidates.Remove(Other.CurrentPath);
+		}
+	}
+	if (Candidates.Num() == 0) return false;
+
+	OutPath = Candidates[Device.NextCandidate % Candidates.Num()];
+	Device.NextCandidate++;
+	return true;
+}
+
+void USerialManager::BeginOpen(FSerialManagedDevice& Device, double Now)
+{
+	FString DevicePath;
+	if (!ChooseDevicePath(Device, DevicePath))
+	{
+		ScheduleRetry(Device, Now);
+		return;
+	}
+
+	TSharedPtr<FSerialPendingOpen, ESPMode::ThreadSafe> PendingOpen = MakeShared<FSerialPendingOpen, ESPMode::ThreadSafe>();
+	const int32 BaudRate = Device.BaudRate;
+	Async(EAsyncExecution::ThreadPool, [PendingOpen, DevicePath, BaudRate]()
+	{
+		PendingOpen->bSuccess = USerial::OpenDeviceHandle(DevicePath, BaudRate, PendingOpen->Handle);
+		if (PendingOpen->State.Exchange(FSerialPendingOpen::Done) == FSerialPendingOpen::Abandoned && PendingOpen->bSuccess)
+		{
+			USerial::CloseDeviceHandle(PendingOpen->Handle);
+		}
+	});
+
+	Device.CurrentPath = DevicePath;
+	Device.PendingOpen = PendingOpen;
+	Device.State = ESerialDeviceState::Connecting;
+}
+
+bool USerialManager::FinishOpen(FSerialManagedDevice& Device, double Now)
+{
+	TSharedPtr<FSerialPendingOpen, ESPMode::ThreadSafe> PendingOpen = MoveTemp(Device.PendingOpen);
+	USerial* Serial = Devices.FindRef(Device.Id);
+
+	if (!PendingOpen->bSuccess || Serial == nullptr || !Serial->AdoptOpenedDevice(Device.CurrentPath, Device.BaudRate, PendingOpen->Handle))
+	{
+		ScheduleRetry(Device, Now);
+		return false;
+	}
+
+	if (Device.bAsync)
+	{
+		Serial->StartAsync(Device.AsyncQueueSize);
+		if (Device.UnsentBytes.Num() > 0)
+		{
+			Serial->Enqueue(Device.UnsentBytes);
+		}
+	}
+	Device.UnsentBytes.Reset();
+
+	if (Device.bHasConnected)
+	{
+		Device.NumReconnects++;
+		UE_LOG(LogTemp, Log, TEXT("Serial device %s reconnected on %s"), *Device.Id.ToString(), *Device.CurrentPath);
+	}
+	Device.bHasConnected = true;
+	Device.ReconnectDelay = InitialReconnectDelay;
+	Device.State = ESerialDeviceState::Connected;
+	return true;
+}
+
+void USerialManager::OnDeviceLost(FSerialManagedDevice& Device, double Now)
+{
+	UE_LOG(LogTemp, Warning, TEXT("Serial device %s on %s was lost, reconnecting."), *Device.Id.ToString(), *Device.CurrentPath);
+
+	if (USerial* Serial = Devices.FindRef(Device.Id))
+	{
+		//Keep what the game asked to send but never got out, it goes first once the device is back.
+		Serial->StopAsyncKeepingUnsent(Device.UnsentBytes);
+		Serial->Close();
+	}
+
+	//The device just vanished, give it a moment before knocking.
+	Device.ReconnectDelay = InitialReconnectDelay;
+	ScheduleRetry(Device, Now);
+}
+
+void USerialManager::ScheduleRetry(FSerialManagedDevice& Device, double Now)
+{
+	Device.State = ESerialDeviceState::Disconnected;
+	Device.NextAttemptTime = Now + Device.ReconnectDelay;
+	Device.ReconnectDelay = FMath::Min(Device.ReconnectDelay * 2.0f, FMath::Max(MaxReconnectDelay, InitialReconnectDelay));
+}
+
+void USerialManager::AbandonOpen(FSerialManagedDevice& Device)
+{
+	if (!Device.PendingOpen.IsValid()) return;
+
+	//If the open already finished, its handle is ours to close. Otherwise the task closes it when it's done.
+	if (Device.PendingOpen->State.Exchange(FSerialPendingOpen::Abandoned) == FSerialPendingOpen::Done && Device.PendingOpen->bSuccess)
+	{
+		USerial::CloseDeviceHandle(Device.PendingOpen->Handle);
+	}
+	Device.PendingOpen.Reset();
+}
+
+bool USerialManager::Tick(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	//Listeners may add or remove devices, so only fire events once the loop is done.
+	TArray<FName> Connected;
+	TArray<FName> Disconnected;
+
+	for (FSerialManagedDevice& Device : ManagedDevices)
+	{
+		switch (Device.State)
+		{
+		case ESerialDeviceState::Connected:
+		{
+			USerial* Serial = Devices.FindRef(Device.Id);
+			if (Serial == nullptr || !Serial->IsOpened() || !Serial->CheckDeviceHealth())
+			{
+				OnDeviceLost(Device, Now);
+				Disconnected.Add(Device.Id);
+			}
+			break;
+		}
+		case ESerialDeviceState::Connecting:
+			if (Device.PendingOpen->State.Load() == FSerialPendingOpen::Done && FinishOpen(Device, Now))
+			{
+				Connected.Add(Device.Id);
+			}
+			break;
+		case ESerialDeviceState::Disconnected:
+			if (Now >= Device.NextAttemptTime)
+			{
+				BeginOpen(Device, Now);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	for (const FName& DeviceId : Disconnected)
+	{
+		OnDeviceDisconnected.Broadcast(DeviceId, Devices.FindRef(DeviceId));
+	}
+	for (const FName& DeviceId : Connected)
+	{
+		OnDeviceConnected.Broadcast(DeviceId, Devices.FindRef(DeviceId));
+	}
+
+	return true;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Templates/Atomic.h"
+#include "Serial.h"
+#include "SerialManager.generated.h"
+
+UENUM(BlueprintType, Category = "UE4Duino")
+enum class ESerialDeviceState : uint8
+{
+	//No device with this id was added.
+	Unknown,
+	//An open is running in the background.
+	Connecting,
+	Connected,
+	//The device was lost or couldn't be opened, waiting for the next attempt.
+	Disconnected
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSerialDeviceEvent, FName, DeviceId, USerial*, Serial);
+
+/** An open running on the thread pool. Whichever side lets go of it last closes a handle nobody adopted. */
+struct FSerialPendingOpen
+{
+	enum EState
+	{
+		Running,
+		Done,
+		Abandoned
+	};
+
+	TAtomic<int32> State;
+	bool bSuccess;
+	FSerialDeviceHandle Handle;
+
+	FSerialPendingOpen()
+		: State(Running)
+		, bSuccess(false)
+		, Handle()
+	{}
+};
+
+/** What the manager knows about one device, besides its USerial. */
+struct FSerialManagedDevice
+{
+	FName Id;
+	//Empty means any free device from USerial::EnumerateDevicePaths.
+	FString DevicePath;
+	int32 BaudRate;
+	bool bAsync;
+	int32 AsyncQueueSize;
+
+	ESerialDeviceState State;
+	//The path of the running or most recent open.
+	FString CurrentPath;
+	int32 NextCandidate;
+	double NextAttemptTime;
+	float ReconnectDelay;
+	bool bHasConnected;
+	int32 NumReconnects;
+	TSharedPtr<FSerialPendingOpen, ESPMode::ThreadSafe> PendingOpen;
+	//Bytes queued in async mode that hadn't reached the device when it was lost. Sent first after reconnecting.
+	TArray<uint8> UnsentBytes;
+};
+
+/**
+* Owns any number of serial devices and keeps them connected.
+* Devices are opened in the background, so a Bluetooth link that takes seconds to come up never stalls the game.
+* A device that fails a read or write, or that the driver reports as gone, is closed and reopened with exponential backoff.
+* The USerial of a device stays the same across reconnects, so anything holding on to it, like an output scheduler, keeps working.
+* Output schedulers hold on to their latest values while the device is gone and send them again once it is back.
+*/
+UCLASS(Category = "UE4Duino", meta = (Keywords = "com arduino serial reconnect bluetooth"))
+class UE4DUINO_API USerialManager : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	USerialManager();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	* Start managing a device. It is opened in the background, listen to OnDeviceConnected or check Get Device State.
+	*
+	* @param DeviceId Name to refer to the device by. Adding an id again replaces the previous device.
+	* @param DevicePath The device to open, like COM3 or /dev/rfcomm0. Leave empty to use the first free device from List Serial Devices.
+	* @param BaudRate BaudRate to open the device with.
+	* @param bAsync Put the port in async mode after every open.
+	* @param AsyncQueueSize Queue size for async mode.
+	* @return The Serial instance of the device. It stays the same across reconnects.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Serial Device"), Category = "UE4Duino | Manager")
+	USerial* AddDevice(FName DeviceId, FString DevicePath, int32 BaudRate = 9600, bool bAsync = false, int32 AsyncQueueSize = 4096);
+
+	/** Close a device and stop managing it. */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Remove Serial Device"), Category = "UE4Duino | Manager")
+	void RemoveDevice(FName DeviceId);
+
+	/** The Serial instance of a device, or null if there is no device with that id. It may not be open right now. */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Serial Device"), Category = "UE4Duino | Manager")
+	USerial* GetDevice(FName DeviceId) const;
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Serial Device State"), Category = "UE4Duino | Manager")
+	ESerialDeviceState GetDeviceState(FName DeviceId) const;
+
+	/** Number of times a device came back after being lost. */
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Serial Device Reconnects"), Category = "UE4Duino | Manager")
+	int32 GetNumReconnects(FName DeviceId) const;
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Serial Device Ids"), Category = "UE4Duino | Manager")
+	TArray<FName> GetDeviceIds() const;
+
+	/** The first retry after losing a device, in seconds. Every failed attempt doubles it. */
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | Manager")
+	float InitialReconnectDelay;
+
+	/** The longest wait between two reconnect attempts, in seconds. */
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | Manager")
+	float MaxReconnectDelay;
+
+	/** Fired on the game thread every time a device is opened, the first time as well as after a reconnect. */
+	UPROPERTY(BlueprintAssignable, Category = "UE4Duino | Manager")
+	FSerialDeviceEvent OnDeviceConnected;
+
+	/** Fired on the game thread when a device was lost. It is reconnected automatically. */
+	UPROPERTY(BlueprintAssignable, Category = "UE4Duino | Manager")
+	FSerialDeviceEvent OnDeviceDisconnected;
+
+protected:
+	UPROPERTY(Transient)
+	TMap<FName, USerial*> Devices;
+
+	TArray<FSerialManagedDevice> ManagedDevices;
+	FDelegateHandle TickerHandle;
+
+	FSerialManagedDevice* FindManagedDevice(FName DeviceId);
+	const FSerialManagedDevice* FindManagedDevice(FName DeviceId) const;
+	/** Pick the path for the next attempt. Returns false if there is nothing to try. */
+	bool ChooseDevicePath(FSerialManagedDevice& Device, FString& OutPath);
+	void BeginOpen(FSerialManagedDevice& Device, double Now);
+	/** Returns true if the device is connected now. */
+	bool FinishOpen(FSerialManagedDevice& Device, double Now);
+	void OnDeviceLost(FSerialManagedDevice& Device, double Now);
+	void ScheduleRetry(FSerialManagedDevice& Device, double Now);
+	void AbandonOpen(FSerialManagedDevice& Device);
+	bool Tick(float DeltaTime);
+};
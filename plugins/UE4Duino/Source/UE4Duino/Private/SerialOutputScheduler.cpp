@@ -0,0 +1,258 @@
+#include "SerialOutputScheduler.h"
+#include "Serial.h"
+
+#include "HAL/PlatformTime.h"
+
+//Start, stop and 8 data bits.
+#define SERIAL_BITS_PER_BYTE 10.0f
+//Share of the raw link rate we plan with, so acks and retries coming the other way still fit.
+#define SERIAL_LINK_UTILIZATION 0.8f
+//Overhead of a binary frame on top of its payload.
+#define SERIAL_FRAME_OVERHEAD (SERIAL_FRAME_HEADER_SIZE + SERIAL_FRAME_CRC_SIZE)
+
+USerialOutputScheduler::USerialOutputScheduler()
+	: bSkipUnchanged(true)
+	, BurstBytes(32)
+	, Serial(nullptr)
+	, BytesPerSecond(0.0f)
+	, CommandsPerSecond(0.0f)
+	, ByteTokens(0.0f)
+	, CommandTokens(0.0f)
+	, NumSent(0)
+	, NumSuperseded(0)
+	, NumSkippedUnchanged(0)
+	, LastSendDelay(0.0f)
+	, MaxSendDelay(0.0f)
+	, SeenOpenCount(0)
+{
+}
+
+USerialOutputScheduler* USerialOutputScheduler::CreateOutputScheduler(USerial* Serial, float MaxBytesPerSecond, float MaxCommandsPerSecond)
+{
+	if (Serial == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Can't create an output scheduler without a serial port."));
+		return nullptr;
+	}
+
+	USerialOutputScheduler* Scheduler = NewObject<USerialOutputScheduler>(Serial);
+	Scheduler->Serial = Serial;
+	Scheduler->SeenOpenCount = Serial->GetOpenCount();
+	Scheduler->SetRateLimits(MaxBytesPerSecond, MaxCommandsPerSecond);
+	Scheduler->TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(Scheduler, &USerialOutputScheduler::Tick));
+	return Scheduler;
+}
+
+void USerialOutputScheduler::SetRateLimits(float MaxBytesPerSecond, float MaxCommandsPerSecond)
+{
+	BytesPerSecond = MaxBytesPerSecond;
+	if (BytesPerSecond <= 0.0f && Serial != nullptr && Serial->GetBaud() > 0)
+	{
+		BytesPerSecond = Serial->GetBaud() / SERIAL_BITS_PER_BYTE * SERIAL_LINK_UTILIZATION;
+	}
+	CommandsPerSecond = FMath::Max(MaxCommandsPerSecond, 0.0f);
+}
+
+void USerialOutputScheduler::SetChannelBytes(FName Channel, const TArray<uint8>& Bytes)
+{
+	SetPending(Channel, Bytes.GetData(), Bytes.Num(), false, 0);
+}
+
+void USerialOutputScheduler::SetChannelLine(FName Channel, const FString& Line)
+{
+	const FString LineEnd = Serial != nullptr ? Serial->LineEndToStr(Serial->WriteLineEnd) : TEXT("\n");
+	auto Convert = FTCHARToUTF8(*(Line + LineEnd));
+	SetPending(Channel, (const uint8*)Convert.Get(), Convert.Length(), false, 0);
+}
+
+void USerialOutputScheduler::SetChannelFrame(FName Channel, uint8 CommandId, const TArray<uint8>& Payload)
+{
+	if (Payload.Num() > SERIAL_FRAME_MAX_PAYLOAD)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Frame payload too large: %d bytes, the limit is %d"), Payload.Num(), SERIAL_FRAME_MAX_PAYLOAD);
+		return;
+	}
+
+	SetPending(Channel, Payload.GetData(), Payload.Num(), true, CommandId);
+}
+
+void USerialOutputScheduler::ClearChannel(FName Channel)
+{
+	for (FSerialOutputChannel& Existing : Channels)
+	{
+		if (Existing.Name == Channel)
+		{
+			Existing.bHasPending = false;
+			Existing.Pending.Reset();
+			return;
+		}
+	}
+}
+
+void USerialOutputScheduler::ResendLatest()
+{
+	const double Now = FPlatformTime::Seconds();
+	for (FSerialOutputChannel& Channel : Channels)
+	{
+		if (!Channel.bHasSent) continue;
+
+		//A newer value is already waiting, that one is what the device should end up with.
+		if (!Channel.bHasPending)
+		{
+			Channel.Pending = Channel.LastSent;
+			Channel.PendingCommandId = Channel.LastSentCommandId;
+			Channel.bPendingIsFrame = Channel.bLastSentIsFrame;
+			Channel.PendingSince = Now;
+			Channel.bHasPending = true;
+		}
+		Channel.bHasSent = false;
+	}
+}
+
+void USerialOutputScheduler::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	Channels.Reset();
+}
+
+void USerialOutputScheduler::BeginDestroy()
+{
+	Stop();
+	Super::BeginDestroy();
+}
+
+FSerialOutputChannel& USerialOutputScheduler::FindOrAddChannel(FName Channel)
+{
+	//There are only ever a handful of channels, a linear search beats hashing here.
+	for (FSerialOutputChannel& Existing : Channels)
+	{
+		if (Existing.Name == Channel)
+		{
+			return Existing;
+		}
+	}
+
+	FSerialOutputChannel& Added = Channels.AddDefaulted_GetRef();
+	Added.Name = Channel;
+	Added.PendingSince = 0.0;
+	Added.PendingCommandId = 0;
+	Added.LastSentCommandId = 0;
+	Added.bHasPending = false;
+	Added.bPendingIsFrame = false;
+	Added.bLastSentIsFrame = false;
+	Added.bHasSent = false;
+	return Added;
+}
+
+void USerialOutputScheduler::SetPending(FName Channel, const uint8* Data, int32 NumBytes, bool bIsFrame, uint8 CommandId)
+{
+	FSerialOutputChannel& Target = FindOrAddChannel(Channel);
+
+	//A superseded value keeps its place in line, otherwise a channel that changes every frame would never get out.
+	if (Target.bHasPending)
+	{
+		NumSuperseded++;
+	}
+	else
+	{
+		Target.PendingSince = FPlatformTime::Seconds();
+		Target.bHasPending = true;
+	}
+
+	Target.Pending.Reset();
+	Target.Pending.Append(Data, NumBytes);
+	Target.bPendingIsFrame = bIsFrame;
+	Target.PendingCommandId = CommandId;
+}
+
+bool USerialOutputScheduler::SendChannel(FSerialOutputChannel& Channel, double Now)
+{
+	bool bSent;
+	int32 Sequence = -1;
+	if (Channel.bPendingIsFrame)
+	{
+		bSent = Serial->WriteFrame(Channel.PendingCommandId, Channel.Pending, Sequence);
+	}
+	else
+	{
+		bSent = Serial->WriteBytes(Channel.Pending);
+	}
+
+	if (!bSent) return false;
+
+	LastSendDelay = (float)(Now - Channel.PendingSince);
+	MaxSendDelay = FMath::Max(MaxSendDelay, LastSendDelay);
+	NumSent++;
+	OnChannelSent.Broadcast(Channel.Name, Sequence, Serial->GetTotalBytesQueued(), Channel.PendingSince);
+
+	Swap(Channel.LastSent, Channel.Pending);
+	Channel.Pending.Reset();
+	Channel.LastSentCommandId = Channel.PendingCommandId;
+	Channel.bLastSentIsFrame = Channel.bPendingIsFrame;
+	Channel.bHasSent = true;
+	Channel.bHasPending = false;
+	return true;
+}
+
+bool USerialOutputScheduler::Tick(float DeltaTime)
+{
+	//While the device is gone, values keep coalescing here and go out once it is back.
+	if (Serial == nullptr || !Serial->IsOpened() || Serial->HasDeviceError()) return true;
+
+	if (Serial->GetOpenCount() != SeenOpenCount)
+	{
+		SeenOpenCount = Serial->GetOpenCount();
+		ResendLatest();
+	}
+
+	ByteTokens = BytesPerSecond > 0.0f ? FMath::Min(ByteTokens + DeltaTime * BytesPerSecond, (float)FMath::Max(BurstBytes, 1)) : 0.0f;
+	CommandTokens = CommandsPerSecond > 0.0f ? FMath::Min(CommandTokens + DeltaTime * CommandsPerSecond, 1.0f) : 0.0f;
+
+	//Whatever the port still has to push out counts against the budget. That way the backlog never grows past one burst.
+	if (Serial->GetPendingWriteBytes() > BurstBytes) return true;
+
+	const double Now = FPlatformTime::Seconds();
+	while (true)
+	{
+		if (CommandsPerSecond > 0.0f && CommandTokens < 1.0f) break;
+
+		FSerialOutputChannel* Oldest = nullptr;
+		for (FSerialOutputChannel& Channel : Channels)
+		{
+			if (!Channel.bHasPending) continue;
+
+			if (bSkipUnchanged && Channel.bHasSent
+				&& Channel.bPendingIsFrame == Channel.bLastSentIsFrame
+				&& Channel.PendingCommandId == Channel.LastSentCommandId
+				&& Channel.Pending == Channel.LastSent)
+			{
+				Channel.bHasPending = false;
+				NumSkippedUnchanged++;
+				continue;
+			}
+
+			if (Oldest == nullptr || Channel.PendingSince < Oldest->PendingSince)
+			{
+				Oldest = &Channel;
+			}
+		}
+
+		if (Oldest == nullptr) break;
+
+		//A message larger than the burst still goes out once the bucket is full, it just leaves the bucket in debt.
+		const int32 Cost = Oldest->Pending.Num() + (Oldest->bPendingIsFrame ? SERIAL_FRAME_OVERHEAD : 0);
+		if (BytesPerSecond > 0.0f && ByteTokens < FMath::Min(Cost, FMath::Max(BurstBytes, 1))) break;
+
+		if (!SendChannel(*Oldest, Now)) break;
+
+		ByteTokens -= Cost;
+		CommandTokens -= 1.0f;
+	}
+
+	return true;
+}
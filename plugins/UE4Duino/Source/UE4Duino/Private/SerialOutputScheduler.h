@@ -0,0 +1,139 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Containers/Ticker.h"
+#include "SerialOutputScheduler.generated.h"
+
+class USerial;
+
+/** The latest unsent value of one output channel. For frames, the bytes are the payload. */
+struct FSerialOutputChannel
+{
+	FName Name;
+	TArray<uint8> Pending;
+	TArray<uint8> LastSent;
+	double PendingSince;
+	uint8 PendingCommandId;
+	uint8 LastSentCommandId;
+	bool bHasPending;
+	bool bPendingIsFrame;
+	bool bLastSentIsFrame;
+	bool bHasSent;
+};
+
+/**
+* Native notification that a channel value was written to the port.
+* Params: channel, frame sequence (-1 for bytes and lines), USerial::GetTotalBytesQueued right after the write, and FPlatformTime::Seconds when the value was set.
+*/
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnSerialChannelSent, FName, int32, uint64, double);
+
+/**
+* Rate limited output for state that changes every frame, like where the user is looking.
+* Instead of queueing every command, each channel only holds the latest value that hasn't been sent yet.
+* Setting a channel again before it went out replaces the old value, so stale commands never reach the wire.
+* Channels are sent oldest first, no faster than the link can take them. That keeps the delay between
+* setting a value and the device receiving it bounded by the number of channels, not by the frame rate.
+*/
+UCLASS(BlueprintType, Category = "UE4Duino", meta = (Keywords = "com arduino serial rate limit coalesce"))
+class UE4DUINO_API USerialOutputScheduler : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	USerialOutputScheduler();
+
+	/**
+	* Create a scheduler that sends through Serial. It ticks by itself until Stop is called or it is destroyed.
+	*
+	* @param Serial The port to send through.
+	* @param MaxBytesPerSecond Link budget. 0 uses 80% of what the port's baud rate can carry.
+	* @param MaxCommandsPerSecond Limit on sent commands across all channels. 0 means no limit besides the byte budget.
+	* @return The scheduler, or null if Serial is null.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Create Output Scheduler"), Category = "UE4Duino | Scheduler")
+	static USerialOutputScheduler* CreateOutputScheduler(USerial* Serial, float MaxBytesPerSecond = 0.0f, float MaxCommandsPerSecond = 0.0f);
+
+	/** Set the latest bytes for a channel. Replaces a value on the channel that hasn't been sent yet. */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Channel Bytes"), Category = "UE4Duino | Scheduler")
+	void SetChannelBytes(FName Channel, const TArray<uint8>& Bytes);
+	/** Set the latest line for a channel. The serial port's WriteLineEnd is appended. */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Channel Line"), Category = "UE4Duino | Scheduler")
+	void SetChannelLine(FName Channel, const FString& Line);
+	/** Set the latest binary frame for a channel. The sequence number is assigned when the frame is actually sent. */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Channel Frame"), Category = "UE4Duino | Scheduler")
+	void SetChannelFrame(FName Channel, uint8 CommandId, const TArray<uint8>& Payload);
+	/** Drop the unsent value of a channel, if any. */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Clear Channel"), Category = "UE4Duino | Scheduler")
+	void ClearChannel(FName Channel);
+
+	/**
+	* Send the latest value of every channel again, even with bSkipUnchanged set.
+	* Called by itself when the port is reopened, since the device has most likely been reset and lost its state.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Resend Latest"), Category = "UE4Duino | Scheduler")
+	void ResendLatest();
+
+	/** Stop ticking. Unsent values are dropped. */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Stop Scheduler"), Category = "UE4Duino | Scheduler")
+	void Stop();
+
+	/** Change the link budget. Same meaning as the parameters of CreateOutputScheduler. */
+	UFUNCTION(BlueprintCallable, Category = "UE4Duino | Scheduler")
+	void SetRateLimits(float MaxBytesPerSecond, float MaxCommandsPerSecond);
+
+	/** Number of commands that actually went out. */
+	UFUNCTION(BlueprintPure, Category = "UE4Duino | Scheduler")
+	int32 GetNumSent() const { return NumSent; }
+	/** Number of commands replaced by a newer value before they could be sent. */
+	UFUNCTION(BlueprintPure, Category = "UE4Duino | Scheduler")
+	int32 GetNumSuperseded() const { return NumSuperseded; }
+	/** Number of unchanged values that weren't sent again because bSkipUnchanged is set. */
+	UFUNCTION(BlueprintPure, Category = "UE4Duino | Scheduler")
+	int32 GetNumSkippedUnchanged() const { return NumSkippedUnchanged; }
+	/** How long the most recently sent value waited in the scheduler, in seconds. */
+	UFUNCTION(BlueprintPure, Category = "UE4Duino | Scheduler")
+	float GetLastSendDelay() const { return LastSendDelay; }
+	/** The longest any value has waited in the scheduler, in seconds. */
+	UFUNCTION(BlueprintPure, Category = "UE4Duino | Scheduler")
+	float GetMaxSendDelay() const { return MaxSendDelay; }
+
+	/** Don't resend a value that is identical to the last one sent on the same channel. */
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | Scheduler")
+	bool bSkipUnchanged;
+
+	/** How many bytes may go out back to back after the link has been idle. */
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | Scheduler")
+	int32 BurstBytes;
+
+	/** Fired on the game thread after each value that went out. */
+	FOnSerialChannelSent OnChannelSent;
+
+	virtual void BeginDestroy() override;
+
+protected:
+	UPROPERTY()
+	USerial* Serial;
+
+	TArray<FSerialOutputChannel> Channels;
+	FDelegateHandle TickerHandle;
+
+	float BytesPerSecond;
+	float CommandsPerSecond;
+	float ByteTokens;
+	float CommandTokens;
+
+	int32 NumSent;
+	int32 NumSuperseded;
+	int32 NumSkippedUnchanged;
+	float LastSendDelay;
+	float MaxSendDelay;
+
+	//USerial::GetOpenCount as of the last tick, to notice reconnects.
+	int32 SeenOpenCount;
+
+	FSerialOutputChannel& FindOrAddChannel(FName Channel);
+	void SetPending(FName Channel, const uint8* Data, int32 NumBytes, bool bIsFrame, uint8 CommandId);
+	bool SendChannel(FSerialOutputChannel& Channel, double Now);
+	bool Tick(float DeltaTime);
+};
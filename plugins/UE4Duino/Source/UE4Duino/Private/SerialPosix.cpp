@@ -0,0 +1,304 @@
+//termios backend for Linux and Mac. Mirrors the behavior of the Windows backend: raw 8N1, reads never block, writes wait at most a few milliseconds.
+
+#include "Serial.h"
+
+#if PLATFORM_LINUX || PLATFORM_MAC
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define SERIAL_WRITE_TIMEOUT_MS 10
+
+static bool BaudRateToSpeed(int32 BaudRate, speed_t& OutSpeed)
+{
+	switch (BaudRate)
+	{
+	case 1200: OutSpeed = B1200; return true;
+	case 2400: OutSpeed = B2400; return true;
+	case 4800: OutSpeed = B4800; return true;
+	case 9600: OutSpeed = B9600; return true;
+	case 19200: OutSpeed = B19200; return true;
+	case 38400: OutSpeed = B38400; return true;
+	case 57600: OutSpeed = B57600; return true;
+	case 115200: OutSpeed = B115200; return true;
+	case 230400: OutSpeed = B230400; return true;
+#ifdef B460800
+	case 460800: OutSpeed = B460800; return true;
+#endif
+#ifdef B500000
+	case 500000: OutSpeed = B500000; return true;
+#endif
+#ifdef B921600
+	case 921600: OutSpeed = B921600; return true;
+#endif
+#ifdef B1000000
+	case 1000000: OutSpeed = B1000000; return true;
+#endif
+#ifdef B2000000
+	case 2000000: OutSpeed = B2000000; return true;
+#endif
+	default: return false;
+	}
+}
+
+bool USerial::IsOpened()
+{
+	return m_FileDescriptor >= 0 || m_VirtualDevice.IsValid();
+}
+
+TArray<FString> USerial::GetDevicePathsForPort(int32 nPort)
+{
+	//There are no COM numbers here, so map the number onto the usual device names. Arduinos with native USB show up as ttyACM, the ones behind a USB serial chip as ttyUSB.
+	static const TCHAR* DevicePatterns[] =
+	{
+#if PLATFORM_MAC
+		TEXT("/dev/cu.usbmodem%d"),
+		TEXT("/dev/cu.usbserial%d"),
+#else
+		TEXT("/dev/ttyACM%d"),
+		TEXT("/dev/ttyUSB%d"),
+		TEXT("/dev/ttyS%d"),
+#endif
+	};
+
+	TArray<FString> DevicePaths;
+	for (const TCHAR* DevicePattern : DevicePatterns)
+	{
+		FString DevicePath = FString::Printf(DevicePattern, nPort);
+		if (access(TCHAR_TO_UTF8(*DevicePath), F_OK) == 0)
+		{
+			DevicePaths.Add(MoveTemp(DevicePath));
+		}
+	}
+	return DevicePaths;
+}
+
+bool USerial::OpenDeviceHandle(const FString& DevicePath, int32 nBaud, FSerialDeviceHandle& OutHandle)
+{
+	speed_t Speed;
+	if (!BaudRateToSpeed(nBaud, Speed))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Unsupported baud rate %d for port %s"), nBaud, *DevicePath);
+		return false;
+	}
+
+	const int FileDescriptor = open(TCHAR_TO_UTF8(*DevicePath), O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if (FileDescriptor < 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to open port %s. Error: %d"), *DevicePath, errno);
+		return false;
+	}
+
+	termios Settings;
+	FMemory::Memset(&Settings, 0, sizeof(Settings));
+	if (tcgetattr(FileDescriptor, &Settings) != 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to setup port %s. Error: %d"), *DevicePath, errno);
+		close(FileDescriptor);
+		return false;
+	}
+
+	//Raw 8N1 without flow control, the same as the DCB setup on Windows.
+	cfmakeraw(&Settings);
+	Settings.c_cflag |= (CLOCAL | CREAD);
+	Settings.c_cflag &= ~(CSTOPB | PARENB | CRTSCTS);
+	Settings.c_cc[VMIN] = 0;
+	Settings.c_cc[VTIME] = 0;
+	cfsetispeed(&Settings, Speed);
+	cfsetospeed(&Settings, Speed);
+
+	if (tcsetattr(FileDescriptor, TCSANOW, &Settings) != 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to setup port %s. Error: %d"), *DevicePath, errno);
+		close(FileDescriptor);
+		return false;
+	}
+
+	tcflush(FileDescriptor, TCIOFLUSH);
+	OutHandle = FileDescriptor;
+	return true;
+}
+
+void USerial::CloseDeviceHandle(FSerialDeviceHandle Handle)
+{
+	close(Handle);
+}
+
+bool USerial::AdoptDeviceHandle(FSerialDeviceHandle Handle)
+{
+	m_FileDescriptor = Handle;
+	return true;
+}
+
+void USerial::CloseDevice()
+{
+	if (m_VirtualDevice.IsValid())
+	{
+		m_VirtualDevice.Reset();
+		return;
+	}
+
+	close(m_FileDescriptor);
+	m_FileDescriptor = -1;
+}
+
+int32 USerial::ReadAvailableBytes(uint8* Buffer, int32 BufferSize)
+{
+	if (m_VirtualDevice.IsValid()) return BufferSize > 0 ? m_VirtualDevice->Read(Buffer, BufferSize) : 0;
+	if (m_FileDescriptor < 0 || BufferSize <= 0) return 0;
+
+	ssize_t NumRead;
+	do {
+		NumRead = read(m_FileDescriptor, Buffer, BufferSize);
+	} while (NumRead < 0 && errno == EINTR);
+
+	if (NumRead > 0) return (int32)NumRead;
+
+	//With VMIN and VTIME at 0 an idle tty reads 0 bytes, not EAGAIN, so 0 alone says nothing. A device that hung up, was unplugged or went out of Bluetooth range shows as POLLHUP or POLLERR, or as EIO/ENXIO from the read.
+	if (NumRead == 0)
+	{
+		pollfd PollFd;
+		PollFd.fd = m_FileDescriptor;
+		PollFd.events = 0;
+		PollFd.revents = 0;
+		if (poll(&PollFd, 1, 0) > 0 && (PollFd.revents & (POLLERR | POLLHUP | POLLNVAL)))
+		{
+			m_bDeviceError = true;
+		}
+		return 0;
+	}
+
+	if (errno != EAGAIN && errno != EWOULDBLOCK)
+	{
+		m_bDeviceError = true;
+	}
+
+	return 0;
+}
+
+int32 USerial::WriteRawBytes(const uint8* Data, int32 NumBytes)
+{
+	if (m_VirtualDevice.IsValid()) return NumBytes > 0 ? m_VirtualDevice->Write(Data, NumBytes) : 0;
+	if (m_FileDescriptor < 0 || NumBytes <= 0) return 0;
+
+	ssize_t NumWritten = write(m_FileDescriptor, Data, NumBytes);
+	if (NumWritten < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+	{
+		//The driver buffer is full. Give it a moment to drain, like the write timeout on Windows.
+		pollfd PollFd;
+		PollFd.fd = m_FileDescriptor;
+		PollFd.events = POLLOUT;
+		PollFd.revents = 0;
+		if (poll(&PollFd, 1, SERIAL_WRITE_TIMEOUT_MS) <= 0) return 0;
+
+		NumWritten = write(m_FileDescriptor, Data, NumBytes);
+		if (NumWritten < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) return 0;
+	}
+
+	if (NumWritten < 0)
+	{
+		m_bDeviceError = true;
+		return -1;
+	}
+
+	return (int32)NumWritten;
+}
+
+int32 USerial::GetDriverWriteQueueSize()
+{
+	if (m_VirtualDevice.IsValid()) return m_VirtualDevice->GetWriteQueueSize();
+	if (m_FileDescriptor < 0) return 0;
+
+	int NumQueued = 0;
+	if (ioctl(m_FileDescriptor, TIOCOUTQ, &NumQueued) != 0) return 0;
+
+	return NumQueued;
+}
+
+bool USerial::WaitUntilReadable(int32 TimeoutMs)
+{
+	if (m_FileDescriptor < 0) return false;
+
+	pollfd PollFd;
+	PollFd.fd = m_FileDescriptor;
+	PollFd.events = POLLIN;
+	PollFd.revents = 0;
+	poll(&PollFd, 1, TimeoutMs);
+
+	//A hung up device is always "ready", waiting on it would spin.
+	if (PollFd.revents & (POLLERR | POLLHUP | POLLNVAL))
+	{
+		m_bDeviceError = true;
+		return false;
+	}
+
+	//A timeout isn't readable either, or the caller would take it as a reason not to sleep.
+	return (PollFd.revents & POLLIN) != 0;
+}
+
+bool USerial::CheckDeviceHealth()
+{
+	if (m_VirtualDevice.IsValid())
+	{
+		if (!m_VirtualDevice->IsConnected()) m_bDeviceError = true;
+		return !m_bDeviceError;
+	}
+	if (m_FileDescriptor < 0) return false;
+
+	pollfd PollFd;
+	PollFd.fd = m_FileDescriptor;
+	PollFd.events = 0;
+	PollFd.revents = 0;
+	if (poll(&PollFd, 1, 0) > 0 && (PollFd.revents & (POLLERR | POLLHUP | POLLNVAL)))
+	{
+		m_bDeviceError = true;
+	}
+
+	return !m_bDeviceError;
+}
+
+TArray<FString> USerial::EnumerateDevicePaths()
+{
+	//Only the kinds of devices an Arduino or a Bluetooth serial module shows up as. The legacy ttyS ports always exist, whether something is attached or not.
+	static const TCHAR* DevicePrefixes[] =
+	{
+#if PLATFORM_MAC
+		TEXT("cu.usbmodem"),
+		TEXT("cu.usbserial"),
+		TEXT("cu.wchusbserial"),
+		TEXT("cu.HC-"),
+#else
+		TEXT("ttyACM"),
+		TEXT("ttyUSB"),
+		TEXT("rfcomm"),
+#endif
+	};
+
+	TArray<FString> DevicePaths;
+	DIR* DevDir = opendir("/dev");
+	if (DevDir == nullptr) return DevicePaths;
+
+	while (dirent* Entry = readdir(DevDir))
+	{
+		const FString Name = UTF8_TO_TCHAR(Entry->d_name);
+		for (const TCHAR* DevicePrefix : DevicePrefixes)
+		{
+			if (Name.StartsWith(DevicePrefix, ESearchCase::CaseSensitive))
+			{
+				DevicePaths.Add(TEXT("/dev/") + Name);
+				break;
+			}
+		}
+	}
+
+	closedir(DevDir);
+	DevicePaths.Sort();
+	return DevicePaths;
+}
+
+#endif //PLATFORM_LINUX || PLATFORM_MAC
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <string.h>
+
+/**
+* Reusable receive buffer for USerial.
+* Bytes are pulled in bulk straight into free space at the end, and consumed from the front.
+* Instead of wrapping around, the unread bytes are moved back to the start when the end runs out of room.
+* That keeps unread data contiguous, so terminators can be found with memchr and lines can be handed out as views.
+*/
+class FSerialReadBuffer
+{
+public:
+	explicit FSerialReadBuffer(int32 Capacity)
+		: ReadPos(0)
+		, WritePos(0)
+	{
+		Buffer.SetNumUninitialized(FMath::Max(Capacity, 64));
+	}
+
+	int32 Num() const { return WritePos - ReadPos; }
+	bool IsFull() const { return Num() == Buffer.Num(); }
+	const uint8* GetData() const { return Buffer.GetData() + ReadPos; }
+
+	/**
+	* Get the free space at the end of the buffer to receive into. Call CommitWrite with the number of bytes actually written.
+	* @param OutSize The number of bytes that may be written.
+	*/
+	uint8* GetWriteSpace(int32& OutSize)
+	{
+		//Only compact when it buys a meaningful amount of room, so the move is amortized over many reads.
+		if (ReadPos > 0 && Buffer.Num() - WritePos < Buffer.Num() / 2)
+		{
+			const int32 NumUnread = Num();
+			FMemory::Memmove(Buffer.GetData(), Buffer.GetData() + ReadPos, NumUnread);
+			ReadPos = 0;
+			WritePos = NumUnread;
+		}
+
+		OutSize = Buffer.Num() - WritePos;
+		return Buffer.GetData() + WritePos;
+	}
+
+	void CommitWrite(int32 NumBytes)
+	{
+		WritePos = FMath::Min(WritePos + FMath::Max(NumBytes, 0), Buffer.Num());
+	}
+
+	void Consume(int32 NumBytes)
+	{
+		ReadPos = FMath::Min(ReadPos + FMath::Max(NumBytes, 0), WritePos);
+		if (ReadPos == WritePos)
+		{
+			Reset();
+		}
+	}
+
+	/** @return The offset of the first occurrence of Byte in the unread data or INDEX_NONE. */
+	int32 Find(uint8 Byte) const
+	{
+		const uint8* Found = (const uint8*)memchr(GetData(), Byte, Num());
+		return Found != nullptr ? (int32)(Found - GetData()) : INDEX_NONE;
+	}
+
+	/** Copies and consumes up to MaxBytes bytes. */
+	int32 Read(uint8* Dest, int32 MaxBytes)
+	{
+		const int32 NumToRead = FMath::Min(FMath::Max(MaxBytes, 0), Num());
+		FMemory::Memcpy(Dest, GetData(), NumToRead);
+		Consume(NumToRead);
+		return NumToRead;
+	}
+
+	void Reset()
+	{
+		ReadPos = 0;
+		WritePos = 0;
+	}
+
+private:
+	TArray<uint8> Buffer;
+	int32 ReadPos;
+	int32 WritePos;
+};
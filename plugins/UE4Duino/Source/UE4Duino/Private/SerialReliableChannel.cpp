@@ -0,0 +1,275 @@
+#include "SerialReliableChannel.h"
+#include "Serial.h"
+
+#include "HAL/PlatformTime.h"
+
+//The sequence number is a byte. Keeping the window well below that means an ack can't be mistaken for one of a newer command.
+#define SERIAL_RELIABLE_MAX_WINDOW 64
+
+USerialReliableChannel::USerialReliableChannel()
+	: WindowSize(8)
+	, MaxRetries(8)
+	, MaxQueuedCommands(64)
+	, InitialRetransmitTimeout(0.3f)
+	, MinRetransmitTimeout(0.05f)
+	, MaxRetransmitTimeout(2.0f)
+	, bSupersedeByCommandId(true)
+	, Serial(nullptr)
+	, NextHandle(0)
+	, SeenOpenCount(0)
+	, SmoothedRtt(0.0)
+	, RttVariation(0.0)
+	, RetransmitTimeout(0.3)
+	, bHasRttSample(false)
+{
+}
+
+USerialReliableChannel* USerialReliableChannel::CreateReliableChannel(USerial* Serial, int32 WindowSize)
+{
+	if (Serial == nullptr)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Can't create a reliable channel without a serial port."));
+		return nullptr;
+	}
+
+	USerialReliableChannel* Channel = NewObject<USerialReliableChannel>(Serial);
+	Channel->Serial = Serial;
+	Channel->SeenOpenCount = Serial->GetOpenCount();
+	Channel->WindowSize = FMath::Clamp(WindowSize, 1, SERIAL_RELIABLE_MAX_WINDOW);
+	Channel->RetransmitTimeout = Channel->InitialRetransmitTimeout;
+	Channel->TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(Channel, &USerialReliableChannel::Tick));
+	return Channel;
+}
+
+int32 USerialReliableChannel::SendCommand(uint8 CommandId, const TArray<uint8>& Payload)
+{
+	if (Serial == nullptr || !TickerHandle.IsValid()) return -1;
+	if (Payload.Num() > SERIAL_FRAME_MAX_PAYLOAD)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Frame payload too large: %d bytes, the limit is %d"), Payload.Num(), SERIAL_FRAME_MAX_PAYLOAD);
+		return -1;
+	}
+
+	if (bSupersedeByCommandId)
+	{
+		RemoveSuperseded(CommandId);
+	}
+	if (Queued.Num() >= MaxQueuedCommands) return -1;
+
+	FSerialReliableCommand& Command = Queued.AddDefaulted_GetRef();
+	Command.Payload = Payload;
+	Command.Handle = NextHandle++;
+	Command.CommandId = CommandId;
+	Command.Sequence = 0;
+	Command.NumTransmissions = 0;
+	Command.FirstSentTime = 0.0;
+	Command.LastSentTime = 0.0;
+	Command.Deadline = 0.0;
+	Stats.NumCommands++;
+
+	//Don't wait for the next tick if there is room in the window.
+	const int32 Handle = Command.Handle;
+	if (Serial->IsOpened() && !Serial->HasDeviceError())
+	{
+		FillWindow(FPlatformTime::Seconds());
+	}
+	return Handle;
+}
+
+int32 USerialReliableChannel::SendDrive(int32 LeftDuty, int32 RightDuty)
+{
+	return SendCommand((uint8)ESerialFrameCommand::Drive, USerial::MakeDrivePayload(LeftDuty, RightDuty));
+}
+
+void USerialReliableChannel::Stop()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	Queued.Reset();
+	InFlight.Reset();
+}
+
+void USerialReliableChannel::BeginDestroy()
+{
+	Stop();
+	Super::BeginDestroy();
+}
+
+FSerialLinkStats USerialReliableChannel::GetStats() const
+{
+	FSerialLinkStats Result = Stats;
+	Result.LossRate = Stats.NumTransmissions > 0 ? (float)Stats.NumRetransmissions / Stats.NumTransmissions : 0.0f;
+	Result.SmoothedRtt = (float)SmoothedRtt;
+	Result.RttVariation = (float)RttVariation;
+	Result.RetransmitTimeout = (float)RetransmitTimeout;
+	Result.NumInFlight = InFlight.Num();
+	Result.NumQueued = Queued.Num();
+	return Result;
+}
+
+void USerialReliableChannel::ResetStats()
+{
+	//The round trip estimate describes the link, not the counted period, so it is kept.
+	Stats = FSerialLinkStats();
+}
+
+void USerialReliableChannel::Transmit(FSerialReliableCommand& Command, double Now)
+{
+	//A failed write is treated like a lost frame, the timeout takes care of it.
+	Serial->WriteFrameWithSequence(Command.CommandId, Command.Payload, Command.Sequence);
+
+	if (Command.NumTransmissions == 0)
+	{
+		Command.FirstSentTime = Now;
+	}
+	else
+	{
+		Stats.NumRetransmissions++;
+	}
+	Command.NumTransmissions++;
+	Command.LastSentTime = Now;
+	Command.Deadline = Now + RetransmitTimeout;
+	Stats.NumTransmissions++;
+}
+
+void USerialReliableChannel::FillWindow(double Now)
+{
+	const int32 Window = FMath::Clamp(WindowSize, 1, SERIAL_RELIABLE_MAX_WINDOW);
+	while (Queued.Num() > 0 && InFlight.Num() < Window)
+	{
+		FSerialReliableCommand& Command = InFlight.Add_GetRef(MoveTemp(Queued[0]));
+		Queued.RemoveAt(0, 1, false);
+
+		//The number stays with the command for every retransmission, that is how the ack is matched.
+		Command.Sequence = Serial->AllocateFrameSequence();
+		Transmit(Command, Now);
+	}
+}
+
+void USerialReliableChannel::OnAck(uint8 Sequence, uint8 AckedCommandId, ESerialFrameAckStatus Status, double Now)
+{
+	for (int32 CommandIdx = 0; CommandIdx < InFlight.Num(); CommandIdx++)
+	{
+		const FSerialReliableCommand& Command = InFlight[CommandIdx];
+		if (Command.Sequence != Sequence || Command.CommandId != AckedCommandId) continue;
+
+		//Karn's algorithm: the ack of a retransmitted frame could belong to any of its transmissions, so it says nothing about the round trip time.
+		if (Command.NumTransmissions == 1)
+		{
+			AddRttSample(Now - Command.FirstSentTime);
+		}
+
+		const int32 Handle = Command.Handle;
+		const float DeliveryTime = (float)(Now - Command.FirstSentTime);
+		InFlight.RemoveAt(CommandIdx, 1, false);
+		Stats.NumDelivered++;
+
+		OnCommandAcked.Broadcast(Handle, AckedCommandId, Status, DeliveryTime);
+		return;
+	}
+
+	Stats.NumUnmatchedAcks++;
+}
+
+void USerialReliableChannel::AddRttSample(double Rtt)
+{
+	if (!bHasRttSample)
+	{
+		SmoothedRtt = Rtt;
+		RttVariation = Rtt * 0.5;
+		Stats.MinRtt = (float)Rtt;
+		bHasRttSample = true;
+	}
+	else
+	{
+		RttVariation = 0.75 * RttVariation + 0.25 * FMath::Abs(SmoothedRtt - Rtt);
+		SmoothedRtt = 0.875 * SmoothedRtt + 0.125 * Rtt;
+		Stats.MinRtt = FMath::Min(Stats.MinRtt, (float)Rtt);
+	}
+	Stats.LastRtt = (float)Rtt;
+
+	//A fresh sample also ends any backoff.
+	RetransmitTimeout = FMath::Clamp(SmoothedRtt + 4.0 * RttVariation, (double)MinRetransmitTimeout, (double)MaxRetransmitTimeout);
+}
+
+void USerialReliableChannel::RemoveSuperseded(uint8 CommandId)
+{
+	auto IsSuperseded = [CommandId](const FSerialReliableCommand& Command) { return Command.CommandId == CommandId; };
+	Stats.NumSuperseded += Queued.RemoveAll(IsSuperseded);
+	Stats.NumSuperseded += InFlight.RemoveAll(IsSuperseded);
+}
+
+bool USerialReliableChannel::Tick(float DeltaTime)
+{
+	//While the device is gone commands wait here, the timeouts would only burn through the retries.
+	if (Serial == nullptr || !Serial->IsOpened() || Serial->HasDeviceError()) return true;
+
+	const double Now = FPlatformTime::Seconds();
+
+	//The device was most likely reset by the reconnect, don't wait for the timeouts of frames it never saw.
+	if (Serial->GetOpenCount() != SeenOpenCount)
+	{
+		SeenOpenCount = Serial->GetOpenCount();
+		for (FSerialReliableCommand& Command : InFlight)
+		{
+			Command.Deadline = Now;
+		}
+	}
+
+	int32 Sequence;
+	uint8 AckedCommandId;
+	ESerialFrameAckStatus Status;
+	while (Serial->ReadFrame(FrameScratch))
+	{
+		if (USerial::BreakAckFrame(FrameScratch, Sequence, AckedCommandId, Status))
+		{
+			OnAck((uint8)Sequence, AckedCommandId, Status, Now);
+		}
+
+		//A listener may have stopped the channel.
+		if (!TickerHandle.IsValid()) return false;
+	}
+
+	//All timeouts found in the same tick count as one loss event for the backoff.
+	bool bBackedOff = false;
+	TArray<FSerialReliableCommand, TInlineAllocator<8>> Failed;
+	for (int32 CommandIdx = 0; CommandIdx < InFlight.Num(); )
+	{
+		FSerialReliableCommand& Command = InFlight[CommandIdx];
+		if (Now < Command.Deadline)
+		{
+			CommandIdx++;
+			continue;
+		}
+
+		if (Command.NumTransmissions > MaxRetries)
+		{
+			Failed.Add(MoveTemp(Command));
+			InFlight.RemoveAt(CommandIdx, 1, false);
+			Stats.NumFailed++;
+			continue;
+		}
+
+		if (!bBackedOff)
+		{
+			RetransmitTimeout = FMath::Min(RetransmitTimeout * 2.0, (double)MaxRetransmitTimeout);
+			bBackedOff = true;
+		}
+		Transmit(Command, Now);
+		CommandIdx++;
+	}
+
+	FillWindow(Now);
+
+	for (const FSerialReliableCommand& Command : Failed)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Reliable command %d (id %d) was not acknowledged after %d transmissions"), Command.Handle, Command.CommandId, Command.NumTransmissions);
+		OnCommandFailed.Broadcast(Command.Handle, Command.CommandId);
+	}
+
+	return true;
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Containers/Ticker.h"
+#include "SerialFrame.h"
+#include "SerialReliableChannel.generated.h"
+
+class USerial;
+
+/** Delivery and round trip statistics of one reliable channel. Times are in seconds. */
+USTRUCT(BlueprintType)
+struct FSerialLinkStats
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	FSerialLinkStats()
+		: NumCommands(0)
+		, NumDelivered(0)
+		, NumFailed(0)
+		, NumSuperseded(0)
+		, NumTransmissions(0)
+		, NumRetransmissions(0)
+		, NumUnmatchedAcks(0)
+		, LossRate(0.0f)
+		, SmoothedRtt(0.0f)
+		, RttVariation(0.0f)
+		, MinRtt(0.0f)
+		, LastRtt(0.0f)
+		, RetransmitTimeout(0.0f)
+		, NumInFlight(0)
+		, NumQueued(0)
+	{}
+
+	/** Commands accepted by SendCommand. */
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	int32 NumCommands;
+	/** Commands the device acknowledged. */
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	int32 NumDelivered;
+	/** Commands given up on after MaxRetries retransmissions. */
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	int32 NumFailed;
+	/** Commands replaced by a newer command with the same id before they were acknowledged. */
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	int32 NumSuperseded;
+	/** Frames written, retransmissions included. */
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	int32 NumTransmissions;
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	int32 NumRetransmissions;
+	/** Acks that matched no command in flight, like a late ack for a command that was already retransmitted and acknowledged. */
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	int32 NumUnmatchedAcks;
+	/** Share of transmissions that had to be repeated, an estimate of the link's frame loss. */
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	float LossRate;
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	float SmoothedRtt;
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	float RttVariation;
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	float MinRtt;
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	float LastRtt;
+	/** How long the channel currently waits for an ack before retransmitting. */
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	float RetransmitTimeout;
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	int32 NumInFlight;
+	UPROPERTY(BlueprintReadOnly, Category = "UE4Duino | Reliable")
+	int32 NumQueued;
+};
+
+/** A command on its way through a reliable channel. */
+struct FSerialReliableCommand
+{
+	TArray<uint8> Payload;
+	int32 Handle;
+	uint8 CommandId;
+	uint8 Sequence;
+	int32 NumTransmissions;
+	double FirstSentTime;
+	double LastSentTime;
+	double Deadline;
+};
+
+/** DeliveryTime is from the first transmission to the ack, retransmissions included. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FSerialCommandAcked, int32, CommandHandle, uint8, CommandId, ESerialFrameAckStatus, Status, float, DeliveryTime);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSerialCommandFailed, int32, CommandHandle, uint8, CommandId);
+
+/**
+* Delivers binary frames with acknowledgements.
+* Every command keeps its frame sequence number until the device acks it, and is retransmitted with the same number when the ack doesn't come in time.
+* Up to WindowSize commands are in flight at once, so a lost frame only delays itself and not everything behind it.
+* The retransmit timeout follows the measured round trip time, the same way TCP does it (RFC 6298), and backs off while frames keep getting lost.
+*
+* The channel reads the port as frames to find the acks. Don't read the same port as lines or frames anywhere else.
+*/
+UCLASS(BlueprintType, Category = "UE4Duino", meta = (Keywords = "com arduino serial ack retransmit reliable"))
+class UE4DUINO_API USerialReliableChannel : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	USerialReliableChannel();
+
+	/**
+	* Create a channel that sends through Serial. It ticks by itself until Stop is called or it is destroyed.
+	*
+	* @param Serial The port to send through.
+	* @param WindowSize How many commands may wait for their ack at the same time, 1 to 64.
+	* @return The channel, or null if Serial is null.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Create Reliable Channel"), Category = "UE4Duino | Reliable")
+	static USerialReliableChannel* CreateReliableChannel(USerial* Serial, int32 WindowSize = 8);
+
+	/**
+	* Queue a command for delivery.
+	* @param CommandId The command id, usually one of ESerialFrameCommand.
+	* @param Payload Up to 32 bytes of command data.
+	* @return A handle that OnCommandAcked and OnCommandFailed report the command with, or -1 if the command wasn't accepted.
+	*/
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Send Reliable Command"), Category = "UE4Duino | Reliable")
+	int32 SendCommand(uint8 CommandId, const TArray<uint8>& Payload);
+
+	/** Queue a Drive frame for delivery. See USerial::MakeDrivePayload. */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Send Reliable Drive"), Category = "UE4Duino | Reliable")
+	int32 SendDrive(int32 LeftDuty, int32 RightDuty);
+
+	/** Stop ticking. Commands that weren't acknowledged yet are dropped without OnCommandFailed. */
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Stop Reliable Channel"), Category = "UE4Duino | Reliable")
+	void Stop();
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Link Stats"), Category = "UE4Duino | Reliable")
+	FSerialLinkStats GetStats() const;
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Reset Link Stats"), Category = "UE4Duino | Reliable")
+	void ResetStats();
+
+	/** How many commands may wait for their ack at the same time. */
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | Reliable", meta = (ClampMin = 1, ClampMax = 64))
+	int32 WindowSize;
+
+	/** Retransmissions before a command is given up on. */
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | Reliable")
+	int32 MaxRetries;
+
+	/** Commands waiting for room in the window, beyond which SendCommand refuses new ones. */
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | Reliable")
+	int32 MaxQueuedCommands;
+
+	/** The retransmit timeout before the first round trip was measured, in seconds. */
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | Reliable")
+	float InitialRetransmitTimeout;
+
+	/** Bounds of the retransmit timeout, in seconds. */
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | Reliable")
+	float MinRetransmitTimeout;
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | Reliable")
+	float MaxRetransmitTimeout;
+
+	/**
+	* A new command replaces unacknowledged ones with the same command id, which are then never retransmitted.
+	* The sketch's commands all set state, so this keeps a retransmitted old Drive from overriding a newer one.
+	* Turn it off for commands that must all arrive, they may then be executed out of order when one is lost.
+	*/
+	UPROPERTY(BlueprintReadWrite, Category = "UE4Duino | Reliable")
+	bool bSupersedeByCommandId;
+
+	UPROPERTY(BlueprintAssignable, Category = "UE4Duino | Reliable")
+	FSerialCommandAcked OnCommandAcked;
+
+	UPROPERTY(BlueprintAssignable, Category = "UE4Duino | Reliable")
+	FSerialCommandFailed OnCommandFailed;
+
+	virtual void BeginDestroy() override;
+
+protected:
+	UPROPERTY()
+	USerial* Serial;
+
+	TArray<FSerialReliableCommand> Queued;
+	TArray<FSerialReliableCommand> InFlight;
+	FDelegateHandle TickerHandle;
+	int32 NextHandle;
+	int32 SeenOpenCount;
+
+	double SmoothedRtt;
+	double RttVariation;
+	double RetransmitTimeout;
+	bool bHasRttSample;
+
+	FSerialLinkStats Stats;
+	FSerialFrame FrameScratch;
+
+	void Transmit(FSerialReliableCommand& Command, double Now);
+	void OnAck(uint8 Sequence, uint8 AckedCommandId, ESerialFrameAckStatus Status, double Now);
+	void AddRttSample(double Rtt);
+	void RemoveSuperseded(uint8 CommandId);
+	void FillWindow(double Now);
+	bool Tick(float DeltaTime);
+};
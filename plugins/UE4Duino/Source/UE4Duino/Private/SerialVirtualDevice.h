@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* A device that only exists in software, like a simulator of the sketch on the other end of the cable.
+* Opened with USerial::OpenVirtual, after which the USerial behaves exactly as if it was talking to hardware.
+* In async mode these are called from the I/O thread while the game thread may be using the device too, so implementations have to be thread safe.
+*/
+class ISerialVirtualDevice
+{
+public:
+	virtual ~ISerialVirtualDevice() {}
+
+	/** Bytes sent by the host. Returns the number of bytes accepted. */
+	virtual int32 Write(const uint8* Data, int32 NumBytes) = 0;
+	/** Bytes the device sent that have arrived at the host by now. Returns the number of bytes read. */
+	virtual int32 Read(uint8* Data, int32 MaxBytes) = 0;
+	/** Written bytes that are still on their way out, like the driver's transmit buffer. */
+	virtual int32 GetWriteQueueSize() { return 0; }
+	/** False once the device is gone, like an unplugged cable. */
+	virtual bool IsConnected() { return true; }
+};
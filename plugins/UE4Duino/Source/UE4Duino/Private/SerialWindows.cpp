@@ -0,0 +1,231 @@
+//Based off the "Arduino and C++ (for Windows)" code found at: http://playground.arduino.cc/Interfacing/CPPWindows
+
+#include "Serial.h"
+
+#if PLATFORM_WINDOWS
+
+bool USerial::IsOpened()
+{
+	return m_hIDComDev != NULL || m_VirtualDevice.IsValid();
+}
+
+TArray<FString> USerial::GetDevicePathsForPort(int32 nPort)
+{
+	TArray<FString> DevicePaths;
+	if (nPort < 10)
+		DevicePaths.Add(FString::Printf(TEXT("COM%d"), nPort));
+	else
+		DevicePaths.Add(FString::Printf(TEXT("\\\\.\\COM%d"), nPort));
+	return DevicePaths;
+}
+
+bool USerial::OpenDeviceHandle(const FString& DevicePath, int32 nBaud, FSerialDeviceHandle& OutHandle)
+{
+	DCB dcb;
+
+	//COM10 and up only open through the device namespace, and the enumerated names don't carry it.
+	const FString OpenName = DevicePath.StartsWith(TEXT("COM")) ? TEXT("\\\\.\\") + DevicePath : DevicePath;
+	HANDLE hComDev = CreateFile(*OpenName, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, NULL);
+	if (hComDev == NULL || hComDev == INVALID_HANDLE_VALUE)
+	{
+		unsigned long dwError = GetLastError();
+		UE_LOG(LogTemp, Error, TEXT("Failed to open port %s. Error: %08X"), *DevicePath, dwError);
+		return false;
+	}
+
+	COMMTIMEOUTS CommTimeOuts;
+	//CommTimeOuts.ReadIntervalTimeout = 10;
+	CommTimeOuts.ReadIntervalTimeout = 0xFFFFFFFF;
+	CommTimeOuts.ReadTotalTimeoutMultiplier = 0;
+	CommTimeOuts.ReadTotalTimeoutConstant = 0;
+	CommTimeOuts.WriteTotalTimeoutMultiplier = 0;
+	CommTimeOuts.WriteTotalTimeoutConstant = 10;
+	SetCommTimeouts(hComDev, &CommTimeOuts);
+
+	dcb.DCBlength = sizeof(DCB);
+	GetCommState(hComDev, &dcb);
+	dcb.BaudRate = nBaud;
+	dcb.ByteSize = 8;
+
+	if (!SetCommState(hComDev, &dcb) ||
+		!SetupComm(hComDev, 10000, 10000))
+	{
+		unsigned long dwError = GetLastError();
+		CloseHandle(hComDev);
+		UE_LOG(LogTemp, Error, TEXT("Failed to setup port %s. Error: %08X"), *DevicePath, dwError);
+		return false;
+	}
+
+	OutHandle = hComDev;
+	return true;
+}
+
+void USerial::CloseDeviceHandle(FSerialDeviceHandle Handle)
+{
+	CloseHandle(Handle);
+}
+
+bool USerial::AdoptDeviceHandle(FSerialDeviceHandle Handle)
+{
+	FMemory::Memset(&m_OverlappedRead, 0, sizeof(OVERLAPPED));
+	FMemory::Memset(&m_OverlappedWrite, 0, sizeof(OVERLAPPED));
+	m_OverlappedRead.hEvent = CreateEvent(NULL, true, false, NULL);
+	m_OverlappedWrite.hEvent = CreateEvent(NULL, true, false, NULL);
+
+	if (m_OverlappedRead.hEvent == NULL || m_OverlappedWrite.hEvent == NULL)
+	{
+		unsigned long dwError = GetLastError();
+		if (m_OverlappedRead.hEvent != NULL) CloseHandle(m_OverlappedRead.hEvent);
+		if (m_OverlappedWrite.hEvent != NULL) CloseHandle(m_OverlappedWrite.hEvent);
+		m_OverlappedRead.hEvent = NULL;
+		m_OverlappedWrite.hEvent = NULL;
+		CloseHandle(Handle);
+		UE_LOG(LogTemp, Error, TEXT("Failed to setup port events. Error: %08X"), dwError);
+		return false;
+	}
+
+	m_hIDComDev = Handle;
+	return true;
+}
+
+void USerial::CloseDevice()
+{
+	if (m_VirtualDevice.IsValid())
+	{
+		m_VirtualDevice.Reset();
+		return;
+	}
+
+	if (m_OverlappedRead.hEvent != NULL) CloseHandle(m_OverlappedRead.hEvent);
+	if (m_OverlappedWrite.hEvent != NULL) CloseHandle(m_OverlappedWrite.hEvent);
+	m_OverlappedRead.hEvent = NULL;
+	m_OverlappedWrite.hEvent = NULL;
+	CloseHandle(m_hIDComDev);
+	m_hIDComDev = NULL;
+}
+
+int32 USerial::ReadAvailableBytes(uint8* Buffer, int32 BufferSize)
+{
+	if (m_VirtualDevice.IsValid()) return BufferSize > 0 ? m_VirtualDevice->Read(Buffer, BufferSize) : 0;
+	if (!m_hIDComDev || BufferSize <= 0) return 0;
+
+	unsigned long dwBytesRead = 0, dwErrorFlags;
+	COMSTAT ComStat;
+
+	if (!ClearCommError(m_hIDComDev, &dwErrorFlags, &ComStat))
+	{
+		//This is what a removed USB adapter or a dropped Bluetooth link looks like.
+		m_bDeviceError = true;
+		return 0;
+	}
+	if (!ComStat.cbInQue) return 0;
+
+	const unsigned long dwBytesToRead = FMath::Min((unsigned long)BufferSize, (unsigned long)ComStat.cbInQue);
+	if (!ReadFile(m_hIDComDev, Buffer, dwBytesToRead, &dwBytesRead, &m_OverlappedRead))
+	{
+		if (GetLastError() != ERROR_IO_PENDING)
+		{
+			m_bDeviceError = true;
+			return 0;
+		}
+
+		//The bytes are already in the driver queue, so this completes right away.
+		if (!GetOverlappedResult(m_hIDComDev, &m_OverlappedRead, &dwBytesRead, true))
+		{
+			m_bDeviceError = true;
+			return 0;
+		}
+	}
+
+	return (int32)dwBytesRead;
+}
+
+int32 USerial::WriteRawBytes(const uint8* Data, int32 NumBytes)
+{
+	if (m_VirtualDevice.IsValid()) return NumBytes > 0 ? m_VirtualDevice->Write(Data, NumBytes) : 0;
+	if (!m_hIDComDev || NumBytes <= 0) return 0;
+
+	unsigned long dwBytesWritten = 0;
+	if (!WriteFile(m_hIDComDev, Data, NumBytes, &dwBytesWritten, &m_OverlappedWrite))
+	{
+		if (GetLastError() != ERROR_IO_PENDING || !GetOverlappedResult(m_hIDComDev, &m_OverlappedWrite, &dwBytesWritten, true))
+		{
+			m_bDeviceError = true;
+			return -1;
+		}
+	}
+
+	return (int32)dwBytesWritten;
+}
+
+int32 USerial::GetDriverWriteQueueSize()
+{
+	if (m_VirtualDevice.IsValid()) return m_VirtualDevice->GetWriteQueueSize();
+	if (!m_hIDComDev) return 0;
+
+	unsigned long dwErrorFlags;
+	COMSTAT ComStat;
+	if (!ClearCommError(m_hIDComDev, &dwErrorFlags, &ComStat)) return 0;
+
+	return (int32)ComStat.cbOutQue;
+}
+
+bool USerial::CheckDeviceHealth()
+{
+	if (m_VirtualDevice.IsValid())
+	{
+		if (!m_VirtualDevice->IsConnected()) m_bDeviceError = true;
+		return !m_bDeviceError;
+	}
+	if (!m_hIDComDev) return false;
+
+	unsigned long dwErrorFlags;
+	COMSTAT ComStat;
+	if (!ClearCommError(m_hIDComDev, &dwErrorFlags, &ComStat))
+	{
+		m_bDeviceError = true;
+	}
+
+	return !m_bDeviceError;
+}
+
+TArray<FString> USerial::EnumerateDevicePaths()
+{
+	//Every present serial port, Bluetooth SPP ports included, is listed here by its COM name.
+	TArray<FString> DevicePaths;
+
+	HKEY hKey;
+	if (RegOpenKeyEx(HKEY_LOCAL_MACHINE, TEXT("HARDWARE\\DEVICEMAP\\SERIALCOMM"), 0, KEY_READ, &hKey) != ERROR_SUCCESS)
+	{
+		return DevicePaths;
+	}
+
+	for (unsigned long dwIndex = 0; ; dwIndex++)
+	{
+		TCHAR ValueName[256];
+		TCHAR PortName[256];
+		unsigned long dwValueNameLength = ARRAY_COUNT(ValueName);
+		unsigned long dwPortNameSize = sizeof(PortName);
+		unsigned long dwType;
+		if (RegEnumValue(hKey, dwIndex, ValueName, &dwValueNameLength, NULL, &dwType, (LPBYTE)PortName, &dwPortNameSize) != ERROR_SUCCESS)
+		{
+			break;
+		}
+		if (dwType != REG_SZ) continue;
+
+		PortName[FMath::Min<unsigned long>(dwPortNameSize / sizeof(TCHAR), ARRAY_COUNT(PortName) - 1)] = 0;
+		DevicePaths.Add(PortName);
+	}
+
+	RegCloseKey(hKey);
+	DevicePaths.Sort();
+	return DevicePaths;
+}
+
+bool USerial::WaitUntilReadable(int32 TimeoutMs)
+{
+	//Overlapped comm ports have no cheap readiness wait that doesn't interfere with the reads, so let the caller sleep instead.
+	return false;
+}
+
+#endif //PLATFORM_WINDOWS
@@ -0,0 +1,307 @@
+//Automation tests for the termios backend. A pseudo terminal stands in for the device: USerial opens the slave end like any tty and the test plays the device on the master end.
+
+#include "Serial.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && (PLATFORM_LINUX || PLATFORM_MAC)
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#if PLATFORM_MAC
+#include <util.h>
+#else
+#include <pty.h>
+#endif
+
+#define SERIAL_TEST_TIMEOUT_SECS 2.0
+
+class FSerialPtyLoopback
+{
+public:
+	FSerialPtyLoopback()
+		: MasterFd(-1)
+		, SlaveFd(-1)
+		, Serial(nullptr)
+	{
+		if (openpty(&MasterFd, &SlaveFd, nullptr, nullptr, nullptr) != 0)
+		{
+			return;
+		}
+		fcntl(MasterFd, F_SETFL, fcntl(MasterFd, F_GETFL) | O_NONBLOCK);
+
+		//The slave fd is kept open until the end, so the pty doesn't hang up between openpty and OpenPath.
+		const char* SlavePath = ttyname(SlaveFd);
+		if (SlavePath == nullptr)
+		{
+			return;
+		}
+
+		Serial = NewObject<USerial>();
+		if (!Serial->OpenPath(UTF8_TO_TCHAR(SlavePath), 115200))
+		{
+			Serial = nullptr;
+		}
+	}
+
+	~FSerialPtyLoopback()
+	{
+		if (Serial != nullptr)
+		{
+			Serial->Close();
+		}
+		CloseMaster();
+		if (SlaveFd >= 0)
+		{
+			close(SlaveFd);
+		}
+	}
+
+	bool IsValid() const { return Serial != nullptr; }
+	USerial* GetSerial() const { return Serial; }
+
+	/** Plays the device hanging up, like an unplugged cable. */
+	void CloseMaster()
+	{
+		if (MasterFd >= 0)
+		{
+			close(MasterFd);
+			MasterFd = -1;
+		}
+	}
+
+	bool WriteToSerial(const TArray<uint8>& Data)
+	{
+		int32 NumWritten = 0;
+		const double TimeoutSecs = FPlatformTime::Seconds() + SERIAL_TEST_TIMEOUT_SECS;
+		while (NumWritten < Data.Num() && FPlatformTime::Seconds() < TimeoutSecs)
+		{
+			const ssize_t NumWrittenNow = write(MasterFd, Data.GetData() + NumWritten, Data.Num() - NumWritten);
+			if (NumWrittenNow > 0)
+			{
+				NumWritten += (int32)NumWrittenNow;
+			}
+			else if (NumWrittenNow < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+			{
+				return false;
+			}
+		}
+		return NumWritten == Data.Num();
+	}
+
+	/** Appends what the serial port sent until OutData holds NumBytes, or the timeout runs out. */
+	bool ReadFromSerial(TArray<uint8>& OutData, int32 NumBytes)
+	{
+		const double TimeoutSecs = FPlatformTime::Seconds() + SERIAL_TEST_TIMEOUT_SECS;
+		while (OutData.Num() < NumBytes && FPlatformTime::Seconds() < TimeoutSecs)
+		{
+			pollfd PollFd;
+			PollFd.fd = MasterFd;
+			PollFd.events = POLLIN;
+			PollFd.revents = 0;
+			if (poll(&PollFd, 1, 10) <= 0)
+			{
+				continue;
+			}
+
+			uint8 Buffer[1024];
+			const ssize_t NumRead = read(MasterFd, Buffer, FMath::Min((int32)sizeof(Buffer), NumBytes - OutData.Num()));
+			if (NumRead > 0)
+			{
+				OutData.Append(Buffer, (int32)NumRead);
+			}
+		}
+		return OutData.Num() == NumBytes;
+	}
+
+	/** Appends what USerial reads until OutData holds NumBytes, or the timeout runs out. */
+	bool ReadFromDevice(TArray<uint8>& OutData, int32 NumBytes)
+	{
+		const double TimeoutSecs = FPlatformTime::Seconds() + SERIAL_TEST_TIMEOUT_SECS;
+		while (OutData.Num() < NumBytes && FPlatformTime::Seconds() < TimeoutSecs)
+		{
+			const TArray<uint8> Data = Serial->ReadBytes(NumBytes - OutData.Num());
+			if (Data.Num() == 0)
+			{
+				FPlatformProcess::Sleep(0.001f);
+				continue;
+			}
+			OutData.Append(Data);
+		}
+		return OutData.Num() == NumBytes;
+	}
+
+private:
+	int MasterFd;
+	int SlaveFd;
+	USerial* Serial;
+};
+
+static TArray<uint8> MakeSerialTestPattern(int32 NumBytes)
+{
+	TArray<uint8> Pattern;
+	Pattern.SetNumUninitialized(NumBytes);
+	for (int32 ByteIdx = 0; ByteIdx < NumBytes; ByteIdx++)
+	{
+		Pattern[ByteIdx] = (uint8)(ByteIdx * 7 + ByteIdx / 256);
+	}
+	return Pattern;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSerialPosixRoundTripTest, "UE4Duino.Serial.Posix.RoundTrip", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FSerialPosixRoundTripTest::RunTest(const FString& Parameters)
+{
+	FSerialPtyLoopback Loopback;
+	if (!TestTrue(TEXT("Opened a pty slave with OpenPath"), Loopback.IsValid()))
+	{
+		return false;
+	}
+
+	//Every byte value, so nothing in the termios setup is allowed to translate or swallow control characters.
+	TArray<uint8> AllBytes;
+	for (int32 Value = 0; Value < 256; Value++)
+	{
+		AllBytes.Add((uint8)Value);
+	}
+
+	TestTrue(TEXT("Device wrote all bytes"), Loopback.WriteToSerial(AllBytes));
+	TArray<uint8> Received;
+	TestTrue(TEXT("USerial read all bytes"), Loopback.ReadFromDevice(Received, AllBytes.Num()));
+	TestTrue(TEXT("USerial read the bytes unchanged"), Received == AllBytes);
+
+	TestTrue(TEXT("USerial wrote all bytes"), Loopback.GetSerial()->WriteBytes(AllBytes));
+	Received.Reset();
+	TestTrue(TEXT("Device read all bytes"), Loopback.ReadFromSerial(Received, AllBytes.Num()));
+	TestTrue(TEXT("Device read the bytes unchanged"), Received == AllBytes);
+
+	TestFalse(TEXT("No device error"), Loopback.GetSerial()->HasDeviceError());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSerialPosixThroughputTest, "UE4Duino.Serial.Posix.Throughput", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FSerialPosixThroughputTest::RunTest(const FString& Parameters)
+{
+	FSerialPtyLoopback Loopback;
+	if (!TestTrue(TEXT("Opened a pty slave with OpenPath"), Loopback.IsValid()))
+	{
+		return false;
+	}
+
+	//Chunks well below the pty buffer, drained as they go, so the write path is measured and not the test's reader.
+	const int32 NumBytes = 256 * 1024;
+	const int32 ChunkSize = 512;
+	const TArray<uint8> Pattern = MakeSerialTestPattern(NumBytes);
+	TArray<uint8> Received;
+	Received.Reserve(NumBytes);
+
+	const double StartSecs = FPlatformTime::Seconds();
+	for (int32 Offset = 0; Offset < NumBytes; Offset += ChunkSize)
+	{
+		const TArray<uint8> Chunk(Pattern.GetData() + Offset, FMath::Min(ChunkSize, NumBytes - Offset));
+		if (!TestTrue(TEXT("USerial wrote the chunk"), Loopback.GetSerial()->WriteBytes(Chunk))
+			|| !TestTrue(TEXT("Device read the chunk"), Loopback.ReadFromSerial(Received, Offset + Chunk.Num())))
+		{
+			return false;
+		}
+	}
+	const double ElapsedSecs = FMath::Max(FPlatformTime::Seconds() - StartSecs, 1e-6);
+
+	TestTrue(TEXT("Device read the bytes unchanged"), Received == Pattern);
+	AddInfo(FString::Printf(TEXT("Throughput: %.1f MB/s"), NumBytes / ElapsedSecs / (1024.0 * 1024.0)));
+
+	//Single byte ping pongs. A pty has no baud rate, so this is the cost of the read and write path itself.
+	const int32 NumPings = 200;
+	double MaxRoundTripSecs = 0.0;
+	double TotalRoundTripSecs = 0.0;
+	for (int32 PingIdx = 0; PingIdx < NumPings; PingIdx++)
+	{
+		const double PingStartSecs = FPlatformTime::Seconds();
+		TArray<uint8> Ping = { (uint8)PingIdx };
+		TArray<uint8> Echo;
+		if (!TestTrue(TEXT("Device sent the ping"), Loopback.WriteToSerial(Ping))
+			|| !TestTrue(TEXT("USerial read the ping"), Loopback.ReadFromDevice(Echo, 1))
+			|| !TestTrue(TEXT("USerial echoed the ping"), Loopback.GetSerial()->WriteBytes(Echo)))
+		{
+			return false;
+		}
+
+		TArray<uint8> Pong;
+		if (!TestTrue(TEXT("Device read the echo"), Loopback.ReadFromSerial(Pong, 1)))
+		{
+			return false;
+		}
+		TestEqual(TEXT("Echo matches the ping"), (int32)Pong[0], (int32)Ping[0]);
+
+		const double RoundTripSecs = FPlatformTime::Seconds() - PingStartSecs;
+		MaxRoundTripSecs = FMath::Max(MaxRoundTripSecs, RoundTripSecs);
+		TotalRoundTripSecs += RoundTripSecs;
+	}
+
+	AddInfo(FString::Printf(TEXT("Round trip: %.3f ms average, %.3f ms worst"), TotalRoundTripSecs * 1000.0 / NumPings, MaxRoundTripSecs * 1000.0));
+	TestTrue(TEXT("Average round trip is below 10 ms"), TotalRoundTripSecs / NumPings < 0.010);
+	TestFalse(TEXT("No device error"), Loopback.GetSerial()->HasDeviceError());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSerialPosixHangupTest, "UE4Duino.Serial.Posix.Hangup", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FSerialPosixHangupTest::RunTest(const FString& Parameters)
+{
+	FSerialPtyLoopback Loopback;
+	if (!TestTrue(TEXT("Opened a pty slave with OpenPath"), Loopback.IsValid()))
+	{
+		return false;
+	}
+
+	//Bytes sent before the hangup are still delivered.
+	const TArray<uint8> Pattern = MakeSerialTestPattern(64);
+	TestTrue(TEXT("Device wrote all bytes"), Loopback.WriteToSerial(Pattern));
+	TArray<uint8> Received;
+	TestTrue(TEXT("USerial read all bytes"), Loopback.ReadFromDevice(Received, Pattern.Num()));
+	TestFalse(TEXT("No device error before the hangup"), Loopback.GetSerial()->HasDeviceError());
+
+	Loopback.CloseMaster();
+
+	const double TimeoutSecs = FPlatformTime::Seconds() + SERIAL_TEST_TIMEOUT_SECS;
+	while (!Loopback.GetSerial()->HasDeviceError() && FPlatformTime::Seconds() < TimeoutSecs)
+	{
+		TestEqual(TEXT("Nothing to read after the hangup"), Loopback.GetSerial()->ReadBytes(16).Num(), 0);
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	TestTrue(TEXT("Reading after the hangup flagged a device error"), Loopback.GetSerial()->HasDeviceError());
+	TestFalse(TEXT("The device is reported as gone"), Loopback.GetSerial()->CheckDeviceHealth());
+	TestTrue(TEXT("The port stays open until closed"), Loopback.GetSerial()->IsOpened());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSerialPosixIdleReadTest, "UE4Duino.Serial.Posix.IdleRead", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+bool FSerialPosixIdleReadTest::RunTest(const FString& Parameters)
+{
+	FSerialPtyLoopback Loopback;
+	if (!TestTrue(TEXT("Opened a pty slave with OpenPath"), Loopback.IsValid()))
+	{
+		return false;
+	}
+
+	//With VMIN and VTIME at 0 an idle tty reads 0 bytes. That is no data, not a hangup.
+	for (int32 ReadIdx = 0; ReadIdx < 100; ReadIdx++)
+	{
+		TestEqual(TEXT("Nothing to read on an idle port"), Loopback.GetSerial()->ReadBytes(16).Num(), 0);
+	}
+	TestFalse(TEXT("Idle reads don't flag a device error"), Loopback.GetSerial()->HasDeviceError());
+	TestTrue(TEXT("The device is reported as healthy"), Loopback.GetSerial()->CheckDeviceHealth());
+
+	//The port still works after being idle.
+	const TArray<uint8> Pattern = MakeSerialTestPattern(32);
+	TestTrue(TEXT("Device wrote all bytes"), Loopback.WriteToSerial(Pattern));
+	TArray<uint8> Received;
+	TestTrue(TEXT("USerial read all bytes"), Loopback.ReadFromDevice(Received, Pattern.Num()));
+	TestTrue(TEXT("USerial read the bytes unchanged"), Received == Pattern);
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS && (PLATFORM_LINUX || PLATFORM_MAC)
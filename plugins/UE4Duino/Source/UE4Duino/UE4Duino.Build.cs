@@ -8,6 +8,9 @@ public class UE4Duino : ModuleRules
 
         PrivateIncludePaths.AddRange(new string[] { "UE4Duino/Private" });
 
+        //All headers live in Private, expose them so game modules can drive a USerial from C++.
+        PublicIncludePaths.AddRange(new string[] { "UE4Duino/Private" });
+
         PrivateDependencyModuleNames.AddRange(
             new string[]
 			{
@@ -16,5 +19,13 @@ public class UE4Duino : ModuleRules
                 "CoreUObject"
             }
         );
+
+        //openpty for the automation tests, which stand a pseudo terminal in for the device. Builds without WITH_DEV_AUTOMATION_TESTS, like shipping, don't link it.
+        bool bWithDevAutomationTests = Target.bForceCompileDevelopmentAutomationTests
+            || (Target.Configuration != UnrealTargetConfiguration.Shipping && Target.Configuration != UnrealTargetConfiguration.Test);
+        if (Target.Platform == UnrealTargetPlatform.Linux && bWithDevAutomationTests)
+        {
+            PublicAdditionalLibraries.Add("util");
+        }
     }
 }
\ No newline at end of file